@@ -11,12 +11,41 @@
 void UComplexAbilityModifierFunction::SetupBuffFunction()
 {
 	TargetHandler = ISaiyoraCombatInterface::Execute_GetAbilityComponent(GetOwningBuff()->GetHandler()->GetOwner());
-	Modifier.BindUFunction(GetOwningBuff(), ModifierFunctionName);
+	if (bIgnoresAbilityContext)
+	{
+		StaticModifier = FCombatModifier(StaticModifier.Value, StaticModifier.Type, GetOwningBuff(), StaticModifier.bStackable);
+	}
+	else
+	{
+		Modifier.BindUFunction(GetOwningBuff(), ModifierFunctionName);
+	}
 }
 
 void UComplexAbilityModifierFunction::OnApply(const FBuffApplyEvent& ApplyEvent)
 {
-	if (!IsValid(TargetHandler) || !Modifier.IsBound())
+	if (!IsValid(TargetHandler))
+	{
+		return;
+	}
+	if (bIgnoresAbilityContext)
+	{
+		switch (ModifierType)
+		{
+		case EComplexAbilityModType::CastLength :
+			StaticModifierHandle = TargetHandler->AddStaticCastLengthModifier(StaticModifier);
+			break;
+		case EComplexAbilityModType::CooldownLength :
+			StaticModifierHandle = TargetHandler->AddStaticCooldownModifier(StaticModifier);
+			break;
+		case EComplexAbilityModType::GlobalCooldownLength :
+			StaticModifierHandle = TargetHandler->AddStaticGlobalCooldownModifier(StaticModifier);
+			break;
+		default :
+			break;
+		}
+		return;
+	}
+	if (!Modifier.IsBound())
 	{
 		return;
 	}
@@ -36,9 +65,56 @@ void UComplexAbilityModifierFunction::OnApply(const FBuffApplyEvent& ApplyEvent)
 	}
 }
 
+void UComplexAbilityModifierFunction::OnChange(const FBuffApplyEvent& ApplyEvent)
+{
+	if (!IsValid(TargetHandler) || !bIgnoresAbilityContext)
+	{
+		return;
+	}
+	if (StaticModifier.bStackable && ApplyEvent.PreviousStacks != ApplyEvent.NewStacks)
+	{
+		switch (ModifierType)
+		{
+		case EComplexAbilityModType::CastLength :
+			TargetHandler->UpdateStaticCastLengthModifier(StaticModifierHandle, StaticModifier);
+			break;
+		case EComplexAbilityModType::CooldownLength :
+			TargetHandler->UpdateStaticCooldownModifier(StaticModifierHandle, StaticModifier);
+			break;
+		case EComplexAbilityModType::GlobalCooldownLength :
+			TargetHandler->UpdateStaticGlobalCooldownModifier(StaticModifierHandle, StaticModifier);
+			break;
+		default :
+			break;
+		}
+	}
+}
+
 void UComplexAbilityModifierFunction::OnRemove(const FBuffRemoveEvent& RemoveEvent)
 {
-	if (!IsValid(TargetHandler) || !Modifier.IsBound())
+	if (!IsValid(TargetHandler))
+	{
+		return;
+	}
+	if (bIgnoresAbilityContext)
+	{
+		switch (ModifierType)
+		{
+		case EComplexAbilityModType::CastLength :
+			TargetHandler->RemoveStaticCastLengthModifier(StaticModifierHandle);
+			break;
+		case EComplexAbilityModType::CooldownLength :
+			TargetHandler->RemoveStaticCooldownModifier(StaticModifierHandle);
+			break;
+		case EComplexAbilityModType::GlobalCooldownLength :
+			TargetHandler->RemoveStaticGlobalCooldownModifier(StaticModifierHandle);
+			break;
+		default :
+			break;
+		}
+		return;
+	}
+	if (!Modifier.IsBound())
 	{
 		return;
 	}
@@ -14,8 +14,58 @@
 #include "SaiyoraGameInstance.h"
 #include "SaiyoraGameState.h"
 #include "SaiyoraMovementComponent.h"
+#include "SimulatedAbilityEventSubsystem.h"
 #include "UnrealNetwork.h"
 
+#pragma region Net Serialization
+
+bool FAbilityRequest::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bHasRequest = Ar.IsSaving() ? (PredictionID != 0 || AbilityClass != nullptr) : 0;
+	Ar.SerializeBits(&bHasRequest, 1);
+	if (!bHasRequest)
+	{
+		if (Ar.IsLoading())
+		{
+			Clear();
+			Origin.Clear();
+		}
+		bOutSuccess = true;
+		return true;
+	}
+	Ar << AbilityClass;
+	uint32 PackedPredictionID = static_cast<uint32>(PredictionID);
+	Ar.SerializeIntPacked(PackedPredictionID);
+	uint32 PackedTick = static_cast<uint32>(Tick);
+	Ar.SerializeIntPacked(PackedTick);
+	uint8 bHasStartTime = Ar.IsSaving() ? ClientStartTime != 0.0f : 0;
+	Ar.SerializeBits(&bHasStartTime, 1);
+	if (bHasStartTime)
+	{
+		Ar << ClientStartTime;
+	}
+	if (Ar.IsLoading())
+	{
+		PredictionID = static_cast<int32>(PackedPredictionID);
+		Tick = static_cast<int32>(PackedTick);
+		if (!bHasStartTime)
+		{
+			ClientStartTime = 0.0f;
+		}
+	}
+	bool bOriginSuccess = true;
+	Origin.NetSerialize(Ar, Map, bOriginSuccess);
+	bool bTargetSuccess = true;
+	if (!FAbilityTargetSet::NetSerializeSets(Ar, Map, Targets, bTargetSuccess))
+	{
+		bOutSuccess = false;
+		return false;
+	}
+	bOutSuccess = bOriginSuccess && bTargetSuccess && !Ar.IsError();
+	return true;
+}
+
+#pragma endregion
 #pragma region Setup
 
 UAbilityComponent::UAbilityComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -49,6 +99,7 @@ void UAbilityComponent::InitializeComponent()
 	DamageHandlerRef = ISaiyoraCombatInterface::Execute_GetDamageHandler(GetOwner());
 	MovementComponentRef = ISaiyoraCombatInterface::Execute_GetCustomMovementComponent(GetOwner());
 	CombatStatusComponentRef = ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(GetOwner());
+	SimulatedEventRelay = GetWorld()->GetSubsystem<USimulatedAbilityEventSubsystem>();
 	const USaiyoraGameInstance* GameInstance = Cast<USaiyoraGameInstance>(GetWorld()->GetGameInstance());
 	if (IsValid(GameInstance))
 	{
@@ -213,8 +264,9 @@ FAbilityEvent UAbilityComponent::UseAbility(const TSubclassOf<UCombatAbility> Ab
 		}
 		return Result;
 	}
-	if (!Result.Ability->IsCastable(Result.FailReasons))
+	if (Result.Ability->GetCastFailMask() != 0)
 	{
+		Result.Ability->IsCastable(Result.FailReasons);
 		if (bLogAbilityEvent)
 		{
 			CombatDebugOptions->LogAbilityEvent(GetOwner(), Result);
@@ -240,7 +292,7 @@ FAbilityEvent UAbilityComponent::UseAbility(const TSubclassOf<UCombatAbility> Ab
 				Result.ActionTaken = ECastAction::Success;
 				Result.Ability->PredictedTick(0, Result.Origin, Result.Targets);
 				Result.Ability->ServerTick(0, Result.Origin, Result.Targets);
-				MulticastAbilityTick(Result);
+				ReplicateAbilityTick(Result);
 			}
 			break;
 		case EAbilityCastType::Channel :
@@ -260,14 +312,14 @@ FAbilityEvent UAbilityComponent::UseAbility(const TSubclassOf<UCombatAbility> Ab
 				if (Result.Ability->HasInitialTick())
 				{
 					Result.Ability->ServerTick(0, Result.Origin, Result.Targets);
-					MulticastAbilityTick(Result);
+					ReplicateAbilityTick(Result);
 				}
 				//If the ability is instant or has an initial tick, ServerCastStart and SimulatedCastStart will fire from those events.
 				//If the ability is channeled and has no initial tick, we need to manually call ServerCastStart and RPC to trigger SimulatedCastStart.
 				else
 				{
 					Result.Ability->ServerNoTickCastStart();
-					MulticastNoTickCastStart(Result.Ability);
+					ReplicateNoTickCastStart(Result.Ability);
 				}
 			}
 			break;
@@ -327,7 +379,8 @@ FAbilityEvent UAbilityComponent::UseAbility(const TSubclassOf<UCombatAbility> Ab
 		Prediction.bPredictedGCD = Result.Ability->HasGlobalCooldown();
 		Prediction.GcdLength = CalculateGlobalCooldownLength(Result.Ability);
 		Prediction.Time = GameStateRef->GetServerWorldTimeSeconds();
-		UnackedAbilityPredictions.Add(Result.PredictionID, Prediction);
+		Prediction.PredictionID = Result.PredictionID;
+		AddUnackedPrediction(Prediction);
 		ServerPredictAbility(Request);
 	}
 	if (bLogAbilityEvent)
@@ -351,7 +404,7 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
 		if (Request.PredictionID <= LastPredictionID)
 		{
 			ServerResult.FailReasons.AddUnique(ECastFailReason::NetRole);
-			PredictedTickRecord.Add(FPredictedTick(Request.PredictionID, 0), false);
+			PredictedTickRecord.Record(FPredictedTick(Request.PredictionID, 0), false);
 			ClientPredictionResult(ServerResult);
 			return;
 		}
@@ -359,7 +412,7 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
 		if (!IsValid(Request.AbilityClass))
 		{
 			ServerResult.FailReasons.AddUnique(ECastFailReason::InvalidAbility);
-			PredictedTickRecord.Add(FPredictedTick(Request.PredictionID, 0), false);
+			PredictedTickRecord.Record(FPredictedTick(Request.PredictionID, 0), false);
 			ClientPredictionResult(ServerResult);
 			return;
 		}
@@ -369,9 +422,9 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
 		{
 			ServerResult.FailReasons.AddUnique(ECastFailReason::InvalidAbility);
 		}
-		if (!bValidAbility || !Ability->IsCastable(ServerResult.FailReasons))
+		if (!bValidAbility || (Ability->GetCastFailMask() != 0 && !Ability->IsCastable(ServerResult.FailReasons)))
 		{
-			PredictedTickRecord.Add(FPredictedTick(Request.PredictionID, 0), false);
+			PredictedTickRecord.Record(FPredictedTick(Request.PredictionID, 0), false);
 			ClientPredictionResult(ServerResult);
 			return;
 		}
@@ -409,7 +462,7 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
 	        {
         		Result.ActionTaken = ECastAction::Success;
         		Ability->ServerTick(0, Result.Origin, Result.Targets, Result.PredictionID);
-        		MulticastAbilityTick(Result);
+        		ReplicateAbilityTick(Result);
 	        }
         	break;
         case EAbilityCastType::Channel :
@@ -421,14 +474,14 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
         		if (Ability->HasInitialTick())
         		{
         			Ability->ServerTick(0, Result.Origin, Result.Targets, Result.PredictionID);
-        			MulticastAbilityTick(Result);
+        			ReplicateAbilityTick(Result);
         		}
         		//If the ability is instant or has an initial tick, ServerCastStart and SimulatedCastStart will fire from those events.
         		//If the ability is channeled and has no initial tick, we need to manually call ServerCastStart and RPC to trigger SimulatedCastStart.
 		        else
 		        {
 		        	Ability->ServerNoTickCastStart(Result.PredictionID);
-			        MulticastNoTickCastStart(Result.Ability);
+			        ReplicateNoTickCastStart(Result.Ability);
 		        }
 	        }
         	break;
@@ -437,7 +490,7 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
         	return;
         }
 
-		PredictedTickRecord.Add(FPredictedTick(Request.PredictionID, 0), true);
+		PredictedTickRecord.Record(FPredictedTick(Request.PredictionID, 0), true);
         ClientPredictionResult(ServerResult);
 	}
 	else
@@ -457,9 +510,9 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
 			{
 				TicksAwaitingParams[i].Targets = Request.Targets;
 				TicksAwaitingParams[i].Ability->ServerTick(TicksAwaitingParams[i].Tick, TicksAwaitingParams[i].Origin, TicksAwaitingParams[i].Targets, TicksAwaitingParams[i].PredictionID);
-				MulticastAbilityTick(TicksAwaitingParams[i]);
+				ReplicateAbilityTick(TicksAwaitingParams[i]);
 				OnAbilityTick.Broadcast(TicksAwaitingParams[i]);
-				PredictedTickRecord.Add(FPredictedTick(TicksAwaitingParams[i].PredictionID, TicksAwaitingParams[i].Tick), true);
+				PredictedTickRecord.Record(FPredictedTick(TicksAwaitingParams[i].PredictionID, TicksAwaitingParams[i].Tick), true);
 				TicksAwaitingParams.RemoveAt(i);
 				return;
 			}
@@ -469,44 +522,52 @@ void UAbilityComponent::ServerPredictAbility_Implementation(const FAbilityReques
 
 void UAbilityComponent::ClientPredictionResult_Implementation(const FServerAbilityResult& Result)
 {
-	const FClientAbilityPrediction* OriginalPrediction = UnackedAbilityPredictions.Find(Result.PredictionID);
-	if (OriginalPrediction == nullptr)
+	const FClientAbilityPrediction* FoundPrediction = UnackedAbilityPredictions.FindByPredicate([&Result](const FClientAbilityPrediction& Prediction)
+	{
+		return Prediction.PredictionID == Result.PredictionID;
+	});
+	if (FoundPrediction == nullptr)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Client did not have an ability prediction stored that matches server result with prediction ID %i."), Result.PredictionID);
 		return;
 	}
+	//Copy the prediction out, clearing old predictions shifts the array.
+	const FClientAbilityPrediction OriginalPrediction = *FoundPrediction;
 	ClearOldPredictions(Result.PredictionID);
 	if (IsValid(ResourceHandlerRef))
 	{
 		ResourceHandlerRef->UpdatePredictedCostsFromServer(Result);
 	}
-	if (IsValid(OriginalPrediction->Ability))
+	if (IsValid(OriginalPrediction.Ability))
 	{
-		OriginalPrediction->Ability->UpdatePredictionFromServer(Result);
+		OriginalPrediction.Ability->UpdatePredictionFromServer(Result);
 	}
-	UpdateCastFromServerResult(OriginalPrediction->Time, Result);
-	UpdateGlobalCooldownFromServerResult(OriginalPrediction->Time, Result);
+	UpdateCastFromServerResult(OriginalPrediction.Time, Result);
+	UpdateGlobalCooldownFromServerResult(OriginalPrediction.Time, Result);
 	if (!Result.bSuccess)
 	{
 		OnAbilityMispredicted.Broadcast(Result.PredictionID);
 	}
 }
 
-void UAbilityComponent::ClearOldPredictions(const int32 AckedPredictionID)
+void UAbilityComponent::AddUnackedPrediction(const FClientAbilityPrediction& Prediction)
 {
-	//TODO: Figure out how to either reverse iterate over a map or use an iterator to allow removal during iteration.
-	TArray<int32> OldIDs;
-	for (const TTuple<int32, FClientAbilityPrediction>& Prediction : UnackedAbilityPredictions)
+	UnackedAbilityPredictions.Add(Prediction);
+	if (UnackedAbilityPredictions.Num() > MaxUnackedPredictions)
 	{
-		if (Prediction.Key <= AckedPredictionID)
-		{
-			OldIDs.Add(Prediction.Key);
-		}
+		UnackedAbilityPredictions.RemoveAt(0, UnackedAbilityPredictions.Num() - MaxUnackedPredictions);
 	}
-	for (const int32 ID : OldIDs)
+}
+
+void UAbilityComponent::ClearOldPredictions(const int32 AckedPredictionID)
+{
+	//Predictions are stored in ID order, so everything up to and including the acked ID is at the front.
+	int32 NumToRemove = 0;
+	while (NumToRemove < UnackedAbilityPredictions.Num() && UnackedAbilityPredictions[NumToRemove].PredictionID <= AckedPredictionID)
 	{
-		UnackedAbilityPredictions.Remove(ID);
+		NumToRemove++;
 	}
+	UnackedAbilityPredictions.RemoveAt(0, NumToRemove);
 }
 
 void UAbilityComponent::TickCurrentCast()
@@ -525,7 +586,7 @@ void UAbilityComponent::TickCurrentCast()
 	{
 		CastingState.CurrentCast->PredictedTick(CastingState.ElapsedTicks, TickEvent.Origin, TickEvent.Targets);
 		CastingState.CurrentCast->ServerTick(CastingState.ElapsedTicks, TickEvent.Origin, TickEvent.Targets);
-		MulticastAbilityTick(TickEvent);
+		ReplicateAbilityTick(TickEvent);
 	}
 	else if (GetOwnerRole() == ROLE_Authority)
 	{
@@ -537,9 +598,9 @@ void UAbilityComponent::TickCurrentCast()
 			TickEvent.Origin = Params->Origin;
 			TickEvent.Targets = Params->Targets;
 			CastingState.CurrentCast->ServerTick(CastingState.ElapsedTicks, TickEvent.Origin, TickEvent.Targets, CastingState.PredictionID);
-			PredictedTickRecord.Add(CurrentTick, true);
+			PredictedTickRecord.Record(CurrentTick, true);
 			ParamsAwaitingTicks.Remove(CurrentTick);
-			MulticastAbilityTick(TickEvent);
+			ReplicateAbilityTick(TickEvent);
 		}
 		else
 		{
@@ -593,6 +654,11 @@ void UAbilityComponent::RemoveExpiredTicks()
 }
 
 void UAbilityComponent::MulticastAbilityTick_Implementation(const FAbilityEvent& Event)
+{
+	HandleSimulatedAbilityTick(Event);
+}
+
+void UAbilityComponent::HandleSimulatedAbilityTick(const FAbilityEvent& Event)
 {
 	if (IsValid(Event.Ability))
 	{
@@ -606,6 +672,11 @@ void UAbilityComponent::MulticastAbilityTick_Implementation(const FAbilityEvent&
 }
 
 void UAbilityComponent::MulticastNoTickCastStart_Implementation(UCombatAbility* Ability)
+{
+	HandleSimulatedNoTickCastStart(Ability);
+}
+
+void UAbilityComponent::HandleSimulatedNoTickCastStart(UCombatAbility* Ability)
 {
 	if (IsValid(Ability))
 	{
@@ -613,6 +684,33 @@ void UAbilityComponent::MulticastNoTickCastStart_Implementation(UCombatAbility*
 	}
 }
 
+void UAbilityComponent::MulticastProjectileVolley_Implementation(const FProjectileVolley& Volley)
+{
+	//The server is simulating the real projectiles, and the auto proxy already predicted its own copies.
+	if (GetOwnerRole() != ROLE_SimulatedProxy)
+	{
+		return;
+	}
+	UProjectileSimulationSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (IsValid(ProjectileSubsystem))
+	{
+		ProjectileSubsystem->SimulateReplicatedVolley(GetOwner(), Volley);
+	}
+}
+
+void UAbilityComponent::MulticastVolleyProjectileHit_Implementation(const FPredictedTick& SourceTick, const int32 ID)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		return;
+	}
+	UProjectileSimulationSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (IsValid(ProjectileSubsystem))
+	{
+		ProjectileSubsystem->DestroyProjectile(GetOwner(), SourceTick, ID);
+	}
+}
+
 int32 UAbilityComponent::GenerateNewPredictionID()
 {
 	const int32 Previous = LastPredictionID;
@@ -635,21 +733,99 @@ bool UAbilityComponent::UseAbilityFromPredictedMovement(const FAbilityRequest& R
 		return false;
 	}
 	//Check to see if the ability handler has processed this cast already.
-	const bool* PreviousResult = PredictedTickRecord.Find(FPredictedTick(Request.PredictionID, Request.Tick));
-	if (PreviousResult)
+	bool bPreviousResult = false;
+	if (PredictedTickRecord.Find(FPredictedTick(Request.PredictionID, Request.Tick), bPreviousResult))
 	{
-		return *PreviousResult;
+		return bPreviousResult;
 	}
 	//Process the cast as normal.
 	ServerPredictAbility_Implementation(Request);
 	//Recheck for the newly created cast record.
-	PreviousResult = PredictedTickRecord.Find(FPredictedTick(Request.PredictionID, Request.Tick));
-	if (!PreviousResult)
+	//If the tick still didn't happen, the server tick timer hasn't passed yet, and this returns false.
+	PredictedTickRecord.Find(FPredictedTick(Request.PredictionID, Request.Tick), bPreviousResult);
+	return bPreviousResult;
+}
+
+#pragma endregion
+#pragma region Simulated Events
+
+void UAbilityComponent::ReplicateNoTickCastStart(UCombatAbility* Ability)
+{
+	if (IsValid(SimulatedEventRelay) && SimulatedEventRelay->IsRelayEnabled())
 	{
-		//Tick still didn't happen, server tick timer hasn't passed yet.
-		return false;
+		//The multicast would have run on the server too, so run it here before handing it to the relay.
+		HandleSimulatedNoTickCastStart(Ability);
+		SimulatedEventRelay->QueueNoTickCastStart(this, Ability);
+		return;
+	}
+	MulticastNoTickCastStart(Ability);
+}
+
+void UAbilityComponent::ReplicateAbilityTick(const FAbilityEvent& Event)
+{
+	if (IsValid(SimulatedEventRelay) && SimulatedEventRelay->IsRelayEnabled())
+	{
+		HandleSimulatedAbilityTick(Event);
+		SimulatedEventRelay->QueueAbilityTick(this, Event);
+		return;
+	}
+	MulticastAbilityTick(Event);
+}
+
+void UAbilityComponent::ReplicateAbilityCancel(const FCancelEvent& Event)
+{
+	if (IsValid(SimulatedEventRelay) && SimulatedEventRelay->IsRelayEnabled())
+	{
+		HandleSimulatedAbilityCancel(Event);
+		SimulatedEventRelay->QueueAbilityCancel(this, Event);
+		return;
+	}
+	MulticastAbilityCancel(Event);
+}
+
+void UAbilityComponent::ReplicateAbilityInterrupt(const FInterruptEvent& InterruptEvent)
+{
+	if (IsValid(SimulatedEventRelay) && SimulatedEventRelay->IsRelayEnabled())
+	{
+		HandleSimulatedAbilityInterrupt(InterruptEvent);
+		SimulatedEventRelay->QueueAbilityInterrupt(this, InterruptEvent);
+		return;
+	}
+	MulticastAbilityInterrupt(InterruptEvent);
+}
+
+void UAbilityComponent::HandleSimulatedAbilityEvents(const FSimulatedAbilityEvents& Events)
+{
+	//Events can come from any actor relevant to this client, so each one is handed to the component that owns its ability.
+	//Cast starts go first and interrupts last, so events from the same frame still play out in a sensible order.
+	for (UCombatAbility* Ability : Events.NoTickCastStarts)
+	{
+		if (IsValid(Ability) && IsValid(Ability->GetHandler()))
+		{
+			Ability->GetHandler()->HandleSimulatedNoTickCastStart(Ability);
+		}
+	}
+	for (const FAbilityEvent& Event : Events.Ticks)
+	{
+		if (IsValid(Event.Ability) && IsValid(Event.Ability->GetHandler()))
+		{
+			Event.Ability->GetHandler()->HandleSimulatedAbilityTick(Event);
+		}
+	}
+	for (const FCancelEvent& Event : Events.Cancels)
+	{
+		if (IsValid(Event.CancelledAbility) && IsValid(Event.CancelledAbility->GetHandler()))
+		{
+			Event.CancelledAbility->GetHandler()->HandleSimulatedAbilityCancel(Event);
+		}
+	}
+	for (const FInterruptEvent& Event : Events.Interrupts)
+	{
+		if (IsValid(Event.InterruptedAbility) && IsValid(Event.InterruptedAbility->GetHandler()))
+		{
+			Event.InterruptedAbility->GetHandler()->HandleSimulatedAbilityInterrupt(Event);
+		}
 	}
-	return *PreviousResult;
 }
 
 #pragma endregion
@@ -681,7 +857,7 @@ FCancelEvent UAbilityComponent::CancelCurrentCast()
 	if (GetOwnerRole() == ROLE_Authority)
 	{
 		CastingState.CurrentCast->ServerCancel(Result.Origin, Result.Targets, Result.PredictionID);
-		MulticastAbilityCancel(Result);
+		ReplicateAbilityCancel(Result);
 	}
 	else
 	{
@@ -719,11 +895,16 @@ void UAbilityComponent::ServerCancelAbility_Implementation(const FCancelRequest&
 	Result.ElapsedTicks = CastingState.ElapsedTicks;
 	Result.Targets = Request.Targets;
 	CastingState.CurrentCast->ServerCancel(Result.Origin, Result.Targets, Result.PredictionID);
-	MulticastAbilityCancel(Result);
+	ReplicateAbilityCancel(Result);
 	EndCast();
 }
 
 void UAbilityComponent::MulticastAbilityCancel_Implementation(const FCancelEvent& Event)
+{
+	HandleSimulatedAbilityCancel(Event);
+}
+
+void UAbilityComponent::HandleSimulatedAbilityCancel(const FCancelEvent& Event)
 {
 	if (IsValid(Event.CancelledAbility))
 	{
@@ -771,7 +952,7 @@ FInterruptEvent UAbilityComponent::InterruptCurrentCast(AActor* AppliedBy, UObje
 	}
 	Result.bSuccess = true;
 	Result.InterruptedAbility->ServerInterrupt(Result);
-	MulticastAbilityInterrupt(Result);
+	ReplicateAbilityInterrupt(Result);
 	if (!IsLocallyControlled())
 	{
 		ClientAbilityInterrupt(Result);
@@ -794,6 +975,11 @@ void UAbilityComponent::ClientAbilityInterrupt_Implementation(const FInterruptEv
 }
 
 void UAbilityComponent::MulticastAbilityInterrupt_Implementation(const FInterruptEvent& InterruptEvent)
+{
+	HandleSimulatedAbilityInterrupt(InterruptEvent);
+}
+
+void UAbilityComponent::HandleSimulatedAbilityInterrupt(const FInterruptEvent& InterruptEvent)
 {
 	if (GetOwnerRole() == ROLE_SimulatedProxy && IsValid(InterruptEvent.InterruptedAbility))
 	{
@@ -1013,13 +1199,13 @@ void UAbilityComponent::UpdateGlobalCooldownFromServerResult(const float Predict
 	GlobalCooldownState.PredictionID = Result.PredictionID;
 
 	//Iterate over other predictions. Any prediction that is later than the result and could be relevant (happens AFTER the previous GCD has ended), is then applied.
-	for (const TTuple<int32, FClientAbilityPrediction>& AbilityPrediction : UnackedAbilityPredictions)
+	for (const FClientAbilityPrediction& AbilityPrediction : UnackedAbilityPredictions)
 	{
-		if (AbilityPrediction.Key > GlobalCooldownState.PredictionID && AbilityPrediction.Value.Time > GlobalCooldownState.StartTime + GlobalCooldownState.Length)
+		if (AbilityPrediction.PredictionID > GlobalCooldownState.PredictionID && AbilityPrediction.Time > GlobalCooldownState.StartTime + GlobalCooldownState.Length)
 		{
-			GlobalCooldownState.bActive = AbilityPrediction.Value.bPredictedGCD;
-			GlobalCooldownState.StartTime = AbilityPrediction.Value.Time;
-			GlobalCooldownState.Length = AbilityPrediction.Value.GcdLength;
+			GlobalCooldownState.bActive = AbilityPrediction.bPredictedGCD;
+			GlobalCooldownState.StartTime = AbilityPrediction.Time;
+			GlobalCooldownState.Length = AbilityPrediction.GcdLength;
 		}
 	}
 
@@ -1059,12 +1245,11 @@ float UAbilityComponent::CalculateGlobalCooldownLength(UCombatAbility* Ability)
 		return Ability->GetDefaultGlobalCooldownLength();
 	}
 	TArray<FCombatModifier> Mods;
-	GlobalCooldownMods.GetModifiers(Mods, Ability);
 	if (IsValid(StatHandlerRef) && StatHandlerRef->IsStatValid(FSaiyoraCombatTags::Get().Stat_GlobalCooldownLength))
 	{
 		Mods.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_GlobalCooldownLength), EModifierType::Multiplicative));
 	}
-	return FMath::Max(MinGcdLength, FCombatModifier::ApplyModifiers(Mods, Ability->GetDefaultGlobalCooldownLength()));
+	return FMath::Max(MinGcdLength, GlobalCooldownMods.GetModifiedValue(Ability->GetDefaultGlobalCooldownLength(), Mods, Ability));
 }
 
 float UAbilityComponent::CalculateCastLength(UCombatAbility* Ability) const
@@ -1078,12 +1263,11 @@ float UAbilityComponent::CalculateCastLength(UCombatAbility* Ability) const
 		return Ability->GetDefaultCastLength();
 	}
 	TArray<FCombatModifier> Mods;
-	CastLengthMods.GetModifiers(Mods, Ability);
 	if (IsValid(StatHandlerRef) && StatHandlerRef->IsStatValid(FSaiyoraCombatTags::Get().Stat_CastLength))
 	{
 		Mods.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_CastLength), EModifierType::Multiplicative));
 	}
-	return FMath::Max(MinCastLength, FCombatModifier::ApplyModifiers(Mods, Ability->GetDefaultCastLength()));
+	return FMath::Max(MinCastLength, CastLengthMods.GetModifiedValue(Ability->GetDefaultCastLength(), Mods, Ability));
 }
 
 float UAbilityComponent::CalculateCooldownLength(UCombatAbility* Ability, const bool bIgnoreGlobalMin) const
@@ -1097,12 +1281,11 @@ float UAbilityComponent::CalculateCooldownLength(UCombatAbility* Ability, const
 		return Ability->GetDefaultCooldownLength();
 	}
 	TArray<FCombatModifier> Mods;
-	CooldownMods.GetModifiers(Mods, Ability);
 	if (IsValid(StatHandlerRef) && StatHandlerRef->IsStatValid(FSaiyoraCombatTags::Get().Stat_CooldownLength))
 	{
 		Mods.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_CooldownLength), EModifierType::Multiplicative));
 	}
-	return FMath::Max(bIgnoreGlobalMin ? 0.0f : MinCooldownLength, FCombatModifier::ApplyModifiers(Mods, Ability->GetDefaultCooldownLength()));
+	return FMath::Max(bIgnoreGlobalMin ? 0.0f : MinCooldownLength, CooldownMods.GetModifiedValue(Ability->GetDefaultCooldownLength(), Mods, Ability));
 }
 
 FCombatModifierHandle UAbilityComponent::AddGenericResourceCostModifier(const TSubclassOf<UResource> ResourceClass, const FCombatModifier& Modifier)
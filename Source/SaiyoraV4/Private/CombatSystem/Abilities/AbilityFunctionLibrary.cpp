@@ -1,10 +1,12 @@
 ﻿#include "AbilityFunctionLibrary.h"
 #include "AbilityComponent.h"
 #include "CombatAbility.h"
+#include "CombatantRegistrySubsystem.h"
 #include "CombatNetSubsystem.h"
 #include "CombatStatusComponent.h"
 #include "GroundAttack.h"
 #include "Hitbox.h"
+#include "LineOfSightSubsystem.h"
 #include "PredictableProjectile.h"
 #include "SaiyoraCombatInterface.h"
 #include "SaiyoraCombatLibrary.h"
@@ -13,6 +15,7 @@
 #include "CoreClasses/SaiyoraPlayerCharacter.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "KismetTraceUtils.h"
 
 static TAutoConsoleVariable<int32> DrawPredictedTraces(
 		TEXT("game.DrawPredictedTraces"),
@@ -20,6 +23,174 @@ static TAutoConsoleVariable<int32> DrawPredictedTraces(
 		TEXT("Determines whether predicted traces of all kinds should be drawn."),
 		ECVF_Default);
 
+#pragma region Profile Tables
+
+//Trace profiles, projectile profiles, and hitbox object type masks for every combination of inputs, generated at compile time so that trace paths only do a table lookup.
+struct FCombatProfileTables
+{
+	static constexpr int32 NumFactions = 3;
+	static constexpr int32 NumPlanes = 4;
+	static constexpr int32 NumFactionFilters = 5;
+	static constexpr int32 NumPlaneFilters = 3;
+
+	//Indexed by [bOverlap][TracePlane][TraceHostility][ShooterFaction].
+	const FName* TraceProfiles[2][NumPlanes][NumFactions][NumFactions] = {};
+	//Indexed by [AttackerFaction][FactionFilter].
+	const FName* ProjectileHitboxProfiles[NumFactions][NumFactionFilters] = {};
+	//Indexed by [AttackerPlane][PlaneFilter].
+	const FName* ProjectileCollisionProfiles[NumPlanes][NumPlaneFilters] = {};
+	//Indexed by [ShooterFaction][TraceHostility].
+	int32 HitboxObjectMasks[NumFactions][NumFactions] = {};
+	//Indexed by [ProjectilePlane].
+	int32 CollisionObjectMasks[NumPlanes] = {};
+
+	constexpr FCombatProfileTables()
+	{
+		for (int32 Plane = 0; Plane < NumPlanes; Plane++)
+		{
+			for (int32 Hostility = 0; Hostility < NumFactions; Hostility++)
+			{
+				for (int32 Shooter = 0; Shooter < NumFactions; Shooter++)
+				{
+					TraceProfiles[0][Plane][Hostility][Shooter] = GetTraceProfile(false, static_cast<ESaiyoraPlane>(Plane), static_cast<EFaction>(Hostility), static_cast<EFaction>(Shooter));
+					TraceProfiles[1][Plane][Hostility][Shooter] = GetTraceProfile(true, static_cast<ESaiyoraPlane>(Plane), static_cast<EFaction>(Hostility), static_cast<EFaction>(Shooter));
+				}
+			}
+			for (int32 Filter = 0; Filter < NumPlaneFilters; Filter++)
+			{
+				ProjectileCollisionProfiles[Plane][Filter] = GetProjectileCollisionProfile(static_cast<ESaiyoraPlane>(Plane), static_cast<ESaiyoraPlaneFilter>(Filter));
+			}
+			CollisionObjectMasks[Plane] = GetCollisionObjectMask(static_cast<ESaiyoraPlane>(Plane));
+		}
+		for (int32 Faction = 0; Faction < NumFactions; Faction++)
+		{
+			for (int32 Filter = 0; Filter < NumFactionFilters; Filter++)
+			{
+				ProjectileHitboxProfiles[Faction][Filter] = GetProjectileHitboxProfile(static_cast<EFaction>(Faction), static_cast<ESaiyoraFactionFilter>(Filter));
+			}
+			for (int32 Hostility = 0; Hostility < NumFactions; Hostility++)
+			{
+				HitboxObjectMasks[Faction][Hostility] = GetHitboxObjectMask(static_cast<EFaction>(Faction), static_cast<EFaction>(Hostility));
+			}
+		}
+	}
+
+private:
+
+	static constexpr const FName* GetTraceProfile(const bool bOverlap, const ESaiyoraPlane TracePlane, const EFaction TraceHostility, const EFaction ShooterFaction)
+	{
+		//Friendly traces hit the shooter's own side, enemy traces hit the other side. Non-friendly shooters count as enemies here.
+		const bool bHitsPlayers = ShooterFaction == EFaction::Friendly ? TraceHostility == EFaction::Friendly : TraceHostility == EFaction::Enemy;
+		const bool bHitsAll = TraceHostility == EFaction::Neutral;
+		switch (TracePlane)
+		{
+		case ESaiyoraPlane::Ancient :
+			if (bOverlap)
+			{
+				return bHitsAll ? &FSaiyoraCollision::CT_AncientOverlapAll : bHitsPlayers ? &FSaiyoraCollision::CT_AncientOverlapPlayers : &FSaiyoraCollision::CT_AncientOverlapNPCs;
+			}
+			return bHitsAll ? &FSaiyoraCollision::CT_AncientAll : bHitsPlayers ? &FSaiyoraCollision::CT_AncientPlayers : &FSaiyoraCollision::CT_AncientNPCs;
+		case ESaiyoraPlane::Modern :
+			if (bOverlap)
+			{
+				return bHitsAll ? &FSaiyoraCollision::CT_ModernOverlapAll : bHitsPlayers ? &FSaiyoraCollision::CT_ModernOverlapPlayers : &FSaiyoraCollision::CT_ModernOverlapNPCs;
+			}
+			return bHitsAll ? &FSaiyoraCollision::CT_ModernAll : bHitsPlayers ? &FSaiyoraCollision::CT_ModernPlayers : &FSaiyoraCollision::CT_ModernNPCs;
+		default :
+			if (bOverlap)
+			{
+				return bHitsAll ? &FSaiyoraCollision::CT_OverlapAll : bHitsPlayers ? &FSaiyoraCollision::CT_OverlapPlayers : &FSaiyoraCollision::CT_OverlapNPCs;
+			}
+			return bHitsAll ? &FSaiyoraCollision::CT_All : bHitsPlayers ? &FSaiyoraCollision::CT_Players : &FSaiyoraCollision::CT_NPCs;
+		}
+	}
+
+	static constexpr const FName* GetProjectileHitboxProfile(const EFaction AttackerFaction, const ESaiyoraFactionFilter FactionFilter)
+	{
+		switch (FactionFilter)
+		{
+		case ESaiyoraFactionFilter::OppositeFaction :
+		case ESaiyoraFactionFilter::OppositeFactionExcludeNeutral :
+			return AttackerFaction == EFaction::Friendly ? &FSaiyoraCollision::P_ProjectileHitboxNPCs
+				: AttackerFaction == EFaction::Enemy ? &FSaiyoraCollision::P_ProjectileHitboxPlayers : &FSaiyoraCollision::P_ProjectileHitboxAll;
+		case ESaiyoraFactionFilter::SameFaction :
+		case ESaiyoraFactionFilter::SameFactionExcludeNeutral :
+			return AttackerFaction == EFaction::Friendly ? &FSaiyoraCollision::P_ProjectileHitboxPlayers
+				: AttackerFaction == EFaction::Enemy ? &FSaiyoraCollision::P_ProjectileHitboxNPCs : &FSaiyoraCollision::P_ProjectileHitboxAll;
+		default :
+			return &FSaiyoraCollision::P_ProjectileHitboxAll;
+		}
+	}
+
+	static constexpr const FName* GetProjectileCollisionProfile(const ESaiyoraPlane AttackerPlane, const ESaiyoraPlaneFilter PlaneFilter)
+	{
+		switch (PlaneFilter)
+		{
+		case ESaiyoraPlaneFilter::SamePlane :
+			switch (AttackerPlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return &FSaiyoraCollision::P_ProjectileCollisionAncient;
+			case ESaiyoraPlane::Modern :
+				return &FSaiyoraCollision::P_ProjectileCollisionModern;
+			case ESaiyoraPlane::Neither :
+				return &FSaiyoraCollision::P_NoCollision;
+			default :
+				return &FSaiyoraCollision::P_ProjectileCollisionAll;
+			}
+		case ESaiyoraPlaneFilter::XPlane :
+			switch (AttackerPlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return &FSaiyoraCollision::P_ProjectileCollisionModern;
+			case ESaiyoraPlane::Modern :
+				return &FSaiyoraCollision::P_ProjectileCollisionAncient;
+			case ESaiyoraPlane::Neither :
+				return &FSaiyoraCollision::P_ProjectileCollisionAll;
+			default :
+				return &FSaiyoraCollision::P_NoCollision;
+			}
+		default :
+			return &FSaiyoraCollision::P_ProjectileCollisionAll;
+		}
+	}
+
+	static constexpr int32 GetHitboxObjectMask(const EFaction ShooterFaction, const EFaction TraceHostility)
+	{
+		constexpr int32 PlayerMask = ECC_TO_BITFIELD(FSaiyoraCollision::O_PlayerHitbox);
+		constexpr int32 NPCMask = ECC_TO_BITFIELD(FSaiyoraCollision::O_NPCHitbox);
+		//Neutral shooters and neutral traces can hit every hitbox.
+		if (ShooterFaction == EFaction::Neutral || TraceHostility == EFaction::Neutral)
+		{
+			return PlayerMask | NPCMask;
+		}
+		const bool bHitsPlayers = ShooterFaction == EFaction::Friendly ? TraceHostility == EFaction::Friendly : TraceHostility == EFaction::Enemy;
+		return bHitsPlayers ? PlayerMask : NPCMask;
+	}
+
+	static constexpr int32 GetCollisionObjectMask(const ESaiyoraPlane ProjectilePlane)
+	{
+		//WorldStatic and WorldDynamic objects exist in both planes, so only objects in Neither plane should ignore them.
+		constexpr int32 WorldMask = ECC_TO_BITFIELD(ECC_WorldStatic) | ECC_TO_BITFIELD(ECC_WorldDynamic);
+		switch (ProjectilePlane)
+		{
+		case ESaiyoraPlane::Ancient :
+			return WorldMask | ECC_TO_BITFIELD(FSaiyoraCollision::O_WorldAncient);
+		case ESaiyoraPlane::Modern :
+			return WorldMask | ECC_TO_BITFIELD(FSaiyoraCollision::O_WorldModern);
+		case ESaiyoraPlane::Both :
+			return WorldMask | ECC_TO_BITFIELD(FSaiyoraCollision::O_WorldAncient) | ECC_TO_BITFIELD(FSaiyoraCollision::O_WorldModern);
+		case ESaiyoraPlane::Neither :
+			return 0;
+		default :
+			return WorldMask;
+		}
+	}
+};
+
+static constexpr FCombatProfileTables CombatProfileTables;
+
+#pragma endregion
 #pragma region Helpers
 
 FAbilityOrigin UAbilityFunctionLibrary::MakeAbilityOrigin(const FVector& AimLocation, const FVector& AimDirection, const FVector& Origin)
@@ -84,262 +255,83 @@ FName UAbilityFunctionLibrary::GetRelevantTraceProfile(const AActor* Shooter, co
 		const UCombatStatusComponent* ShooterCombatStatus = ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(Shooter);
 		ShooterFaction = IsValid(ShooterCombatStatus) ? ShooterCombatStatus->GetCurrentFaction() : EFaction::Neutral;
 	}
-	
-	if (bOverlap)
-	{
-		switch (TraceHostility)
-		{
-			case EFaction::Friendly :
-			{
-				switch (TracePlane)
-				{
-				case ESaiyoraPlane::Ancient :
-					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientOverlapPlayers : FSaiyoraCollision::CT_AncientOverlapNPCs;
-				case ESaiyoraPlane::Modern :
-					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernOverlapPlayers : FSaiyoraCollision::CT_ModernOverlapNPCs;
-				default :
-					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_OverlapPlayers : FSaiyoraCollision::CT_OverlapNPCs;
-				}
-			}
-			case EFaction::Enemy :
-			{
-				switch (TracePlane)
-				{
-				case ESaiyoraPlane::Ancient :
-					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientOverlapNPCs : FSaiyoraCollision::CT_AncientOverlapPlayers;
-				case ESaiyoraPlane::Modern :
-					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernOverlapNPCs : FSaiyoraCollision::CT_ModernOverlapPlayers;
-				default :
-					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_OverlapNPCs : FSaiyoraCollision::CT_OverlapPlayers;
-				}
-			}
-			default :
-			{
-				switch (TracePlane)
-				{
-				case ESaiyoraPlane::Ancient :
-					return FSaiyoraCollision::CT_AncientOverlapAll;
-				case ESaiyoraPlane::Modern :
-					return FSaiyoraCollision::CT_ModernOverlapAll;
-				default :
-					return FSaiyoraCollision::CT_OverlapAll;
-				}
-			}
-		}
-	}
-	switch (TraceHostility)
-	{
-		case EFaction::Friendly :
-		{
-			switch (TracePlane)
-			{
-			case ESaiyoraPlane::Ancient :
-				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientPlayers : FSaiyoraCollision::CT_AncientNPCs;
-			case ESaiyoraPlane::Modern :
-				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernPlayers : FSaiyoraCollision::CT_ModernNPCs;
-			default :
-				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_Players : FSaiyoraCollision::CT_NPCs;
-			}
-		}
-		case EFaction::Enemy :
-		{
-			switch (TracePlane)
-			{
-			case ESaiyoraPlane::Ancient :
-				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientNPCs : FSaiyoraCollision::CT_AncientPlayers;
-			case ESaiyoraPlane::Modern :
-				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernNPCs : FSaiyoraCollision::CT_ModernPlayers;
-			default :
-				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_NPCs : FSaiyoraCollision::CT_Players;
-			}
-		}
-		default :
-		{
-			switch (TracePlane)
-			{
-			case ESaiyoraPlane::Ancient :
-				return FSaiyoraCollision::CT_AncientAll;
-			case ESaiyoraPlane::Modern :
-				return FSaiyoraCollision::CT_ModernAll;
-			default :
-				return FSaiyoraCollision::CT_All;
-			}
-		}
-	}
+	return GetTraceProfileForFaction(ShooterFaction, bOverlap, TracePlane, TraceHostility);
+}
+
+FName UAbilityFunctionLibrary::GetTraceProfileForFaction(const EFaction ShooterFaction, const bool bOverlap, const ESaiyoraPlane TracePlane, const EFaction TraceHostility)
+{
+	return *CombatProfileTables.TraceProfiles[bOverlap ? 1 : 0][static_cast<uint8>(TracePlane)][static_cast<uint8>(TraceHostility)][static_cast<uint8>(ShooterFaction)];
 }
 
 FName UAbilityFunctionLibrary::GetRelevantProjectileHitboxProfile(const EFaction AttackerFaction, const ESaiyoraFactionFilter FactionFilter)
 {
-	switch (FactionFilter)
-	{
-	case ESaiyoraFactionFilter::OppositeFaction :
-	case ESaiyoraFactionFilter::OppositeFactionExcludeNeutral :
-		{
-			switch (AttackerFaction)
-			{
-			case EFaction::Friendly :
-				return FSaiyoraCollision::P_ProjectileHitboxNPCs;
-			case EFaction::Enemy :
-				return FSaiyoraCollision::P_ProjectileHitboxPlayers;
-			default :
-				return FSaiyoraCollision::P_ProjectileHitboxAll;
-			}
-		}
-		break;
-	case ESaiyoraFactionFilter::SameFaction :
-	case ESaiyoraFactionFilter::SameFactionExcludeNeutral :
-		{
-			switch (AttackerFaction)
-			{
-			case EFaction::Friendly :
-				return FSaiyoraCollision::P_ProjectileHitboxPlayers;
-			case EFaction::Enemy :
-				return FSaiyoraCollision::P_ProjectileHitboxNPCs;
-			default :
-				return FSaiyoraCollision::P_ProjectileHitboxAll;
-			}
-		}
-		break;
-	default :
-		return FSaiyoraCollision::P_ProjectileHitboxAll;
-	}
+	return *CombatProfileTables.ProjectileHitboxProfiles[static_cast<uint8>(AttackerFaction)][static_cast<uint8>(FactionFilter)];
 }
 
 FName UAbilityFunctionLibrary::GetRelevantProjectileCollisionProfile(const ESaiyoraPlane AttackerPlane, const ESaiyoraPlaneFilter PlaneFilter)
 {
-	switch (PlaneFilter)
-	{
-	case ESaiyoraPlaneFilter::SamePlane :
-		{
-			switch (AttackerPlane)
-			{
-			case ESaiyoraPlane::Ancient :
-				return FSaiyoraCollision::P_ProjectileCollisionAncient;
-			case ESaiyoraPlane::Modern :
-				return FSaiyoraCollision::P_ProjectileCollisionModern;
-			case ESaiyoraPlane::Neither :
-				return FSaiyoraCollision::P_NoCollision;
-			default :
-				return FSaiyoraCollision::P_ProjectileCollisionAll;
-			}
-		}
-		break;
-	case ESaiyoraPlaneFilter::XPlane :
-		{
-			switch (AttackerPlane)
-			{
-			case ESaiyoraPlane::Ancient :
-				return FSaiyoraCollision::P_ProjectileCollisionModern;
-			case ESaiyoraPlane::Modern :
-				return FSaiyoraCollision::P_ProjectileCollisionAncient;
-			case ESaiyoraPlane::Neither :
-				return FSaiyoraCollision::P_ProjectileCollisionAll;
-			default :
-				return FSaiyoraCollision::P_NoCollision;
-			}
-		}
-		break;
-	default :
-		return FSaiyoraCollision::P_ProjectileCollisionAll;
-	}
+	return *CombatProfileTables.ProjectileCollisionProfiles[static_cast<uint8>(AttackerPlane)][static_cast<uint8>(PlaneFilter)];
 }
 
-void UAbilityFunctionLibrary::GetRelevantHitboxObjectTypes(const ASaiyoraPlayerCharacter* Shooter,
-                                                           const EFaction TraceHostility, TArray<TEnumAsByte<EObjectTypeQuery>>& OutObjectTypes)
+int32 UAbilityFunctionLibrary::GetRelevantHitboxObjectMask(const AActor* Shooter, const EFaction TraceHostility)
 {
 	const UCombatStatusComponent* CombatStatusComponent = ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(Shooter);
 	const EFaction ShooterFaction = IsValid(CombatStatusComponent) ? CombatStatusComponent->GetCurrentFaction() : EFaction::Neutral;
-	switch (ShooterFaction)
+	return GetHitboxObjectMaskForFaction(ShooterFaction, TraceHostility);
+}
+
+int32 UAbilityFunctionLibrary::GetHitboxObjectMaskForFaction(const EFaction ShooterFaction, const EFaction TraceHostility)
+{
+	return CombatProfileTables.HitboxObjectMasks[static_cast<uint8>(ShooterFaction)][static_cast<uint8>(TraceHostility)];
+}
+
+int32 UAbilityFunctionLibrary::GetRelevantCollisionObjectMask(const ESaiyoraPlane ProjectilePlane)
+{
+	//"None" means the object doesn't care about planes, so it should just hit non-plane level geometry.
+	return CombatProfileTables.CollisionObjectMasks[static_cast<uint8>(ProjectilePlane)];
+}
+
+void UAbilityFunctionLibrary::SweepHitboxesByObjectMask(const AActor* Shooter, const FVector& Start, const FVector& End, const float Radius, const int32 ObjectMask,
+	const TArray<AActor*>& ActorsToIgnore, const bool bDrawDebug, TArray<FHitResult>& OutHits)
+{
+	OutHits.Reset();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(SweepHitboxes), false);
+	Params.bReturnPhysicalMaterial = true;
+	Params.AddIgnoredActors(ActorsToIgnore);
+	Params.AddIgnoredActor(Shooter);
+	const bool bHit = ObjectMask != 0 && Shooter->GetWorld()->SweepMultiByObjectType(OutHits, Start, End, FQuat::Identity, FCollisionObjectQueryParams(ObjectMask),
+		FCollisionShape::MakeSphere(Radius), Params);
+	if (bDrawDebug)
 	{
-		case EFaction::Friendly :
-		{
-			switch (TraceHostility)
-			{
-				case EFaction::Friendly :
-					OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-					return;
-				case EFaction::Enemy :
-					OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
-					return;
-				default :
-					OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-					OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
-					return;
-			}
-		}
-		case EFaction::Enemy :
-		{
-			switch (TraceHostility)
-			{
-			case EFaction::Friendly :
-				OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
-				
-				return;
-			case EFaction::Enemy :
-				OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-				return;
-			default :
-				OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-				OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
-				return;
-			}
-		}
-		default :
-			OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-			OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
+		DrawDebugSphereTraceMulti(Shooter->GetWorld(), Start, End, Radius, EDrawDebugTrace::ForDuration, bHit, OutHits, FLinearColor::Green, FLinearColor::Red, 1.0f);
 	}
 }
 
-void UAbilityFunctionLibrary::GetRelevantCollisionObjectTypes(const ESaiyoraPlane ProjectilePlane, TArray<TEnumAsByte<EObjectTypeQuery>>& OutObjectTypes)
-{	
-	//WorldStatic and WorldDynamic objects exist in both planes, so only objects in Neither plane should ignore them.
-	//"None" means the object doesn't care about planes, so it should just hit non-plane level geometry.
-	switch (ProjectilePlane)
+FName UAbilityFunctionLibrary::GetRelevantGeometryTraceProfile(const ESaiyoraPlane TracePlane)
+{
+	//This matches the level geometry that the combat trace profiles from GetRelevantTraceProfile collide with.
+	switch (TracePlane)
 	{
 	case ESaiyoraPlane::Ancient :
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldAncient));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldDynamic));
-		break;
+		return FSaiyoraCollision::CT_GeometryAncient;
 	case ESaiyoraPlane::Modern :
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldModern));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldDynamic));
-		break;
-	case ESaiyoraPlane::Both :
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldAncient));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldModern));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldDynamic));
-		break;
-	case ESaiyoraPlane::Neither :
-		break;
+		return FSaiyoraCollision::CT_GeometryModern;
 	default :
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
-		OutObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldDynamic));
-		break;
+		return FSaiyoraCollision::CT_GeometryBothPlanes;
 	}
 }
 
 bool UAbilityFunctionLibrary::CheckLineOfSightInPlane(const UObject* Context, const FVector& From, const FVector& To, const ESaiyoraPlane Plane)
 {
-	FName TraceProfile = FSaiyoraCollision::CT_GeometryNone;
-	switch (Plane)
+	//Identical checks within the same frame share a single trace through the line of sight subsystem.
+	const UWorld* World = IsValid(Context) ? Context->GetWorld() : nullptr;
+	ULineOfSightSubsystem* LineOfSight = IsValid(World) ? World->GetSubsystem<ULineOfSightSubsystem>() : nullptr;
+	if (IsValid(LineOfSight))
 	{
-	case ESaiyoraPlane::Ancient :
-		TraceProfile = FSaiyoraCollision::CT_GeometryAncient;
-		break;
-	case ESaiyoraPlane::Modern :
-		TraceProfile = FSaiyoraCollision::CT_GeometryModern;
-		break;
-	case ESaiyoraPlane::Both :
-		TraceProfile = FSaiyoraCollision::CT_GeometryBothPlanes;
-	default:
-		break;
+		return LineOfSight->CheckLineOfSight(From, To, Plane);
 	}
-    
 	FHitResult Hit;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Context, From, To, TraceProfile, false,
+	UKismetSystemLibrary::LineTraceSingleByProfile(Context, From, To, ULineOfSightSubsystem::GetLineOfSightTraceProfile(Plane), false,
 		TArray<AActor*>(), EDrawDebugTrace::None, Hit, true);
     
 	return !Hit.bBlockingHit;
@@ -365,20 +357,46 @@ void UAbilityFunctionLibrary::GetCombatantsInRadius(const UObject* Context, TArr
 		const EFaction QueryFaction, const ESaiyoraFactionFilter FactionFilter, const ESaiyoraPlane QueryPlane, const ESaiyoraPlaneFilter PlaneFilter,
 		const bool bCheckLineOfSight)
 {
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
-	UKismetSystemLibrary::SphereOverlapActors(Context, Origin, Radius, ObjectTypes, nullptr, TArray<AActor*>(), OutActors);
-	FilterActorsByFaction(OutActors, QueryFaction, FactionFilter);
-	FilterActorsByPlane(OutActors, QueryPlane, PlaneFilter);
-	for (int i = OutActors.Num() - 1; i >= 0; i--)
+	OutActors.Empty();
+	const UWorld* World = IsValid(Context) ? Context->GetWorld() : nullptr;
+	if (!IsValid(World))
+	{
+		return;
+	}
+	UCombatantRegistrySubsystem* CombatantRegistry = World->GetSubsystem<UCombatantRegistrySubsystem>();
+	if (!IsValid(CombatantRegistry))
+	{
+		return;
+	}
+	//The registry already filters by faction and plane, so line of sight is only traced for combatants that would otherwise be returned.
+	CombatantRegistry->GetCombatantsInRadius(OutActors, Origin, Radius, QueryFaction, FactionFilter, QueryPlane, PlaneFilter);
+	if (!bCheckLineOfSight)
+	{
+		return;
+	}
+	ULineOfSightSubsystem* LineOfSight = World->GetSubsystem<ULineOfSightSubsystem>();
+	if (!IsValid(LineOfSight))
 	{
-		if (!OutActors[i]->Implements<USaiyoraCombatInterface>())
+		for (int i = OutActors.Num() - 1; i >= 0; i--)
 		{
-			OutActors.RemoveAt(i);
-			continue;
+			if (!CheckLineOfSightInPlane(Context, Origin, OutActors[i]->GetActorLocation(), QueryPlane))
+			{
+				OutActors.RemoveAt(i);
+			}
 		}
-		if (bCheckLineOfSight && !CheckLineOfSightInPlane(Context, Origin, OutActors[i]->GetActorLocation(), QueryPlane))
+		return;
+	}
+	TArray<FLineOfSightRequest> Requests;
+	Requests.Reserve(OutActors.Num());
+	for (const AActor* Actor : OutActors)
+	{
+		Requests.Add(FLineOfSightRequest(Origin, Actor->GetActorLocation(), QueryPlane));
+	}
+	TArray<bool> Visible;
+	LineOfSight->CheckLineOfSightBatch(Requests, Visible);
+	for (int i = OutActors.Num() - 1; i >= 0; i--)
+	{
+		if (!Visible[i])
 		{
 			OutActors.RemoveAt(i);
 		}
@@ -546,28 +564,29 @@ void UAbilityFunctionLibrary::FilterActorsByPlane(TArray<AActor*>& Actors, const
 #pragma endregion 
 #pragma region Snapshotting
 
-void UAbilityFunctionLibrary::RewindRelevantHitboxesForShooter(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin, const TArray<AActor*>& Targets,
-                                                     const TArray<AActor*>& ActorsToIgnore, TMap<UHitbox*, FTransform>& ReturnTransforms)
+void UAbilityFunctionLibrary::GetRewindQueryForShooter(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin, const TArray<AActor*>& Targets,
+	const TArray<AActor*>& ActorsToIgnore, const EFaction TraceHostility, FHitboxRewindQuery& OutQuery)
 {
 	if (!IsValid(Shooter))
 	{
 		return;
 	}
-	const float Ping = USaiyoraCombatLibrary::GetActorPing(Shooter);
 	const ASaiyoraGameState* GameState = Shooter->GetWorld()->GetGameState<ASaiyoraGameState>();
-	if (Ping <= 0.0f || !IsValid(GameState))
+	UCombatNetSubsystem* NetSubsystem = Shooter->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
+	if (!IsValid(GameState) || !IsValid(NetSubsystem))
 	{
 		return;
 	}
-	const float RewindTime = GameState->GetServerWorldTimeSeconds() - Ping;
-	//Do a big trace in front of the camera to rewind all targets that could potentially intercept the trace.
+	//With no ping, the rewind time is the current time and the query will just use current hitbox transforms.
+	const float RewindTime = GameState->GetServerWorldTimeSeconds() - FMath::Max(USaiyoraCombatLibrary::GetActorPing(Shooter), 0.0f);
+	//Only hitboxes that a trace with this hostility would collide with are added to the query.
+	const int32 ObjectMask = GetRelevantHitboxObjectMask(Shooter, TraceHostility);
+	//Do a big trace in front of the camera to find all targets that could potentially intercept the trace.
+	//This trace is against live hitboxes, so it is widened by how far any hitbox could have moved since the rewind time, plus the largest hitbox size.
 	const FVector RewindTraceEnd = Origin.AimLocation + CamTraceLength * Origin.AimDirection;
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
-	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
+	const float RewindSearchRadius = RewindTraceRadius + NetSubsystem->GetRewindSearchPadding();
 	TArray<FHitResult> RewindTraceResults;
-	UKismetSystemLibrary::SphereTraceMultiForObjects(Shooter, Origin.AimLocation, RewindTraceEnd, RewindTraceRadius, ObjectTypes, false,
-		ActorsToIgnore, EDrawDebugTrace::None, RewindTraceResults, true, FLinearColor::White);
+	SweepHitboxesByObjectMask(Shooter, Origin.AimLocation, RewindTraceEnd, RewindSearchRadius, ObjectMask, ActorsToIgnore, false, RewindTraceResults);
 	//All targets we are interested in should also be rewound, even if they weren't in the trace.
 	TArray<AActor*> RewindTargets = Targets;
 	for (const FHitResult& Hit : RewindTraceResults)
@@ -580,38 +599,83 @@ void UAbilityFunctionLibrary::RewindRelevantHitboxesForShooter(const ASaiyoraPla
 	TArray<UHitbox*> Hitboxes;
 	for (const AActor* RewindTarget : RewindTargets)
 	{
+		if (!IsValid(RewindTarget))
+		{
+			continue;
+		}
 		TArray<UHitbox*> HitboxComponents;
 		RewindTarget->GetComponents<UHitbox>(HitboxComponents);
-		Hitboxes.Append(HitboxComponents);
+		for (UHitbox* Hitbox : HitboxComponents)
+		{
+			if (Hitbox->IsQueryCollisionEnabled() && (ObjectMask & ECC_TO_BITFIELD(Hitbox->GetCollisionObjectType())) != 0)
+			{
+				Hitboxes.Add(Hitbox);
+			}
+		}
 	}
-	RewindHitboxesToTimestamp(Hitboxes, RewindTime, ReturnTransforms);
+	//Shots from the same shooter in the same frame share rewound hitboxes instead of each rewinding their own.
+	OutQuery = NetSubsystem->GetBatchedRewindQuery(Shooter, RewindTime, ObjectMask, Hitboxes);
 }
 
-void UAbilityFunctionLibrary::RewindHitboxesToTimestamp(const TArray<UHitbox*>& Hitboxes, const float Timestamp, TMap<UHitbox*, FTransform>& ReturnTransforms)
+void UAbilityFunctionLibrary::RecordShotValidation(const ASaiyoraPlayerCharacter* Shooter, const int32 NumPredicted, const int32 NumValidated)
 {
-	if (Hitboxes.Num() == 0)
+	UCombatNetSubsystem* NetSubsystem = Shooter->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
+	if (IsValid(NetSubsystem))
 	{
-		return;
+		NetSubsystem->RecordShotValidation(NumPredicted, NumValidated);
 	}
-	UCombatNetSubsystem* NetSubsystem = Hitboxes[0]->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
-	if (!IsValid(NetSubsystem))
+}
+
+void UAbilityFunctionLibrary::RewindTraceSingle(const ASaiyoraPlayerCharacter* Shooter, const FHitboxRewindQuery& RewindQuery, const FVector& Start,
+	const FVector& End, const float Radius, const ESaiyoraPlane TracePlane, const TArray<AActor*>& ActorsToIgnore, FHitResult& OutHit)
+{
+	//Level geometry is still traced in the physics scene, but hitboxes are only traced against at their rewound transforms.
+	const FName GeometryProfile = GetRelevantGeometryTraceProfile(TracePlane);
+	const EDrawDebugTrace::Type DrawDebugType = DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None;
+	FHitResult GeometryHit;
+	if (Radius > 0.0f)
 	{
-		return;
+		UKismetSystemLibrary::SphereTraceSingleByProfile(Shooter, Start, End, Radius, GeometryProfile, false, ActorsToIgnore, DrawDebugType,
+			GeometryHit, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
 	}
-	for (UHitbox* Hitbox : Hitboxes)
+	else
 	{
-		ReturnTransforms.Add(Hitbox, NetSubsystem->RewindHitbox(Hitbox, Timestamp));
+		UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Start, End, GeometryProfile, false, ActorsToIgnore, DrawDebugType,
+			GeometryHit, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
 	}
+	TArray<FHitResult> HitboxHits;
+	RewindQuery.Sweep(Start, End, Radius, ActorsToIgnore, HitboxHits);
+	//The closest blocking hit wins, the same as a single trace with a profile that blocks both geometry and hitboxes.
+	if (HitboxHits.Num() > 0 && (!GeometryHit.bBlockingHit || HitboxHits[0].Time <= GeometryHit.Time))
+	{
+		OutHit = HitboxHits[0];
+		return;
+	}
+	OutHit = GeometryHit;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
 }
 
-void UAbilityFunctionLibrary::UnrewindHitboxes(const TMap<UHitbox*, FTransform>& ReturnTransforms)
+void UAbilityFunctionLibrary::RewindTraceMulti(const ASaiyoraPlayerCharacter* Shooter, const FHitboxRewindQuery& RewindQuery, const FVector& Start,
+	const FVector& End, const float Radius, const ESaiyoraPlane TracePlane, const TArray<AActor*>& ActorsToIgnore, TArray<FHitResult>& OutHits)
 {
-	for (const TTuple<UHitbox*, FTransform>& ReturnTransform : ReturnTransforms)
-	{
-		if (IsValid(ReturnTransform.Key))
+	FHitResult GeometryHit;
+	RewindTraceSingle(Shooter, FHitboxRewindQuery(), Start, End, Radius, TracePlane, ActorsToIgnore, GeometryHit);
+	TArray<FHitResult> HitboxHits;
+	RewindQuery.Sweep(Start, End, Radius, ActorsToIgnore, HitboxHits);
+	//Hitboxes are treated as overlaps up until the first blocking geometry hit, the same as a multi trace with an overlap profile.
+	for (FHitResult& HitboxHit : HitboxHits)
+	{
+		if (GeometryHit.bBlockingHit && HitboxHit.Time > GeometryHit.Time)
 		{
-			ReturnTransform.Key->SetWorldTransform(ReturnTransform.Value);
+			break;
 		}
+		HitboxHit.bBlockingHit = false;
+		OutHits.Add(HitboxHit);
+	}
+	if (GeometryHit.bBlockingHit)
+	{
+		OutHits.Add(GeometryHit);
 	}
 }
 
@@ -678,17 +742,14 @@ bool UAbilityFunctionLibrary::ValidateLineTrace(ASaiyoraPlayerCharacter* Shooter
 	//Rewind hitboxes of all predicted targets and other actors in the way.
 	TArray<AActor*> TargetArray;
 	TargetArray.Add(Target);
-	TMap<UHitbox*, FTransform> ReturnTransforms;
-	RewindRelevantHitboxesForShooter(Shooter, Origin, TargetArray, ActorsToIgnore, ReturnTransforms);
+	FHitboxRewindQuery RewindQuery;
+	GetRewindQueryForShooter(Shooter, Origin, TargetArray, ActorsToIgnore, TraceHostility, RewindQuery);
 	
 	//Set the default trace end to the the max range of the trace (adjusted by comparing to the origin), using aim direction and aim location.
 	const FVector CamTraceEnd = Origin.AimLocation + (GetCameraTraceMaxRange(Origin.AimLocation, Origin.AimDirection, Origin.Origin, TraceLength) * Origin.AimDirection.GetSafeNormal());
-	//This profile will collide with relevant hitboxes and level geometry.
-	const FName TraceProfile = GetRelevantTraceProfile(Shooter, false, TracePlane, TraceHostility);
-	//Trace from aim location to the default trace end to see if anything is hit.
+	//Trace from aim location to the default trace end to see if any level geometry or rewound hitbox is hit.
 	FHitResult CamTraceResult;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.AimLocation, CamTraceEnd, TraceProfile, false,
-		ActorsToIgnore, EDrawDebugTrace::None, CamTraceResult, true);
+	RewindTraceSingle(Shooter, RewindQuery, Origin.AimLocation, CamTraceEnd, 0.0f, TracePlane, ActorsToIgnore, CamTraceResult);
 
 	//If there is a hit, check that it is in "front" of the origin (not between the origin and aim location). If so, use this as the new trace end.
 	const FVector OriginTraceEnd = Origin.Origin + TraceLength *
@@ -697,20 +758,12 @@ bool UAbilityFunctionLibrary::ValidateLineTrace(ASaiyoraPlayerCharacter* Shooter
 	
 	//Trace from the origin to the new trace end to make sure the origin is not obscured by other collision.
 	FHitResult OriginResult;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.Origin, OriginTraceEnd, TraceProfile, false, ActorsToIgnore,
-		DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, OriginResult, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	RewindTraceSingle(Shooter, RewindQuery, Origin.Origin, OriginTraceEnd, 0.0f, TracePlane, ActorsToIgnore, OriginResult);
 
 	//Validate the predicted hit.
-	bool bDidHit = false;
-	if (IsValid(OriginResult.GetActor()) && OriginResult.GetActor() == Target)
-	{
-		bDidHit = true;
-	}
-	
-	//Unrewind any hitboxes that were rewound previously.
-	UnrewindHitboxes(ReturnTransforms);
-	
-	return bDidHit;
+	const bool bValid = IsValid(OriginResult.GetActor()) && OriginResult.GetActor() == Target;
+	RecordShotValidation(Shooter, 1, bValid ? 1 : 0);
+	return bValid;
 }
 
 bool UAbilityFunctionLibrary::PredictMultiLineTrace(ASaiyoraPlayerCharacter* Shooter, const float TraceLength, const ESaiyoraPlane TracePlane,
@@ -784,17 +837,14 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiLineTrace(ASaiyoraPlayerCh
 	//TODO: Validate aim location and origin (if using separate origin).
 
 	//Rewind hitboxes of all predicted targets and other actors in the way.
-	TMap<UHitbox*, FTransform> ReturnTransforms;
-	RewindRelevantHitboxesForShooter(Shooter, Origin, Targets, ActorsToIgnore, ReturnTransforms);
+	FHitboxRewindQuery RewindQuery;
+	GetRewindQueryForShooter(Shooter, Origin, Targets, ActorsToIgnore, TraceHostility, RewindQuery);
 	
 	//Set the default trace end to the the max range of the trace (adjusted by comparing to the origin), using aim direction and aim location.
 	FVector AimTarget = Origin.AimLocation + Origin.AimDirection * GetCameraTraceMaxRange(Origin.AimLocation, Origin.AimDirection, Origin.Origin, TraceLength);
-	//This profile will overlap relevant hitboxes and collide with relevant level geometry.
-	const FName TraceProfile = GetRelevantTraceProfile(Shooter, true, TracePlane, TraceHostility);
-	//Trace from aim location to the default trace end to see if anything is hit.
+	//Trace from aim location to the default trace end to see if anything is hit. Rewound hitboxes are overlapped, and level geometry blocks.
 	TArray<FHitResult> HitboxTraceHits;
-	UKismetSystemLibrary::LineTraceMultiByProfile(Shooter, Origin.AimLocation, AimTarget, TraceProfile, false,
-		TArray<AActor*>(), DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, HitboxTraceHits, true);
+	RewindTraceMulti(Shooter, RewindQuery, Origin.AimLocation, AimTarget, 0.0f, TracePlane, TArray<AActor*>(), HitboxTraceHits);
 
 	//Find the first hit that is within a reasonable cone in front of the origin.
 	//Note that this is more strict than just "in front," because multi-traces tend to be aimed at groups of targets, and large skewed angles can result in misses on some of those targets.
@@ -814,8 +864,7 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiLineTrace(ASaiyoraPlayerCh
 
 	//Trace from the origin to the new trace end to make sure the origin is not obscured by other collision.
 	TArray<FHitResult> Results;
-	UKismetSystemLibrary::LineTraceMultiByProfile(Shooter, Origin.Origin, AimTarget, TraceProfile, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, Results, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	RewindTraceMulti(Shooter, RewindQuery, Origin.Origin, AimTarget, 0.0f, TracePlane, ActorsToIgnore, Results);
 
 	//Validate predicted hits.
 	for (const FHitResult& Result : Results)
@@ -826,9 +875,7 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiLineTrace(ASaiyoraPlayerCh
 		}
 	}
 	
-	//Unrewind any hitboxes that were rewound previously.
-	UnrewindHitboxes(ReturnTransforms);
-	
+	RecordShotValidation(Shooter, Targets.Num(), ValidatedTargets.Num());
 	return ValidatedTargets;
 }
 
@@ -893,17 +940,14 @@ bool UAbilityFunctionLibrary::ValidateSphereTrace(ASaiyoraPlayerCharacter* Shoot
 	//Rewind hitboxes of all predicted targets and other actors in the way.
 	TArray<AActor*> TargetArray;
 	TargetArray.Add(Target);
-	TMap<UHitbox*, FTransform> ReturnTransforms;
-	RewindRelevantHitboxesForShooter(Shooter, Origin, TargetArray, ActorsToIgnore, ReturnTransforms);
+	FHitboxRewindQuery RewindQuery;
+	GetRewindQueryForShooter(Shooter, Origin, TargetArray, ActorsToIgnore, TraceHostility, RewindQuery);
 	
 	//Set the default trace end to the the max range of the trace (adjusted by comparing to the origin), using aim direction and aim location.
 	const FVector CamTraceEnd = Origin.AimLocation + Origin.AimDirection * GetCameraTraceMaxRange(Origin.AimLocation, Origin.AimDirection, Origin.Origin, TraceLength);
-	//This profile will collide with relevant hitboxes and level geometry.
-	const FName TraceProfile = GetRelevantTraceProfile(Shooter, false, TracePlane, TraceHostility);
-	//Trace from aim location to the default trace end to see if anything is hit.
+	//Trace from aim location to the default trace end to see if any level geometry or rewound hitbox is hit.
 	FHitResult CamTraceResult;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.AimLocation, CamTraceEnd,
-		TraceProfile, false, ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, CamTraceResult, true);
+	RewindTraceSingle(Shooter, RewindQuery, Origin.AimLocation, CamTraceEnd, 0.0f, TracePlane, ActorsToIgnore, CamTraceResult);
 
 	//If there is a hit, check that it is in "front" of the origin (not between the origin and aim location). If so, use this as the new trace end.
 	const FVector OriginTraceEnd = Origin.Origin + TraceLength *
@@ -912,20 +956,12 @@ bool UAbilityFunctionLibrary::ValidateSphereTrace(ASaiyoraPlayerCharacter* Shoot
 
 	//Trace from the origin to the new trace end to make sure the origin is not obscured by other collision.
 	FHitResult OriginResult;
-	UKismetSystemLibrary::SphereTraceSingleByProfile(Shooter, Origin.Origin, OriginTraceEnd, TraceRadius, TraceProfile, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, OriginResult, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	RewindTraceSingle(Shooter, RewindQuery, Origin.Origin, OriginTraceEnd, TraceRadius, TracePlane, ActorsToIgnore, OriginResult);
 
 	//Validate the predicted hit.
-	bool bDidHit = false;
-	if (IsValid(OriginResult.GetActor()) && OriginResult.GetActor() == Target)
-	{
-		bDidHit = true;
-	}
-
-	//Unrewind any hitboxes that were rewound previously.
-	UnrewindHitboxes(ReturnTransforms);
-	
-	return bDidHit;
+	const bool bValid = IsValid(OriginResult.GetActor()) && OriginResult.GetActor() == Target;
+	RecordShotValidation(Shooter, 1, bValid ? 1 : 0);
+	return bValid;
 }
 
 bool UAbilityFunctionLibrary::PredictMultiSphereTrace(ASaiyoraPlayerCharacter* Shooter, const float TraceLength,
@@ -1000,17 +1036,14 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereTrace(ASaiyoraPlayer
 	//TODO: Validate aim location and origin (if using separate origin).
 
 	//Rewind hitboxes of all predicted targets and other actors in the way.
-	TMap<UHitbox*, FTransform> ReturnTransforms;
-	RewindRelevantHitboxesForShooter(Shooter, Origin, Targets, ActorsToIgnore, ReturnTransforms);
+	FHitboxRewindQuery RewindQuery;
+	GetRewindQueryForShooter(Shooter, Origin, Targets, ActorsToIgnore, TraceHostility, RewindQuery);
 
 	//Set the default trace end to the the max range of the trace (adjusted by comparing to the origin), using aim direction and aim location.
 	FVector AimTarget = Origin.AimLocation + Origin.AimDirection * GetCameraTraceMaxRange(Origin.AimLocation, Origin.AimDirection, Origin.Origin, TraceLength);
-	//This profile will overlap relevant hitboxes and collide with relevant level geometry.
-	const FName TraceProfile = GetRelevantTraceProfile(Shooter, true, TracePlane, TraceHostility);
-	//Trace from aim location to the default trace end to see if anything is hit.
+	//Trace from aim location to the default trace end to see if anything is hit. Rewound hitboxes are overlapped, and level geometry blocks.
 	TArray<FHitResult> HitboxTraceHits;
-	UKismetSystemLibrary::LineTraceMultiByProfile(Shooter, Origin.AimLocation, AimTarget, TraceProfile, false,
-		TArray<AActor*>(), DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, HitboxTraceHits, true);
+	RewindTraceMulti(Shooter, RewindQuery, Origin.AimLocation, AimTarget, 0.0f, TracePlane, TArray<AActor*>(), HitboxTraceHits);
 
 	//Find the first hit that is within a reasonable cone in front of the origin.
 	//Note that this is more strict than just "in front," because multi-traces tend to be aimed at groups of targets, and large skewed angles can result in misses on some of those targets.
@@ -1029,8 +1062,7 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereTrace(ASaiyoraPlayer
 
 	//Trace from the origin to the new trace end to make sure the origin is not obscured by other collision.
 	TArray<FHitResult> Results;
-	UKismetSystemLibrary::SphereTraceMultiByProfile(Shooter, Origin.Origin, AimTarget, TraceRadius, TraceProfile, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, Results, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	RewindTraceMulti(Shooter, RewindQuery, Origin.Origin, AimTarget, TraceRadius, TracePlane, ActorsToIgnore, Results);
 
 	//Validate predicted hits.
 	for (const FHitResult& Result : Results)
@@ -1040,10 +1072,8 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereTrace(ASaiyoraPlayer
 			ValidatedTargets.AddUnique(Result.GetActor());
 		}
 	}
-
-	//Unrewind any hitboxes that were rewound previously.
-	UnrewindHitboxes(ReturnTransforms);
 	
+	RecordShotValidation(Shooter, Targets.Num(), ValidatedTargets.Num());
 	return ValidatedTargets;
 }
 
@@ -1083,13 +1113,11 @@ bool UAbilityFunctionLibrary::PredictSphereSightTrace(ASaiyoraPlayerCharacter* S
 	//If there is a hit, use this as the final trace end.
 	const FVector SphereTraceEnd = OriginTraceResult.bBlockingHit ? OriginTraceResult.ImpactPoint : OriginTraceEnd;
 	//Use object types instead of a profile here, so that level geometry is ignored and only hitboxes are considered. Level geometry was traced against already for targeting and will be checked later for line of sight.
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	GetRelevantHitboxObjectTypes(Shooter, TraceHostility, ObjectTypes);
+	const int32 ObjectMask = GetRelevantHitboxObjectMask(Shooter, TraceHostility);
 	//Trace from the origin to the final trace end. This is a multi-trace, since some targets may fail the line of sight requirement.
 	TArray<FHitResult> SphereTraceResults;
-	UKismetSystemLibrary::SphereTraceMultiForObjects(Shooter, OutOrigin.Origin, SphereTraceEnd, TraceRadius, ObjectTypes, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		SphereTraceResults, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	SweepHitboxesByObjectMask(Shooter, OutOrigin.Origin, SphereTraceEnd, TraceRadius, ObjectMask, ActorsToIgnore,
+		DrawPredictedTraces.GetValueOnGameThread() > 0, SphereTraceResults);
 
 	//Trace against level geometry for each possible target to check for line of sight to the origin.
 	bool bValidResult = false;
@@ -1148,17 +1176,14 @@ bool UAbilityFunctionLibrary::ValidateSphereSightTrace(ASaiyoraPlayerCharacter*
 	//Rewind hitboxes of all predicted targets and other actors in the way.
 	TArray<AActor*> TargetArray;
 	TargetArray.Add(Target);
-	TMap<UHitbox*, FTransform> ReturnTransforms;
-	RewindRelevantHitboxesForShooter(Shooter, Origin, TargetArray, ActorsToIgnore, ReturnTransforms);
+	FHitboxRewindQuery RewindQuery;
+	GetRewindQueryForShooter(Shooter, Origin, TargetArray, ActorsToIgnore, TraceHostility, RewindQuery);
 
 	//Set the default trace end to the the max range of the trace (adjusted by comparing to the origin), using aim direction and aim location.
 	const FVector CamTraceEnd = Origin.AimLocation + Origin.AimDirection * GetCameraTraceMaxRange(Origin.AimLocation, Origin.AimDirection, Origin.Origin, TraceLength);
-	//This profile will collide with relevant hitboxes and level geometry.
-	const FName TraceProfile = GetRelevantTraceProfile(Shooter, false, TracePlane, TraceHostility);
-	//Trace from aim location to the default trace end to see if anything is hit.
+	//Trace from aim location to the default trace end to see if any level geometry or rewound hitbox is hit.
 	FHitResult CamTraceResult;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.AimLocation, CamTraceEnd, TraceProfile, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, CamTraceResult, true);
+	RewindTraceSingle(Shooter, RewindQuery, Origin.AimLocation, CamTraceEnd, 0.0f, TracePlane, ActorsToIgnore, CamTraceResult);
 
 	//If there is a hit, check that it is in "front" of the origin (not between the origin and aim location). If so, use this as the new trace end.
 	const FVector OriginTraceEnd = Origin.Origin + TraceLength *
@@ -1167,24 +1192,18 @@ bool UAbilityFunctionLibrary::ValidateSphereSightTrace(ASaiyoraPlayerCharacter*
 	
 	//Trace from the origin to the new trace end to make sure the origin is not obscured by other collision.
 	FHitResult OriginTraceResult;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.Origin, OriginTraceEnd, TraceProfile, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, OriginTraceResult, true);
+	RewindTraceSingle(Shooter, RewindQuery, Origin.Origin, OriginTraceEnd, 0.0f, TracePlane, ActorsToIgnore, OriginTraceResult);
 
 	//If there is a hit, use this as the final trace end.
 	const FVector SphereTraceEnd = OriginTraceResult.bBlockingHit ? OriginTraceResult.ImpactPoint : OriginTraceEnd;
-	//Use object types instead of a profile here, so that level geometry is ignored and only hitboxes are considered. Level geometry was traced against already for targeting and will be checked later for line of sight.
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	GetRelevantHitboxObjectTypes(Shooter, TraceHostility, ObjectTypes);
-	//Trace from the origin to the final trace end. This is a multi-trace, since some targets may fail the line of sight requirement.
+	//Sweep only against rewound hitboxes here, so that level geometry is ignored. Level geometry was traced against already for targeting and will be checked later for line of sight.
 	TArray<FHitResult> SphereTraceResults;
-	UKismetSystemLibrary::SphereTraceMultiForObjects(Shooter, Origin.Origin, SphereTraceEnd, TraceRadius, ObjectTypes, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		SphereTraceResults, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	RewindQuery.Sweep(Origin.Origin, SphereTraceEnd, TraceRadius, ActorsToIgnore, SphereTraceResults);
 
 	//Check line of sight only for the predicted hit target, ignoring other targets.
 	bool bDidHit = false;
-	//This trace profile will overlap relevant hitboxes and collide with relevant level geometry. Since a single line trace is used, hitbox hits won't be returned.
-	const FName LineOfSightTraceProfile = GetRelevantTraceProfile(Shooter, true, TracePlane, TraceHostility);
+	//Line of sight only needs to check level geometry, which is never rewound.
+	const FName LineOfSightTraceProfile = GetRelevantGeometryTraceProfile(TracePlane);
 	for (const FHitResult& SphereTraceResult : SphereTraceResults)
 	{
 		if (IsValid(SphereTraceResult.GetActor()) && SphereTraceResult.GetActor() == Target)
@@ -1202,10 +1221,8 @@ bool UAbilityFunctionLibrary::ValidateSphereSightTrace(ASaiyoraPlayerCharacter*
 			break;
 		}
 	}
-
-	//Unrewind any hitboxes that were rewound previously.
-	UnrewindHitboxes(ReturnTransforms);
 	
+	RecordShotValidation(Shooter, 1, bDidHit ? 1 : 0);
 	return bDidHit;
 }
 
@@ -1255,13 +1272,11 @@ bool UAbilityFunctionLibrary::PredictMultiSphereSightTrace(ASaiyoraPlayerCharact
 	//If there is a hit, use this as the final trace end.
 	const FVector SphereTraceEnd = OriginTraceResult.bBlockingHit ? OriginTraceResult.ImpactPoint : AimTarget;
 	//Use object types instead of a profile here, so that level geometry is ignored and only hitboxes are considered. Level geometry was traced against already for targeting and will be checked later for line of sight.
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	GetRelevantHitboxObjectTypes(Shooter, TraceHostility, ObjectTypes);
+	const int32 ObjectMask = GetRelevantHitboxObjectMask(Shooter, TraceHostility);
 	//Trace from the origin to the final trace end.
 	TArray<FHitResult> SphereTraceResults;
-	UKismetSystemLibrary::SphereTraceMultiForObjects(Shooter, OutOrigin.Origin, SphereTraceEnd, TraceRadius, ObjectTypes, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		SphereTraceResults, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	SweepHitboxesByObjectMask(Shooter, OutOrigin.Origin, SphereTraceEnd, TraceRadius, ObjectMask, ActorsToIgnore,
+		DrawPredictedTraces.GetValueOnGameThread() > 0, SphereTraceResults);
 
 	//Trace against level geometry for each possible target to check for line of sight to the origin.
 	for (const FHitResult& SphereTraceResult : SphereTraceResults)
@@ -1312,17 +1327,14 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereSightTrace(ASaiyoraP
 	//TODO: Validate aim location and origin (if using separate origin).
 
 	//Rewind hitboxes of all predicted targets and other actors in the way.
-	TMap<UHitbox*, FTransform> ReturnTransforms;
-	RewindRelevantHitboxesForShooter(Shooter, Origin, Targets, ActorsToIgnore, ReturnTransforms);
+	FHitboxRewindQuery RewindQuery;
+	GetRewindQueryForShooter(Shooter, Origin, Targets, ActorsToIgnore, TraceHostility, RewindQuery);
 	
 	//Set the default trace end to the the max range of the trace (adjusted by comparing to the origin), using aim direction and aim location.
 	FVector AimTarget = Origin.AimLocation + Origin.AimDirection * GetCameraTraceMaxRange(Origin.AimLocation, Origin.AimDirection, Origin.Origin, TraceLength);
-	//This profile will overlap relevant hitboxes and collide with relevant level geometry.
-	const FName TraceProfile = GetRelevantTraceProfile(Shooter, true, TracePlane, TraceHostility);
-	//Trace from aim location to the default trace end to see if anything is hit.
+	//Trace from aim location to the default trace end to see if anything is hit. Rewound hitboxes are overlapped, and level geometry blocks.
 	TArray<FHitResult> HitboxTraceHits;
-	UKismetSystemLibrary::LineTraceMultiByProfile(Shooter, Origin.AimLocation, AimTarget, TraceProfile, false,
-		TArray<AActor*>(), DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, HitboxTraceHits, true);
+	RewindTraceMulti(Shooter, RewindQuery, Origin.AimLocation, AimTarget, 0.0f, TracePlane, TArray<AActor*>(), HitboxTraceHits);
 	
 	//Find the first hit that is within a reasonable cone in front of the origin.
 	//Note that this is more strict than just "in front," because multi-traces tend to be aimed at groups of targets, and large skewed angles can result in misses on some of those targets.
@@ -1339,21 +1351,17 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereSightTrace(ASaiyoraP
 		}
 	}
 
-	//Trace from the origin to the new trace end to make sure the origin is not obscured by other collision.
+	//Trace from the origin to the new trace end to make sure the origin is not obscured by level geometry. Hitboxes don't block this trace.
+	const FName GeometryTraceProfile = GetRelevantGeometryTraceProfile(TracePlane);
 	FHitResult OriginTraceResult;
-	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.Origin, AimTarget, TraceProfile, false,
+	UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.Origin, AimTarget, GeometryTraceProfile, false,
 		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, OriginTraceResult, true);
 
 	//If there is a hit, use this as the final trace end.
 	const FVector SphereTraceEnd = OriginTraceResult.bBlockingHit ? OriginTraceResult.ImpactPoint : AimTarget;
-	//Use object types instead of a profile here, so that level geometry is ignored and only hitboxes are considered. Level geometry was traced against already for targeting and will be checked later for line of sight.
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	GetRelevantHitboxObjectTypes(Shooter, TraceHostility, ObjectTypes);
-	//Trace from the origin to the final trace end.
+	//Sweep only against rewound hitboxes here, so that level geometry is ignored. Level geometry was traced against already for targeting and will be checked later for line of sight.
 	TArray<FHitResult> SphereTraceResults;
-	UKismetSystemLibrary::SphereTraceMultiForObjects(Shooter, Origin.Origin, SphereTraceEnd, TraceRadius, ObjectTypes, false,
-		ActorsToIgnore, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		SphereTraceResults, true, FLinearColor::Green, FLinearColor::Red, 1.0f);
+	RewindQuery.Sweep(Origin.Origin, SphereTraceEnd, TraceRadius, ActorsToIgnore, SphereTraceResults);
 
 	//Check line of sight only for predicted hit targets.
 	for (const FHitResult& SphereTraceResult : SphereTraceResults)
@@ -1363,7 +1371,7 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereSightTrace(ASaiyoraP
 			TArray<AActor*> LineOfSightIgnoreActors = ActorsToIgnore;
 			LineOfSightIgnoreActors.Add(SphereTraceResult.GetActor());
 			FHitResult LineOfSightResult;
-			UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.Origin, SphereTraceResult.ImpactPoint, TraceProfile, false,
+			UKismetSystemLibrary::LineTraceSingleByProfile(Shooter, Origin.Origin, SphereTraceResult.ImpactPoint, GeometryTraceProfile, false,
 				LineOfSightIgnoreActors, DrawPredictedTraces.GetValueOnGameThread() > 0 ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None, LineOfSightResult, true);
 			//If the line of sight trace hits nothing, the target is in line of sight of the origin, and is valid.
 			if (!LineOfSightResult.bBlockingHit)
@@ -1372,10 +1380,8 @@ TArray<AActor*> UAbilityFunctionLibrary::ValidateMultiSphereSightTrace(ASaiyoraP
 			}
 		}
 	}
-
-	//Unrewind any hitboxes that were rewound previously.
-	UnrewindHitboxes(ReturnTransforms);
 	
+	RecordShotValidation(Shooter, Targets.Num(), ValidatedTargets.Num());
 	return ValidatedTargets;
 }
 
@@ -1404,24 +1410,7 @@ APredictableProjectile* UAbilityFunctionLibrary::PredictProjectile(UCombatAbilit
 	
 	FTransform SpawnTransform;
 	SpawnTransform.SetLocation(OutOrigin.Origin);
-	//Choose very far point straight from the camera as the default aim target.
-	FVector AimTarget = OutOrigin.AimLocation + OutOrigin.AimDirection * CamTraceLength;
-	//Trace from the camera forward to the default aim target, looking for anything that would block visibility that we could be aiming at.
-	TArray<TEnumAsByte<EObjectTypeQuery>> CollisionObjectTypes;
-	GetRelevantCollisionObjectTypes(ProjectilePlane, CollisionObjectTypes);
-	FHitResult VisTraceResult;
-	UKismetSystemLibrary::LineTraceSingleForObjects(Shooter, OutOrigin.AimLocation, AimTarget, CollisionObjectTypes, false,
-		TArray<AActor*>(), EDrawDebugTrace::None, VisTraceResult, true, FLinearColor::Red, FLinearColor::Green, 5.0f);
-	if (VisTraceResult.bBlockingHit)
-	{
-		//If there is something in the direction we're aiming, check if its within an allowed cone to prevent firing off at strange angles.
-		const float Angle = UKismetMathLibrary::DegAcos(FVector::DotProduct((VisTraceResult.ImpactPoint - OutOrigin.Origin).GetSafeNormal(), OutOrigin.AimDirection));
-		if (Angle < AimToleranceDegrees)
-		{
-			AimTarget = VisTraceResult.ImpactPoint;
-		}
-	}
-	SpawnTransform.SetRotation((AimTarget - OutOrigin.Origin).Rotation().Quaternion());
+	SpawnTransform.SetRotation(GetProjectileAimRotation(Shooter, OutOrigin, ProjectilePlane).Quaternion());
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.Owner = Shooter;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
@@ -1454,15 +1443,241 @@ APredictableProjectile* UAbilityFunctionLibrary::ValidateProjectile(UCombatAbili
 	
 	//TODO: Validate aim location.
 	
+	FTransform SpawnTransform;
+	SpawnTransform.SetLocation(Origin.Origin);
+	SpawnTransform.SetRotation(GetProjectileAimRotation(Shooter, Origin, ProjectilePlane).Quaternion());
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = Shooter;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APredictableProjectile* NewProjectile = Shooter->GetWorld()->SpawnActor<APredictableProjectile>(ProjectileClass, SpawnTransform, SpawnParams);
+	if (!IsValid(NewProjectile))
+	{
+		return nullptr;
+	}
+	NewProjectile->InitializeProjectile(Ability, CurrentTick, NewProjectileID, ProjectilePlane, ProjectileHostility);
+	return NewProjectile;
+}
+
+int32 UAbilityFunctionLibrary::PredictSimulatedProjectile(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter,
+	const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit, FAbilityOrigin& OutOrigin)
+{
+	if (!IsValid(Ability) || !IsValid(Shooter) || !Shooter->IsLocallyControlled())
+	{
+		return -1;
+	}
+
+	GenerateOriginInfo(Shooter, OutOrigin);
+
+	//For predicted projectiles, just get the origin info and let the server spawn the projectile.
+	if (Shooter->GetLocalRole() == ROLE_Authority)
+	{
+		return -1;
+	}
+
+	FProjectileSource Source;
+	Source.Owner = Shooter;
+	Source.Shooter = Shooter;
+	Source.SourceClass = Ability->GetClass();
+	Source.SourceAbility = Ability;
+	Source.SourceTick = FPredictedTick(Ability->GetPredictionID(), Ability->GetCurrentTick());
+	UCombatNetSubsystem* NetSubsystem = Shooter->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
+	Source.ID = IsValid(NetSubsystem) ? NetSubsystem->GetNewProjectileID(Shooter, Source.SourceTick) : -1;
+
+	UProjectileSimulationSubsystem* ProjectileSubsystem = Shooter->GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!IsValid(ProjectileSubsystem))
+	{
+		return -1;
+	}
+	
+	ProjectileSubsystem->SpawnProjectile(Source, OutOrigin.Origin, GetProjectileAimRotation(Shooter, OutOrigin, Params.Plane).Vector(), 0.0f, Params, OnHit);
+	return Source.ID;
+}
+
+int32 UAbilityFunctionLibrary::ValidateSimulatedProjectile(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter,
+	const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit, const FAbilityOrigin& Origin)
+{
+	if (!IsValid(Ability) || !IsValid(Shooter) || Shooter->GetLocalRole() != ROLE_Authority)
+	{
+		return -1;
+	}
+
+	FProjectileSource Source;
+	Source.Owner = Shooter;
+	Source.Shooter = Shooter;
+	Source.SourceClass = Ability->GetClass();
+	Source.SourceAbility = Ability;
+	Source.SourceTick = FPredictedTick(Ability->GetPredictionID(), Ability->GetCurrentTick());
+	UCombatNetSubsystem* NetSubsystem = Shooter->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
+	Source.ID = IsValid(NetSubsystem) ? NetSubsystem->GetNewProjectileID(Shooter, Source.SourceTick) : -1;
+
+	UProjectileSimulationSubsystem* ProjectileSubsystem = Shooter->GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!IsValid(ProjectileSubsystem))
+	{
+		return -1;
+	}
+	
+	const FAbilityOrigin ValidatedOrigin = GetValidatedProjectileOrigin(Shooter, Origin);
+
+	//Locally controlled players on the server didn't predict anything, so there is nothing to catch up to.
+	const float CatchUpTime = Shooter->IsLocallyControlled() ? 0.0f : USaiyoraCombatLibrary::GetActorPing(Shooter);
+	//A single projectile is a volley of one, so other clients get it through the same RPC and the server replicates its hit.
+	const FVector AimDirection = GetProjectileAimRotation(Shooter, ValidatedOrigin, Params.Plane).Vector();
+	ProjectileSubsystem->SpawnVolley(Source, ValidatedOrigin.Origin, AimDirection, 1, 0.0f, CatchUpTime, Params, OnHit);
+	ReplicateSimulatedVolley(Ability, Source, ValidatedOrigin.Origin, AimDirection, 1, 0.0f, CatchUpTime, Params);
+	return Source.ID;
+}
+
+int32 UAbilityFunctionLibrary::PredictSimulatedVolley(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter,
+	const FSimulatedProjectileParams& Params, const int32 Count, const float SpreadAngle, const FSimulatedProjectileCallback& OnHit, FAbilityOrigin& OutOrigin)
+{
+	if (!IsValid(Ability) || !IsValid(Shooter) || !Shooter->IsLocallyControlled() || Count <= 0 || Count > MaxVolleyCount)
+	{
+		return -1;
+	}
+
+	GenerateOriginInfo(Shooter, OutOrigin);
+
+	//For predicted projectiles, just get the origin info and let the server spawn the projectiles.
+	if (Shooter->GetLocalRole() == ROLE_Authority)
+	{
+		return -1;
+	}
+
+	FProjectileSource Source;
+	Source.Owner = Shooter;
+	Source.Shooter = Shooter;
+	Source.SourceClass = Ability->GetClass();
+	Source.SourceAbility = Ability;
+	Source.SourceTick = FPredictedTick(Ability->GetPredictionID(), Ability->GetCurrentTick());
+	UCombatNetSubsystem* NetSubsystem = Shooter->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
+	if (!IsValid(NetSubsystem))
+	{
+		return -1;
+	}
+	//IDs for a tick are handed out in order, so the volley gets consecutive IDs.
+	Source.ID = NetSubsystem->GetNewProjectileID(Shooter, Source.SourceTick);
+	for (int32 i = 1; i < Count; i++)
+	{
+		NetSubsystem->GetNewProjectileID(Shooter, Source.SourceTick);
+	}
+
+	UProjectileSimulationSubsystem* ProjectileSubsystem = Shooter->GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!IsValid(ProjectileSubsystem))
+	{
+		return -1;
+	}
+	
+	ProjectileSubsystem->SpawnVolley(Source, OutOrigin.Origin, GetProjectileAimRotation(Shooter, OutOrigin, Params.Plane).Vector(), Count, SpreadAngle, 0.0f, Params, OnHit);
+	return Source.ID;
+}
+
+int32 UAbilityFunctionLibrary::ValidateSimulatedVolley(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter,
+	const FSimulatedProjectileParams& Params, const int32 Count, const float SpreadAngle, const FSimulatedProjectileCallback& OnHit, const FAbilityOrigin& Origin)
+{
+	if (!IsValid(Ability) || !IsValid(Shooter) || Shooter->GetLocalRole() != ROLE_Authority || Count <= 0 || Count > MaxVolleyCount)
+	{
+		return -1;
+	}
+
+	FProjectileSource Source;
+	Source.Owner = Shooter;
+	Source.Shooter = Shooter;
+	Source.SourceClass = Ability->GetClass();
+	Source.SourceAbility = Ability;
+	Source.SourceTick = FPredictedTick(Ability->GetPredictionID(), Ability->GetCurrentTick());
+	UCombatNetSubsystem* NetSubsystem = Shooter->GetWorld()->GetSubsystem<UCombatNetSubsystem>();
+	if (!IsValid(NetSubsystem))
+	{
+		return -1;
+	}
+	Source.ID = NetSubsystem->GetNewProjectileID(Shooter, Source.SourceTick);
+	for (int32 i = 1; i < Count; i++)
+	{
+		NetSubsystem->GetNewProjectileID(Shooter, Source.SourceTick);
+	}
+
+	UProjectileSimulationSubsystem* ProjectileSubsystem = Shooter->GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!IsValid(ProjectileSubsystem))
+	{
+		return -1;
+	}
+
+	const FAbilityOrigin ValidatedOrigin = GetValidatedProjectileOrigin(Shooter, Origin);
+
+	const FVector AimDirection = GetProjectileAimRotation(Shooter, ValidatedOrigin, Params.Plane).Vector();
+	const float CatchUpTime = Shooter->IsLocallyControlled() ? 0.0f : USaiyoraCombatLibrary::GetActorPing(Shooter);
+	ProjectileSubsystem->SpawnVolley(Source, ValidatedOrigin.Origin, AimDirection, Count, SpreadAngle, CatchUpTime, Params, OnHit);
+	ReplicateSimulatedVolley(Ability, Source, ValidatedOrigin.Origin, AimDirection, Count, SpreadAngle, CatchUpTime, Params);
+	return Source.ID;
+}
+
+int32 UAbilityFunctionLibrary::FireSimulatedProjectiles(UCombatAbility* Ability, const FSimulatedProjectileParams& Params, const FVector& Origin,
+	const FVector& AimDirection, const FSimulatedProjectileCallback& OnHit, const int32 Count, const float SpreadAngle)
+{
+	if (!IsValid(Ability) || !IsValid(Ability->GetHandler()) || Ability->GetHandler()->GetOwnerRole() != ROLE_Authority || Count <= 0 || Count > MaxVolleyCount)
+	{
+		return -1;
+	}
+	UProjectileSimulationSubsystem* ProjectileSubsystem = Ability->GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!IsValid(ProjectileSubsystem))
+	{
+		return -1;
+	}
+
+	AActor* Shooter = Ability->GetHandler()->GetOwner();
+	FProjectileSource Source;
+	Source.Owner = Cast<ASaiyoraPlayerCharacter>(Shooter);
+	Source.Shooter = Shooter;
+	Source.SourceClass = Ability->GetClass();
+	Source.SourceAbility = Ability;
+	Source.SourceTick = FPredictedTick(Ability->GetPredictionID(), Ability->GetCurrentTick());
+	//Nothing was predicted, so these IDs don't need to line up with a client's.
+	Source.ID = ProjectileSubsystem->GetNewAuthorityProjectileID(Count);
+
+	ProjectileSubsystem->SpawnVolley(Source, Origin, AimDirection, Count, SpreadAngle, 0.0f, Params, OnHit);
+	ReplicateSimulatedVolley(Ability, Source, Origin, AimDirection.GetSafeNormal(), Count, SpreadAngle, 0.0f, Params);
+	return Source.ID;
+}
+
+void UAbilityFunctionLibrary::ReplicateSimulatedVolley(UCombatAbility* Ability, const FProjectileSource& Source, const FVector& Origin,
+	const FVector& AimDirection, const int32 Count, const float SpreadAngle, const float CatchUpTime, const FSimulatedProjectileParams& Params)
+{
+	const UWorld* World = Ability->GetWorld();
+	if (World->GetNetMode() == NM_Standalone || !IsValid(World->GetGameState()))
+	{
+		return;
+	}
+	FProjectileVolley Volley;
+	Volley.SourceTick = Source.SourceTick;
+	Volley.SourceClass = Source.SourceClass;
+	Volley.FirstID = Source.ID;
+	Volley.Count = Count;
+	Volley.Origin = Origin;
+	Volley.AimDirection = AimDirection;
+	Volley.SpreadAngle = SpreadAngle;
+	//Clients catch up to where the server's projectiles are, which is already ahead by the shooter's ping.
+	Volley.FireTime = World->GetGameState()->GetServerWorldTimeSeconds() - CatchUpTime;
+	Volley.Params = Params;
+	const int32 VisualIndex = IsValid(Params.VisualClass) ? Ability->GetProjectileVisualIndex(Params.VisualClass) : INDEX_NONE;
+	if (IsValid(Params.VisualClass) && VisualIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Volley visual %s is not in the projectile visuals of %s, other clients will not display it."), *Params.VisualClass->GetName(), *Ability->GetName());
+	}
+	Volley.VisualIndex = VisualIndex <= MAX_int8 ? VisualIndex : INDEX_NONE;
+	Ability->GetHandler()->ReplicateProjectileVolley(Volley);
+}
+
+FRotator UAbilityFunctionLibrary::GetProjectileAimRotation(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin, const ESaiyoraPlane ProjectilePlane)
+{
 	//Choose very far point straight from the camera as the default aim target.
 	FVector AimTarget = Origin.AimLocation + Origin.AimDirection * CamTraceLength;
 	//Trace from the camera forward to the default aim target, looking for anything that would block visibility that we could be aiming at.
-	TArray<TEnumAsByte<EObjectTypeQuery>> CollisionObjectTypes;
-	GetRelevantCollisionObjectTypes(ProjectilePlane, CollisionObjectTypes);
+	const int32 CollisionObjectMask = GetRelevantCollisionObjectMask(ProjectilePlane);
 	FHitResult VisTraceResult;
-	UKismetSystemLibrary::LineTraceSingleForObjects(Shooter, Origin.AimLocation, AimTarget, CollisionObjectTypes, false,
-		TArray<AActor*>(), EDrawDebugTrace::None, VisTraceResult, true, FLinearColor::Red, FLinearColor::Green, 5.0f);
-	if (VisTraceResult.bBlockingHit)
+	FCollisionQueryParams VisTraceParams(SCENE_QUERY_STAT(ProjectileAim), false);
+	VisTraceParams.AddIgnoredActor(Shooter);
+	if (CollisionObjectMask != 0 && Shooter->GetWorld()->LineTraceSingleByObjectType(VisTraceResult, Origin.AimLocation, AimTarget,
+		FCollisionObjectQueryParams(CollisionObjectMask), VisTraceParams))
 	{
 		//If there is something in the direction we're aiming, check if its within an allowed cone to prevent firing off at strange angles.
 		const float Angle = UKismetMathLibrary::DegAcos(FVector::DotProduct((VisTraceResult.ImpactPoint - Origin.Origin).GetSafeNormal(), Origin.AimDirection));
@@ -1471,20 +1686,28 @@ APredictableProjectile* UAbilityFunctionLibrary::ValidateProjectile(UCombatAbili
 			AimTarget = VisTraceResult.ImpactPoint;
 		}
 	}
-	
-	FTransform SpawnTransform;
-	SpawnTransform.SetLocation(Origin.Origin);
-	SpawnTransform.SetRotation((AimTarget - Origin.Origin).Rotation().Quaternion());
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = Shooter;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	APredictableProjectile* NewProjectile = Shooter->GetWorld()->SpawnActor<APredictableProjectile>(ProjectileClass, SpawnTransform, SpawnParams);
-	if (!IsValid(NewProjectile))
+	return (AimTarget - Origin.Origin).Rotation();
+}
+
+FAbilityOrigin UAbilityFunctionLibrary::GetValidatedProjectileOrigin(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin)
+{
+	//Locally controlled players on the server generated their origin on the server, so there is nothing to check.
+	if (Shooter->IsLocallyControlled())
 	{
-		return nullptr;
+		return Origin;
 	}
-	NewProjectile->InitializeProjectile(Ability, CurrentTick, NewProjectileID, ProjectilePlane, ProjectileHostility);
-	return NewProjectile;
+	FAbilityOrigin ServerOrigin;
+	GenerateOriginInfo(Shooter, ServerOrigin);
+	//The shooter could have moved this far between firing on their machine and the server receiving it.
+	const float Tolerance = OriginToleranceDistance + Shooter->GetVelocity().Size() * FMath::Max(USaiyoraCombatLibrary::GetActorPing(Shooter), 0.0f);
+	const float ToleranceSquared = FMath::Square(Tolerance);
+	if (Origin.AimDirection.IsNearlyZero() || Origin.AimDirection.ContainsNaN()
+		|| FVector::DistSquared(Origin.AimLocation, ServerOrigin.AimLocation) > ToleranceSquared
+		|| FVector::DistSquared(Origin.Origin, ServerOrigin.Origin) > ToleranceSquared)
+	{
+		return ServerOrigin;
+	}
+	return Origin;
 }
 
 #pragma endregion 
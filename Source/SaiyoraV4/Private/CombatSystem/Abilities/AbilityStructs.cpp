@@ -1,5 +1,220 @@
 ﻿#include "AbilityStructs.h"
 #include "CombatAbility.h"
+#include "Engine/NetSerialization.h"
+
+bool FAbilityOrigin::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bHasOrigin = Ar.IsSaving() ? !(AimLocation.IsZero() && AimDirection.IsZero() && Origin.IsZero()) : 0;
+	Ar.SerializeBits(&bHasOrigin, 1);
+	if (!bHasOrigin)
+	{
+		if (Ar.IsLoading())
+		{
+			Clear();
+		}
+		bOutSuccess = true;
+		return true;
+	}
+	bOutSuccess = SerializePackedVector<100, 30>(AimLocation, Ar);
+	bOutSuccess &= SerializePackedVector<100, 30>(Origin, Ar);
+	//Directions built from component forward vectors are always unit length. Anything else passed in from Blueprint keeps its magnitude.
+	uint8 bUnitDirection = Ar.IsSaving() ? AimDirection.IsNormalized() : 0;
+	Ar.SerializeBits(&bUnitDirection, 1);
+	if (bUnitDirection)
+	{
+		bOutSuccess &= SerializeFixedVector<1, 16>(AimDirection, Ar);
+	}
+	else
+	{
+		bOutSuccess &= SerializePackedVector<100, 30>(AimDirection, Ar);
+	}
+	return true;
+}
+
+bool FAbilityTargetSet::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedSetID = static_cast<uint32>(SetID);
+	Ar.SerializeIntPacked(PackedSetID);
+	uint32 NumTargets = Targets.Num();
+	//The receiving side rejects anything over the limit, so extra targets are dropped instead of sending a set that would fail to load.
+	if (Ar.IsSaving() && NumTargets > MaxSerializedTargets)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ability target set %i has %i targets, only the first %i will be sent."), SetID, NumTargets, MaxSerializedTargets);
+		NumTargets = MaxSerializedTargets;
+	}
+	Ar.SerializeIntPacked(NumTargets);
+	if (Ar.IsLoading())
+	{
+		SetID = static_cast<int32>(PackedSetID);
+		if (NumTargets > MaxSerializedTargets)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		Targets.SetNum(NumTargets);
+	}
+	for (uint32 i = 0; i < NumTargets; i++)
+	{
+		UObject* TargetObject = Targets[i];
+		Ar << TargetObject;
+		if (Ar.IsLoading())
+		{
+			Targets[i] = Cast<AActor>(TargetObject);
+		}
+	}
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FAbilityTargetSet::NetSerializeSets(FArchive& Ar, UPackageMap* Map, TArray<FAbilityTargetSet>& TargetSets, bool& bOutSuccess)
+{
+	uint32 NumSets = TargetSets.Num();
+	if (Ar.IsSaving() && NumSets > MaxSerializedSets)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ability event has %i target sets, only the first %i will be sent."), NumSets, MaxSerializedSets);
+		NumSets = MaxSerializedSets;
+	}
+	Ar.SerializeIntPacked(NumSets);
+	if (Ar.IsLoading())
+	{
+		if (NumSets > MaxSerializedSets)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		TargetSets.SetNum(NumSets);
+	}
+	bOutSuccess = true;
+	for (uint32 i = 0; i < NumSets; i++)
+	{
+		bool bSetSuccess = true;
+		if (!TargetSets[i].NetSerialize(Ar, Map, bSetSuccess))
+		{
+			bOutSuccess = false;
+			return false;
+		}
+		bOutSuccess &= bSetSuccess;
+	}
+	return true;
+}
+
+bool FAbilityEvent::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << ActionTaken;
+	UObject* AbilityObject = Ability;
+	Ar << AbilityObject;
+	uint32 PackedTick = static_cast<uint32>(Tick);
+	Ar.SerializeIntPacked(PackedTick);
+	uint32 PackedPredictionID = static_cast<uint32>(PredictionID);
+	Ar.SerializeIntPacked(PackedPredictionID);
+	uint32 NumFailReasons = FailReasons.Num();
+	if (Ar.IsSaving() && NumFailReasons > MaxSerializedFailReasons)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ability event has %i fail reasons, only the first %i will be sent."), NumFailReasons, MaxSerializedFailReasons);
+		NumFailReasons = MaxSerializedFailReasons;
+	}
+	Ar.SerializeIntPacked(NumFailReasons);
+	if (Ar.IsLoading())
+	{
+		Ability = Cast<UCombatAbility>(AbilityObject);
+		Tick = static_cast<int32>(PackedTick);
+		PredictionID = static_cast<int32>(PackedPredictionID);
+		if (NumFailReasons > MaxSerializedFailReasons)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		FailReasons.SetNum(NumFailReasons);
+	}
+	for (uint32 i = 0; i < NumFailReasons; i++)
+	{
+		Ar << FailReasons[i];
+	}
+	bool bOriginSuccess = true;
+	Origin.NetSerialize(Ar, Map, bOriginSuccess);
+	bool bTargetSuccess = true;
+	if (!FAbilityTargetSet::NetSerializeSets(Ar, Map, Targets, bTargetSuccess))
+	{
+		bOutSuccess = false;
+		return false;
+	}
+	bOutSuccess = bOriginSuccess && bTargetSuccess && !Ar.IsError();
+	return true;
+}
+
+void FPredictedTickWindow::Record(const FPredictedTick& Tick, const bool bSuccess)
+{
+	if (IsOutsideWindow(Tick.PredictionID))
+	{
+		return;
+	}
+	FSlot& Slot = Slots[GetSlotIndex(Tick.PredictionID)];
+	if (!Slot.bInUse || Slot.PredictionID != Tick.PredictionID)
+	{
+		if (Slot.bInUse && Slot.PredictionID > Tick.PredictionID)
+		{
+			return;
+		}
+		Slot.bInUse = true;
+		Slot.PredictionID = Tick.PredictionID;
+		Slot.ProcessedTicks = 0;
+		Slot.SuccessfulTicks = 0;
+		Slot.OverflowTicks.Reset();
+	}
+	if (Tick.TickNumber >= 0 && Tick.TickNumber < MaskedTicks)
+	{
+		const uint64 TickBit = 1ull << Tick.TickNumber;
+		Slot.ProcessedTicks |= TickBit;
+		Slot.SuccessfulTicks = bSuccess ? Slot.SuccessfulTicks | TickBit : Slot.SuccessfulTicks & ~TickBit;
+	}
+	else
+	{
+		TPair<int32, bool>* Existing = Slot.OverflowTicks.FindByPredicate([&Tick](const TPair<int32, bool>& Overflow) { return Overflow.Key == Tick.TickNumber; });
+		if (Existing)
+		{
+			Existing->Value = bSuccess;
+		}
+		else
+		{
+			Slot.OverflowTicks.Add(TPair<int32, bool>(Tick.TickNumber, bSuccess));
+		}
+	}
+	if (!bHasRecords || Tick.PredictionID > NewestPredictionID)
+	{
+		bHasRecords = true;
+		NewestPredictionID = Tick.PredictionID;
+	}
+}
+
+bool FPredictedTickWindow::Find(const FPredictedTick& Tick, bool& bOutSuccess) const
+{
+	bOutSuccess = false;
+	if (IsOutsideWindow(Tick.PredictionID))
+	{
+		return true;
+	}
+	const FSlot& Slot = Slots[GetSlotIndex(Tick.PredictionID)];
+	if (!Slot.bInUse || Slot.PredictionID != Tick.PredictionID)
+	{
+		return false;
+	}
+	if (Tick.TickNumber >= 0 && Tick.TickNumber < MaskedTicks)
+	{
+		const uint64 TickBit = 1ull << Tick.TickNumber;
+		bOutSuccess = (Slot.SuccessfulTicks & TickBit) != 0;
+		return (Slot.ProcessedTicks & TickBit) != 0;
+	}
+	const TPair<int32, bool>* Existing = Slot.OverflowTicks.FindByPredicate([&Tick](const TPair<int32, bool>& Overflow) { return Overflow.Key == Tick.TickNumber; });
+	if (Existing)
+	{
+		bOutSuccess = Existing->Value;
+		return true;
+	}
+	return false;
+}
 
 void FAbilityCost::PostReplicatedAdd(const FAbilityCostArray& InArraySerializer)
 {
@@ -153,6 +153,7 @@ void UCombatAbility::DeactivateAbility()
     }
     OnChargesChanged.Clear();
     bDeactivated = true;
+    SetCastFailReason(ECastFailReason::InvalidAbility, true);
 }
 
 void UCombatAbility::OnRep_Deactivated()
@@ -187,7 +188,7 @@ void UCombatAbility::ModifyCurrentCharges(const int32 Charges, const EChargeModi
     }
     if (PreviousCharges != AbilityCooldown.CurrentCharges)
     {
-        UpdateCastable();
+        UpdateChargesCastable();
         if (AbilityCooldown.CurrentCharges == AbilityCooldown.MaxCharges && AbilityCooldown.OnCooldown)
         {
             CancelCooldown();
@@ -223,7 +224,7 @@ void UCombatAbility::CommitCharges(const int32 PredictionID)
     }
     if (PreviousCharges != AbilityCooldown.CurrentCharges)
     {
-        UpdateCastable();
+        UpdateChargesCastable();
         OnChargesChanged.Broadcast(this, PreviousCharges, AbilityCooldown.CurrentCharges);
     }
 }
@@ -257,7 +258,7 @@ void UCombatAbility::CompleteCooldown()
     AbilityCooldown.CurrentCharges = FMath::Clamp(AbilityCooldown.CurrentCharges + GetChargesPerCooldown(), 0, AbilityCooldown.MaxCharges);
     if (PreviousCharges != AbilityCooldown.CurrentCharges)
     {
-        UpdateCastable();
+        UpdateChargesCastable();
         OnChargesChanged.Broadcast(this, PreviousCharges, AbilityCooldown.CurrentCharges);
     }
     if (AbilityCooldown.CurrentCharges < AbilityCooldown.MaxCharges)
@@ -314,7 +315,7 @@ void UCombatAbility::OnRep_AbilityCooldown(FAbilityCooldown const& PreviousState
     RecalculatePredictedCooldown();
     if (PreviousState.CurrentCharges != AbilityCooldown.CurrentCharges)
     {
-        UpdateCastable();
+        UpdateChargesCastable();
         OnChargesChanged.Broadcast(this, PreviousState.CurrentCharges, AbilityCooldown.CurrentCharges);
     }
 }
@@ -413,7 +414,7 @@ void UCombatAbility::UpdateCostMet(const TSubclassOf<UResource> ResourceClass, c
     {
         if (UnmetCosts.Remove(ResourceClass) > 0 && UnmetCosts.Num() == 0)
         {
-            UpdateCastable();
+            SetCastFailReason(ECastFailReason::CostsNotMet, false);
         }
     }
     else
@@ -422,7 +423,7 @@ void UCombatAbility::UpdateCostMet(const TSubclassOf<UResource> ResourceClass, c
         UnmetCosts.Add(ResourceClass);
         if (PreviouslyUnmet == 0 && UnmetCosts.Num() > 0)
         {
-            UpdateCastable();
+            SetCastFailReason(ECastFailReason::CostsNotMet, true);
         }
     }
 }
@@ -618,7 +619,7 @@ void UCombatAbility::UpdatePredictionFromServer(const FServerAbilityResult& Resu
         RecalculatePredictedCooldown();
         if (PreviousCharges != AbilityCooldown.CurrentCharges)
         {
-            UpdateCastable();
+            UpdateChargesCastable();
             OnChargesChanged.Broadcast(this, PreviousCharges, AbilityCooldown.CurrentCharges);
         }
     }
@@ -770,7 +771,7 @@ void UCombatAbility::OnMaxChargesUpdated(const int32 OldValue, const int32 NewVa
     }
     if (PreviousCharges != AbilityCooldown.CurrentCharges)
     {
-        UpdateCastable();
+        UpdateChargesCastable();
         OnChargesChanged.Broadcast(this, PreviousCharges, AbilityCooldown.CurrentCharges);
     }
 }
@@ -885,58 +886,70 @@ void UCombatAbility::UpdateChargesPerCooldownModifier(const FCombatModifierHandl
 
 void UCombatAbility::UpdateCastable()
 {
-    const TArray<ECastFailReason> PreviousFailReasons = CastFailReasons;
-    CastFailReasons.Empty();
-    
-    if (!bInitialized || bDeactivated)
-    {
-        CastFailReasons.AddUnique(ECastFailReason::InvalidAbility);
-    }
-    if (GetCurrentCharges() < GetChargeCost())
-    {
-        CastFailReasons.AddUnique(ECastFailReason::ChargesNotMet);
-    }
-    if (UnmetCosts.Num() > 0)
-    {
-        CastFailReasons.AddUnique(ECastFailReason::CostsNotMet);
-    }
-    if (CustomCastRestrictions.Num() > 0)
-    {
-        CastFailReasons.AddUnique(ECastFailReason::AbilityConditionsNotMet);
-    }
-    if (bTagsRestricted)
+    SetCastFailReason(ECastFailReason::InvalidAbility, !bInitialized || bDeactivated);
+    UpdateChargesCastable();
+    SetCastFailReason(ECastFailReason::CostsNotMet, UnmetCosts.Num() > 0);
+    SetCastFailReason(ECastFailReason::AbilityConditionsNotMet, CustomCastRestrictions.Num() > 0);
+    SetCastFailReason(ECastFailReason::CustomRestriction, bTagsRestricted);
+    SetCastFailReason(ECastFailReason::AlreadyCasting, !bCastableWhileCasting && OwningComponent->IsCasting());
+    SetCastFailReason(ECastFailReason::OnGlobalCooldown, bOnGlobalCooldown && OwningComponent->IsGlobalCooldownActive());
+    SetCastFailReason(ECastFailReason::Dead, !bCastableWhileDead && IsValid(DamageHandlerRef) && DamageHandlerRef->GetLifeStatus() != ELifeStatus::Alive);
+    SetCastFailReason(ECastFailReason::Moving, !bCastableWhileMoving && IsValid(MovementCompRef) && MovementCompRef->IsMoving());
+
+    //Virtual call for NPCAbility (or any other derived ability class) to set additional fail reasons.
+    AdditionalCastableUpdate();
+}
+
+void UCombatAbility::SetCastFailReason(const ECastFailReason FailReason, const bool bActive)
+{
+    const uint32 PreviousMask = CastFailMask;
+    if (bActive)
     {
-        CastFailReasons.AddUnique(ECastFailReason::CustomRestriction);
+        CastFailMask |= CastFailBit(FailReason);
     }
-    if (!bCastableWhileCasting && OwningComponent->IsCasting())
+    else
     {
-        CastFailReasons.AddUnique(ECastFailReason::AlreadyCasting);
+        CastFailMask &= ~CastFailBit(FailReason);
     }
-    if (bOnGlobalCooldown && OwningComponent->IsGlobalCooldownActive())
+    if (CastFailMask == PreviousMask || bCastableBroadcastPending)
     {
-        CastFailReasons.AddUnique(ECastFailReason::OnGlobalCooldown);
+        return;
     }
-    if (!bCastableWhileDead && IsValid(DamageHandlerRef) && DamageHandlerRef->GetLifeStatus() != ELifeStatus::Alive)
+    //Resource ticks, GCD and cast state can all flip reasons in the same frame, so listeners only hear about the end result once per frame.
+    UWorld* World = GetWorld();
+    if (!IsValid(World))
     {
-        CastFailReasons.AddUnique(ECastFailReason::Dead);
+        BroadcastCastableChanged();
+        return;
     }
-    if (!bCastableWhileMoving && IsValid(MovementCompRef) && MovementCompRef->IsMoving())
+    bCastableBroadcastPending = true;
+    World->GetTimerManager().SetTimerForNextTick(this, &UCombatAbility::BroadcastCastableChanged);
+}
+
+void UCombatAbility::BroadcastCastableChanged()
+{
+    bCastableBroadcastPending = false;
+    if (CastFailMask == BroadcastCastFailMask)
     {
-        CastFailReasons.AddUnique(ECastFailReason::Moving);
+        return;
     }
+    BroadcastCastFailMask = CastFailMask;
+    TArray<ECastFailReason> FailReasons;
+    OnCastableChanged.Broadcast(this, IsCastable(FailReasons), FailReasons);
+}
 
-    //Virtual call for NPCAbility (or any other derived ability class) to add additional fail reasons.
-    TArray<ECastFailReason> AdditionalFailReasons;
-    AdditionalCastableUpdate(AdditionalFailReasons);
-    for (const ECastFailReason FailReason : AdditionalFailReasons)
+bool UCombatAbility::IsCastable(TArray<ECastFailReason>& FailReasons) const
+{
+    FailReasons.Reset();
+    if (CastFailMask == 0)
     {
-        CastFailReasons.AddUnique(FailReason);
+        return true;
     }
-    
-    if (PreviousFailReasons != CastFailReasons)
+    for (uint32 RemainingMask = CastFailMask; RemainingMask != 0; RemainingMask &= RemainingMask - 1)
     {
-        OnCastableChanged.Broadcast(this, CastFailReasons.Num() == 0, CastFailReasons);
+        FailReasons.Add(static_cast<ECastFailReason>(FMath::CountTrailingZeros(RemainingMask)));
     }
+    return false;
 }
 
 void UCombatAbility::AddRestrictedTag(const FGameplayTag RestrictedTag)
@@ -949,7 +962,7 @@ void UCombatAbility::AddRestrictedTag(const FGameplayTag RestrictedTag)
     if (!bTagsRestricted && RestrictedTags.Num() > 0)
     {
         bTagsRestricted = true;
-        UpdateCastable();
+        SetCastFailReason(ECastFailReason::CustomRestriction, true);
     }
 }
 
@@ -963,7 +976,7 @@ void UCombatAbility::RemoveRestrictedTag(const FGameplayTag RestrictedTag)
     if (bTagsRestricted && RestrictedTags.Num() == 0)
     {
         bTagsRestricted = false;
-        UpdateCastable();
+        SetCastFailReason(ECastFailReason::CustomRestriction, false);
     }
 }
 
@@ -977,7 +990,7 @@ void UCombatAbility::ActivateCastRestriction(const FGameplayTag RestrictionTag)
     CustomCastRestrictions.Add(RestrictionTag);
     if (PreviousRestrictions == 0 && CustomCastRestrictions.Num() > 0)
     {
-        UpdateCastable();
+        SetCastFailReason(ECastFailReason::AbilityConditionsNotMet, true);
     }
 }
 
@@ -991,7 +1004,7 @@ void UCombatAbility::DeactivateCastRestriction(const FGameplayTag RestrictionTag
     CustomCastRestrictions.Remove(RestrictionTag);
     if (PreviousRestrictions > 0 && CustomCastRestrictions.Num() == 0)
     {
-        UpdateCastable();
+        SetCastFailReason(ECastFailReason::AbilityConditionsNotMet, false);
     }
 }
 
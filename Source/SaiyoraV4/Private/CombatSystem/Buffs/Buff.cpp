@@ -23,6 +23,7 @@ void UBuff::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimePro
     DOREPLIFETIME(UBuff, CreationEvent);
     DOREPLIFETIME(UBuff, LastApplyEvent);
     DOREPLIFETIME(UBuff, RemovalReason);
+    DOREPLIFETIME(UBuff, RemovalSerial);
 }
 
 void UBuff::InitializeBuff(FBuffApplyEvent& Event, UBuffHandler* NewHandler, const bool bIgnoreRestrictions, const EBuffApplicationOverrideType StackOverrideType,
@@ -117,11 +118,21 @@ void UBuff::InitializeBuff(FBuffApplyEvent& Event, UBuffHandler* NewHandler, con
 
 void UBuff::OnRep_CreationEvent()
 {
-    if (Status != EBuffStatus::Spawning || CreationEvent.ActionTaken != EBuffApplyAction::NewBuff)
+    if (CreationEvent.ActionTaken != EBuffApplyAction::NewBuff)
     {
         //The check for new buff is more to guard against replicating a default CreationEvent than anything else.
         return;
     }
+    //The server recycles poolable buffs, so a new creation event on a buff we already initialized is a new application of the same instance.
+    if (Status != EBuffStatus::Spawning)
+    {
+        if (Status == EBuffStatus::Active)
+        {
+            //We never got the removal for the last application, so clean it up locally first.
+            TerminateBuff(EBuffExpireReason::Invalid);
+        }
+        ResetLocalState();
+    }
     GameStateRef = GetWorld()->GetGameState<AGameState>();
 
     //Copy buff state from the replicated creation event
@@ -250,6 +261,11 @@ void UBuff::OnRep_LastApplyEvent()
         //Wait for CreationEvent replication to initialize the buff. This function will be called again if needed.
         return;
     }
+    if (LastApplyEvent.ActionTaken == EBuffApplyAction::Failed || LastApplyEvent.ActionTaken == EBuffApplyAction::NewBuff)
+    {
+        //Recycled buffs replicate a default LastApplyEvent, which shouldn't be treated as an application.
+        return;
+    }
     CurrentStacks = LastApplyEvent.NewStacks;
     if (LastApplyEvent.ActionTaken == EBuffApplyAction::Refreshed || LastApplyEvent.ActionTaken == EBuffApplyAction::StackedAndRefreshed)
     {
@@ -268,6 +284,42 @@ void UBuff::OnRep_LastApplyEvent()
     OnUpdated.Broadcast(LastApplyEvent);
 }
 
+#pragma endregion
+#pragma region Pooling
+
+void UBuff::ResetForReuse()
+{
+    ResetLocalState();
+    CreationEvent = FBuffApplyEvent();
+    LastApplyEvent = FBuffApplyEvent();
+    RemovalReason = EBuffExpireReason::Invalid;
+}
+
+void UBuff::ResetLocalState()
+{
+    if (GetWorld())
+    {
+        GetWorld()->GetTimerManager().ClearTimer(ExpireHandle);
+    }
+    for (UBuffFunction* BuffFunction : BuffFunctionObjects)
+    {
+        if (BuffFunction)
+        {
+            BuffFunction->CleanupBuffFunction();
+        }
+    }
+    OnRecycled();
+    Status = EBuffStatus::Spawning;
+    Handler = nullptr;
+    CurrentStacks = 0;
+    LastRefreshTime = 0.0f;
+    ExpireTime = 0.0f;
+    bIgnoringRestrictions = false;
+    //Anything bound to the last application shouldn't hear about the next one.
+    OnRemoved.Clear();
+    OnUpdated.Clear();
+}
+
 #pragma endregion
 #pragma region Expiration
 
@@ -296,6 +348,10 @@ FBuffRemoveEvent UBuff::TerminateBuff(const EBuffExpireReason TerminationReason)
         GetWorld()->GetTimerManager().ClearTimer(ExpireHandle);
     }
     RemovalReason = TerminationReason;
+    if (Handler->GetOwnerRole() == ROLE_Authority)
+    {
+        RemovalSerial++;
+    }
     
     FBuffRemoveEvent RemoveEvent;
     RemoveEvent.Result = true;
@@ -329,9 +385,9 @@ FBuffRemoveEvent UBuff::TerminateBuff(const EBuffExpireReason TerminationReason)
 
 void UBuff::OnRep_RemovalReason()
 {
-    if (RemovalReason == EBuffExpireReason::Invalid)
+    if (RemovalReason == EBuffExpireReason::Invalid || Status != EBuffStatus::Active)
     {
-        //Guard against replicating the default RemovalReason.
+        //Guard against replicating the default RemovalReason, or a removal that was already handled locally.
         return;
     }
     TerminateBuff(RemovalReason);
@@ -1,5 +1,7 @@
 #include "BuffHandler.h"
 #include "Buff.h"
+#include "BuffPoolSubsystem.h"
+#include "CombatEventSubsystem.h"
 #include "CombatAbility.h"
 #include "CombatStatusComponent.h"
 #include "SaiyoraCombatInterface.h"
@@ -38,6 +40,8 @@ void UBuffHandler::InitializeComponent()
 	MovementComponentRef = ISaiyoraCombatInterface::Execute_GetCustomMovementComponent(GetOwner());
 	CcHandlerRef = ISaiyoraCombatInterface::Execute_GetCrowdControlHandler(GetOwner());
 	NPCComponentRef = Cast<UNPCAbilityComponent>(ISaiyoraCombatInterface::Execute_GetAbilityComponent(GetOwner()));
+	BuffPool = GetWorld()->GetSubsystem<UBuffPoolSubsystem>();
+	CombatEventBus = GetWorld()->GetSubsystem<UCombatEventSubsystem>();
 }
 
 void UBuffHandler::BeginPlay()
@@ -57,6 +61,32 @@ void UBuffHandler::BeginPlay()
 	}
 }
 
+void UBuffHandler::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	//Buffs on this actor are destroyed with it, so the actors that applied them need to drop them from their outgoing buffs.
+	TSet<UBuffHandler*> Appliers;
+	for (const UBuff* Buff : ActiveBuffs)
+	{
+		if (IsValid(Buff) && IsValid(Buff->GetAppliedBy()) && Buff->GetAppliedBy()->Implements<USaiyoraCombatInterface>())
+		{
+			UBuffHandler* Applier = ISaiyoraCombatInterface::Execute_GetBuffHandler(Buff->GetAppliedBy());
+			if (IsValid(Applier))
+			{
+				Appliers.Add(Applier);
+			}
+		}
+	}
+	for (UBuffHandler* Applier : Appliers)
+	{
+		Applier->ReleaseOutgoingBuffsOnActor(GetOwner());
+	}
+	if (IsValid(BuffPool))
+	{
+		BuffPool->ReleaseActor(GetOwner());
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 void UBuffHandler::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -138,7 +168,7 @@ FBuffApplyEvent UBuffHandler::ApplyBuff(const TSubclassOf<UBuff> BuffClass, AAct
 	else
 	{
 		//Currently, this can't fail from this point on. We assume the object will be created and initialize okay.
-		Event.AffectedBuff = NewObject<UBuff>(GetOwner(), Event.BuffClass);
+		Event.AffectedBuff = IsValid(BuffPool) ? BuffPool->AcquireBuff(GetOwner(), Event.BuffClass) : NewObject<UBuff>(GetOwner(), Event.BuffClass);
 		Event.AffectedBuff->InitializeBuff(Event, this, IgnoreRestrictions, StackOverrideType, OverrideStacks, RefreshOverrideType, OverrideDuration);
 	}
     return Event;
@@ -156,8 +186,13 @@ void UBuffHandler::NotifyOfNewIncomingBuff(const FBuffApplyEvent& ApplicationEve
 		return;
 	}
 	ActiveBuffs.Add(ApplicationEvent.AffectedBuff);
+	ActiveBuffIndex.Add(ApplicationEvent.AffectedBuff, ApplicationEvent.AffectedBuff->GetAppliedBy());
 	AddReplicatedSubObject(ApplicationEvent.AffectedBuff);
 	OnIncomingBuffApplied.Broadcast(ApplicationEvent);
+	if (IsValid(CombatEventBus))
+	{
+		CombatEventBus->QueueBuffApplyEvent(ApplicationEvent);
+	}
 	//Alert the actor who applied this buff that they should keep track of it as well.
 	if (IsValid(ApplicationEvent.AffectedBuff->GetAppliedBy()) && ApplicationEvent.AffectedBuff->GetAppliedBy()->Implements<USaiyoraCombatInterface>())
 	{
@@ -176,6 +211,7 @@ void UBuffHandler::NotifyOfNewOutgoingBuff(const FBuffApplyEvent& ApplicationEve
 		return;
 	}
 	OutgoingBuffs.Add(ApplicationEvent.AffectedBuff);
+	OutgoingBuffIndex.Add(ApplicationEvent.AffectedBuff, ApplicationEvent.AffectedBuff->GetAppliedTo());
 	OnOutgoingBuffApplied.Broadcast(ApplicationEvent);
 }
 
@@ -199,7 +235,12 @@ void UBuffHandler::NotifyOfIncomingBuffRemoval(const FBuffRemoveEvent& RemoveEve
 	}
 	if (ActiveBuffs.Remove(RemoveEvent.RemovedBuff) > 0)
 	{
+		ActiveBuffIndex.Remove(RemoveEvent.RemovedBuff);
 		OnIncomingBuffRemoved.Broadcast(RemoveEvent);
+		if (IsValid(CombatEventBus))
+		{
+			CombatEventBus->QueueBuffRemoveEvent(RemoveEvent);
+		}
 		//Move the buff to another array that will continue to replicate for a short time.
 		//This lets clients get the chance to call any effects for buff removal.
 		//After 1 second, we remove the buff from that array so it will stop replicating and be garbage collected.
@@ -225,15 +266,26 @@ void UBuffHandler::NotifyOfOutgoingBuffRemoval(const FBuffRemoveEvent& RemoveEve
 	//We don't need to worry about moving it to another array for replication, the target will handle that.
 	if (OutgoingBuffs.Remove(RemoveEvent.RemovedBuff) > 0)
 	{
+		OutgoingBuffIndex.Remove(RemoveEvent.RemovedBuff);
 		OnOutgoingBuffRemoved.Broadcast(RemoveEvent);
 	}
 }
 
+void UBuffHandler::ReleaseOutgoingBuffsOnActor(const AActor* Target)
+{
+	OutgoingBuffIndex.RemoveAllForActor(Target);
+	OutgoingBuffs.RemoveAll([Target](const UBuff* Buff) { return !IsValid(Buff) || Buff->GetAppliedTo() == Target; });
+}
+
 void UBuffHandler::PostRemoveCleanup(UBuff* Buff)
 {
 	//After letting a removed buff replicate, we can get rid of it.
 	RemoveReplicatedSubObject(Buff);
-	RecentlyRemoved.Remove(Buff);	
+	RecentlyRemoved.Remove(Buff);
+	if (IsValid(BuffPool))
+	{
+		BuffPool->ReleaseBuff(Buff);
+	}
 }
 
 void UBuffHandler::RemoveBuffsOnOwnerDeath(AActor* Actor, const ELifeStatus PreviousStatus, const ELifeStatus NewStatus)
@@ -275,6 +327,94 @@ void UBuffHandler::RemoveBuffsOnCombatEnd(const ENPCCombatBehavior PreviousBehav
 	}
 }
 
+#pragma endregion
+#pragma region Buff Index
+
+void FBuffLookupIndex::Add(UBuff* Buff, const AActor* OtherActor)
+{
+	const TObjectKey<UBuff> BuffKey(Buff);
+	FIndexedBuff& Indexed = IndexedBuffs.Add(BuffKey);
+	Indexed.Class = TObjectKey<UClass>(Buff->GetClass());
+	Indexed.Actor = TObjectKey<AActor>(OtherActor);
+	Buff->GetBuffTags(Indexed.Tags);
+	ByClass.FindOrAdd(Indexed.Class).Add(BuffKey);
+	ByActor.FindOrAdd(Indexed.Actor).Add(BuffKey);
+	ByClassAndActor.FindOrAdd(FClassActorKey(Indexed.Class, Indexed.Actor)).Add(BuffKey);
+	for (const FGameplayTag Tag : Indexed.Tags)
+	{
+		ByTag.FindOrAdd(Tag).Add(BuffKey);
+	}
+}
+
+void FBuffLookupIndex::Remove(const UBuff* Buff)
+{
+	RemoveByKey(TObjectKey<UBuff>(Buff));
+}
+
+void FBuffLookupIndex::RemoveAllForActor(const AActor* OtherActor)
+{
+	const FBucket* Bucket = ByActor.Find(OtherActor);
+	if (!Bucket)
+	{
+		return;
+	}
+	//Copy the keys, since removing them empties and removes this bucket.
+	const FBucket BuffKeys = *Bucket;
+	for (const TObjectKey<UBuff>& BuffKey : BuffKeys)
+	{
+		RemoveByKey(BuffKey);
+	}
+}
+
+void FBuffLookupIndex::RemoveByKey(const TObjectKey<UBuff>& BuffKey)
+{
+	FIndexedBuff Indexed;
+	if (!IndexedBuffs.RemoveAndCopyValue(BuffKey, Indexed))
+	{
+		return;
+	}
+	RemoveFromBucket(ByClass, Indexed.Class, BuffKey);
+	RemoveFromBucket(ByActor, Indexed.Actor, BuffKey);
+	RemoveFromBucket(ByClassAndActor, FClassActorKey(Indexed.Class, Indexed.Actor), BuffKey);
+	for (const FGameplayTag Tag : Indexed.Tags)
+	{
+		RemoveFromBucket(ByTag, Tag, BuffKey);
+	}
+}
+
+void FBuffLookupIndex::GetValidBuffs(const FBucket* Bucket, TArray<UBuff*>& OutBuffs)
+{
+	if (!Bucket)
+	{
+		return;
+	}
+	OutBuffs.Reserve(Bucket->Num());
+	for (const TObjectKey<UBuff>& Entry : *Bucket)
+	{
+		UBuff* Buff = Entry.ResolveObjectPtr();
+		if (IsValid(Buff))
+		{
+			OutBuffs.Add(Buff);
+		}
+	}
+}
+
+UBuff* FBuffLookupIndex::GetFirstValidBuff(const FBucket* Bucket)
+{
+	if (Bucket)
+	{
+		for (const TObjectKey<UBuff>& Entry : *Bucket)
+		{
+			UBuff* Buff = Entry.ResolveObjectPtr();
+			if (IsValid(Buff))
+			{
+				return Buff;
+			}
+		}
+	}
+	return nullptr;
+}
+
 #pragma endregion 
 #pragma region Get Buffs
 
@@ -297,13 +437,7 @@ void UBuffHandler::GetBuffsOfClass(const TSubclassOf<UBuff> BuffClass, TArray<UB
 	{
 		return;
 	}
-	for (UBuff* Buff : ActiveBuffs)
-	{
-		if (IsValid(Buff) && Buff->GetClass() == BuffClass)
-		{
-			OutBuffs.Add(Buff);
-		}
-	}
+	FBuffLookupIndex::GetValidBuffs(ActiveBuffIndex.FindByClass(BuffClass), OutBuffs);
 }
 
 void UBuffHandler::GetBuffsAppliedByActor(const AActor* Actor, TArray<UBuff*>& OutBuffs) const
@@ -313,13 +447,7 @@ void UBuffHandler::GetBuffsAppliedByActor(const AActor* Actor, TArray<UBuff*>& O
 	{
 		return;
 	}
-	for (UBuff* Buff : ActiveBuffs)
-	{
-		if (IsValid(Buff) && Buff->GetAppliedBy() == Actor)
-		{
-			OutBuffs.Add(Buff);
-		}
-	}
+	FBuffLookupIndex::GetValidBuffs(ActiveBuffIndex.FindByActor(Actor), OutBuffs);
 }
 
 UBuff* UBuffHandler::FindExistingBuff(const TSubclassOf<UBuff> BuffClass, const bool bSpecificOwner, const AActor* BuffOwner) const
@@ -328,14 +456,17 @@ UBuff* UBuffHandler::FindExistingBuff(const TSubclassOf<UBuff> BuffClass, const
 	{
 		return nullptr;
 	}
-	for (UBuff* Buff : ActiveBuffs)
+	return FBuffLookupIndex::GetFirstValidBuff(bSpecificOwner ? ActiveBuffIndex.FindByClassAndActor(BuffClass, BuffOwner) : ActiveBuffIndex.FindByClass(BuffClass));
+}
+
+void UBuffHandler::GetBuffsWithTag(const FGameplayTag Tag, TArray<UBuff*>& OutBuffs) const
+{
+	OutBuffs.Empty();
+	if (!Tag.IsValid())
 	{
-		if (IsValid(Buff) && Buff->GetClass() == BuffClass && (!bSpecificOwner || Buff->GetAppliedBy() == BuffOwner))
-		{
-			return Buff;
-		}
+		return;
 	}
-	return nullptr;
+	FBuffLookupIndex::GetValidBuffs(ActiveBuffIndex.FindByTag(Tag), OutBuffs);
 }
 
 void UBuffHandler::GetOutgoingBuffsOfClass(const TSubclassOf<UBuff> BuffClass, TArray<UBuff*>& OutBuffs) const
@@ -345,13 +476,7 @@ void UBuffHandler::GetOutgoingBuffsOfClass(const TSubclassOf<UBuff> BuffClass, T
 	{
 		return;
 	}
-	for (UBuff* Buff : OutgoingBuffs)
-	{
-		if (IsValid(Buff) && Buff->GetClass() == BuffClass)
-		{
-			OutBuffs.Add(Buff);
-		}
-	}
+	FBuffLookupIndex::GetValidBuffs(OutgoingBuffIndex.FindByClass(BuffClass), OutBuffs);
 }
 
 void UBuffHandler::GetBuffsAppliedToActor(const AActor* Target, TArray<UBuff*>& OutBuffs) const
@@ -361,13 +486,7 @@ void UBuffHandler::GetBuffsAppliedToActor(const AActor* Target, TArray<UBuff*>&
 	{
 		return;
 	}
-	for (UBuff* Buff : OutgoingBuffs)
-	{
-		if (IsValid(Buff) && Buff->GetAppliedTo() == Target)
-		{
-			OutBuffs.Add(Buff);
-		}
-	}
+	FBuffLookupIndex::GetValidBuffs(OutgoingBuffIndex.FindByActor(Target), OutBuffs);
 }
 
 UBuff* UBuffHandler::FindExistingOutgoingBuff(const TSubclassOf<UBuff> BuffClass, const bool bSpecificTarget,
@@ -377,14 +496,17 @@ UBuff* UBuffHandler::FindExistingOutgoingBuff(const TSubclassOf<UBuff> BuffClass
 	{
 		return nullptr;
 	}
-	for (UBuff* Buff : OutgoingBuffs)
+	return FBuffLookupIndex::GetFirstValidBuff(bSpecificTarget ? OutgoingBuffIndex.FindByClassAndActor(BuffClass, BuffTarget) : OutgoingBuffIndex.FindByClass(BuffClass));
+}
+
+void UBuffHandler::GetOutgoingBuffsWithTag(const FGameplayTag Tag, TArray<UBuff*>& OutBuffs) const
+{
+	OutBuffs.Empty();
+	if (!Tag.IsValid())
 	{
-		if (IsValid(Buff) && Buff->GetClass() == BuffClass && (!bSpecificTarget || Buff->GetAppliedTo() == BuffTarget))
-		{
-			return Buff;
-		}
+		return;
 	}
-	return nullptr;
+	FBuffLookupIndex::GetValidBuffs(OutgoingBuffIndex.FindByTag(Tag), OutBuffs);
 }
 
 #pragma endregion 
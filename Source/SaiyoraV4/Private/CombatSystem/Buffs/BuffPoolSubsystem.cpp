@@ -0,0 +1,44 @@
+#include "BuffPoolSubsystem.h"
+#include "Buff.h"
+
+UBuff* UBuffPoolSubsystem::AcquireBuff(AActor* AppliedTo, const TSubclassOf<UBuff> BuffClass)
+{
+	if (!IsValid(AppliedTo) || !IsValid(BuffClass))
+	{
+		return nullptr;
+	}
+	FBuffPool* Pool = Pools.Find(AppliedTo);
+	if (Pool)
+	{
+		for (int32 i = Pool->FreeBuffs.Num() - 1; i >= 0; i--)
+		{
+			UBuff* Buff = Pool->FreeBuffs[i];
+			if (IsValid(Buff) && Buff->GetClass() == BuffClass)
+			{
+				Pool->FreeBuffs.RemoveAtSwap(i);
+				return Buff;
+			}
+		}
+	}
+	return NewObject<UBuff>(AppliedTo, BuffClass);
+}
+
+void UBuffPoolSubsystem::ReleaseBuff(UBuff* Buff)
+{
+	if (!IsValid(Buff) || !Buff->IsPoolable())
+	{
+		return;
+	}
+	const AActor* Outer = Cast<AActor>(Buff->GetOuter());
+	if (!IsValid(Outer) || Outer->IsActorBeingDestroyed())
+	{
+		return;
+	}
+	FBuffPool& Pool = Pools.FindOrAdd(Outer);
+	if (Pool.FreeBuffs.Num() >= MaxPooledBuffsPerActor || Pool.FreeBuffs.Contains(Buff))
+	{
+		return;
+	}
+	Buff->ResetForReuse();
+	Pool.FreeBuffs.Add(Buff);
+}
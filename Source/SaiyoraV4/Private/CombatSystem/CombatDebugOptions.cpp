@@ -125,14 +125,14 @@ void UCombatDebugOptions::DrawRotationBehavior(const AActor* Actor, const FRotat
 	DrawDebugDirectionalArrow(Actor->GetWorld(), StartLoc, StartLoc + DebugInfo.FinalRotation.Vector() * 100.0f, 100.0f, FColor::Green);
 }
 
-void UCombatDebugOptions::DrawRewindHitbox(const UHitbox* Hitbox, const FTransform& PreviousTransform)
+void UCombatDebugOptions::DrawRewindHitbox(const UHitbox* Hitbox, const FTransform& RewoundTransform)
 {
 	if (!IsValid(Hitbox))
 	{
 		return;
 	}
-	DrawDebugBox(Hitbox->GetWorld(), Hitbox->GetComponentLocation(), Hitbox->GetScaledBoxExtent(), Hitbox->GetComponentQuat(), FColor::Blue, false, 5.0f, 0, 2);
-	DrawDebugBox(Hitbox->GetWorld(), PreviousTransform.GetLocation(), Hitbox->GetUnscaledBoxExtent() * PreviousTransform.GetScale3D(), PreviousTransform.GetRotation(), FColor::Green, false, 5.0f, 0, 2);
+	DrawDebugBox(Hitbox->GetWorld(), RewoundTransform.GetLocation(), Hitbox->GetUnscaledBoxExtent() * RewoundTransform.GetScale3D(), RewoundTransform.GetRotation(), FColor::Blue, false, 5.0f, 0, 2);
+	DrawDebugBox(Hitbox->GetWorld(), Hitbox->GetComponentLocation(), Hitbox->GetScaledBoxExtent(), Hitbox->GetComponentQuat(), FColor::Green, false, 5.0f, 0, 2);
 }
 
 void UCombatDebugOptions::DrawHiddenProjectile(const APredictableProjectile* Projectile)
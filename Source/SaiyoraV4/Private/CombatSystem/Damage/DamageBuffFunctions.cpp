@@ -130,12 +130,38 @@ TArray<FName> UPeriodicHealthEventFunction::GetHealthEventCallbackFunctionNames(
 void UHealthEventModifierFunction::SetupBuffFunction()
 {
 	TargetHandler = ISaiyoraCombatInterface::Execute_GetDamageHandler(GetOwningBuff()->GetAppliedTo());
-	Modifier.BindUFunction(GetOwningBuff(), ModifierFunctionName);
+	if (bIgnoresEventContext)
+	{
+		StaticModifier = FCombatModifier(StaticModifier.Value, StaticModifier.Type, GetOwningBuff(), StaticModifier.bStackable);
+	}
+	else
+	{
+		Modifier.BindUFunction(GetOwningBuff(), ModifierFunctionName);
+	}
 }
 
 void UHealthEventModifierFunction::OnApply(const FBuffApplyEvent& ApplyEvent)
 {
-	if (!IsValid(TargetHandler) || !Modifier.IsBound())
+	if (!IsValid(TargetHandler))
+	{
+		return;
+	}
+	if (bIgnoresEventContext)
+	{
+		switch (EventDirection)
+		{
+		case ECombatEventDirection::Incoming :
+			StaticModifierHandle = TargetHandler->AddStaticIncomingHealthEventModifier(StaticModifier);
+			break;
+		case ECombatEventDirection::Outgoing :
+			StaticModifierHandle = TargetHandler->AddStaticOutgoingHealthEventModifier(StaticModifier);
+			break;
+		default :
+			break;
+		}
+		return;
+	}
+	if (!Modifier.IsBound())
 	{
 		return;
 	}
@@ -152,9 +178,50 @@ void UHealthEventModifierFunction::OnApply(const FBuffApplyEvent& ApplyEvent)
 	}
 }
 
+void UHealthEventModifierFunction::OnChange(const FBuffApplyEvent& ApplyEvent)
+{
+	if (!IsValid(TargetHandler) || !bIgnoresEventContext)
+	{
+		return;
+	}
+	if (StaticModifier.bStackable && ApplyEvent.PreviousStacks != ApplyEvent.NewStacks)
+	{
+		switch (EventDirection)
+		{
+		case ECombatEventDirection::Incoming :
+			TargetHandler->UpdateStaticIncomingHealthEventModifier(StaticModifierHandle, StaticModifier);
+			break;
+		case ECombatEventDirection::Outgoing :
+			TargetHandler->UpdateStaticOutgoingHealthEventModifier(StaticModifierHandle, StaticModifier);
+			break;
+		default :
+			break;
+		}
+	}
+}
+
 void UHealthEventModifierFunction::OnRemove(const FBuffRemoveEvent& RemoveEvent)
 {
-	if (!IsValid(TargetHandler) || !Modifier.IsBound())
+	if (!IsValid(TargetHandler))
+	{
+		return;
+	}
+	if (bIgnoresEventContext)
+	{
+		switch (EventDirection)
+		{
+		case ECombatEventDirection::Incoming :
+			TargetHandler->RemoveStaticIncomingHealthEventModifier(StaticModifierHandle);
+			break;
+		case ECombatEventDirection::Outgoing :
+			TargetHandler->RemoveStaticOutgoingHealthEventModifier(StaticModifierHandle);
+			break;
+		default :
+			break;
+		}
+		return;
+	}
+	if (!Modifier.IsBound())
 	{
 		return;
 	}
@@ -5,6 +5,7 @@
 #include "BuffHandler.h"
 #include "StatHandler.h"
 #include "CombatStatusComponent.h"
+#include "CombatEventSubsystem.h"
 #include "DamageBuffFunctions.h"
 #include "SaiyoraCombatInterface.h"
 #include "DungeonGameState.h"
@@ -30,6 +31,7 @@ void UDamageHandler::InitializeComponent()
 	}
 	
 	checkf(GetOwner()->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()), TEXT("Owner does not implement combat interface, but has Damage Handler."));
+	CombatEventBus = GetWorld()->GetSubsystem<UCombatEventSubsystem>();
 	if (GetOwnerRole() == ROLE_Authority)
 	{
 		StatHandlerRef = ISaiyoraCombatInterface::Execute_GetStatHandler(GetOwner());
@@ -135,14 +137,17 @@ void UDamageHandler::UpdateMaxHealth(const float NewMaxHealth)
 		if (CurrentHealth != PreviousHealth)
 		{
 			OnHealthChanged.Broadcast(GetOwner(), PreviousHealth, CurrentHealth);
+			QueueHealthChange();
 		}
 		const float PreviousAbsorb = CurrentAbsorb;
 		CurrentAbsorb = FMath::Clamp(CurrentAbsorb, 0.0f, MaxHealth);
 		if (CurrentAbsorb != PreviousAbsorb)
 		{
 			OnAbsorbChanged.Broadcast(GetOwner(), PreviousAbsorb, CurrentAbsorb);
+			QueueHealthChange();
 		}
 		OnMaxHealthChanged.Broadcast(GetOwner(), PreviousMaxHealth, MaxHealth);
+		QueueHealthChange();
 	}
 }
 
@@ -154,19 +159,30 @@ void UDamageHandler::ReactToMaxHealthStat(const FGameplayTag StatTag, const floa
 	}
 }
 
+void UDamageHandler::QueueHealthChange()
+{
+	if (IsValid(CombatEventBus))
+	{
+		CombatEventBus->QueueHealthChange(this);
+	}
+}
+
 void UDamageHandler::OnRep_CurrentHealth(const float PreviousValue)
 {
 	OnHealthChanged.Broadcast(GetOwner(), PreviousValue, CurrentHealth);
+	QueueHealthChange();
 }
 
 void UDamageHandler::OnRep_MaxHealth(const float PreviousValue)
 {
 	OnMaxHealthChanged.Broadcast(GetOwner(), PreviousValue, MaxHealth);
+	QueueHealthChange();
 }
 
 void UDamageHandler::OnRep_CurrentAbsorb(const float PreviousValue)
 {
 	OnAbsorbChanged.Broadcast(GetOwner(), PreviousValue, CurrentAbsorb);	
+	QueueHealthChange();
 }
 
 #pragma endregion
@@ -185,12 +201,14 @@ void UDamageHandler::Die()
 		const float PreviousAbsorb = CurrentAbsorb;
 		CurrentAbsorb = 0.0f;
 		OnAbsorbChanged.Broadcast(GetOwner(), PreviousAbsorb, CurrentAbsorb);
+		QueueHealthChange();
 	}
 	if (CurrentHealth != 0.0f)
 	{
 		const float PreviousHealth = CurrentHealth;
 		CurrentHealth = 0.0f;
 		OnHealthChanged.Broadcast(GetOwner(), PreviousHealth, CurrentHealth);
+		QueueHealthChange();
 	}
 	const ELifeStatus PreviousStatus = LifeStatus;
 	LifeStatus = ELifeStatus::Dead;
@@ -233,8 +251,10 @@ void UDamageHandler::RespawnActor(const bool bForceRespawnLocation, const FVecto
 		const float PreviousAbsorb = CurrentAbsorb;
 		CurrentAbsorb = 0.0f;
 		OnAbsorbChanged.Broadcast(GetOwner(), PreviousAbsorb, CurrentAbsorb);
+		QueueHealthChange();
 	}
 	OnHealthChanged.Broadcast(GetOwner(), 0.0f, CurrentHealth);
+	QueueHealthChange();
 	const ELifeStatus PreviousStatus = LifeStatus;
 	LifeStatus = ELifeStatus::Alive;
 	OnLifeStatusChanged.Broadcast(GetOwner(), PreviousStatus, ELifeStatus::Alive);
@@ -427,16 +447,138 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
                                               UObject* Source, const EEventHitStyle HitStyle, const EElementalSchool School, const bool bBypassAbsorbs,
                                               const bool bIgnoreModifiers, const bool bIgnoreRestrictions, const bool bIgnoreDeathRestrictions, const bool bFromSnapshot, const FHealthEventModCondition& SourceModifier, const FThreatFromDamage& ThreatParams)
 {
-    FHealthEvent HealthEvent;
     if (GetOwnerRole() != ROLE_Authority || !IsValid(AppliedBy) || !IsValid(Source))
     {
-        return HealthEvent;
+        return FHealthEvent();
     }
-    if (!bHasHealth || IsDead() || EventType == EHealthEventType::None || Amount < 0.0f)
+	FHealthEventSource EventSource;
+	EventSource.EventType = EventType;
+	EventSource.Amount = Amount;
+	EventSource.AppliedBy = AppliedBy;
+	EventSource.Source = Source;
+	EventSource.HitStyle = HitStyle;
+	EventSource.School = School;
+	EventSource.bBypassAbsorbs = bBypassAbsorbs;
+	EventSource.bIgnoreModifiers = bIgnoreModifiers;
+	EventSource.bIgnoreRestrictions = bIgnoreRestrictions;
+	EventSource.bIgnoreDeathRestrictions = bIgnoreDeathRestrictions;
+	EventSource.bFromSnapshot = bFromSnapshot;
+	EventSource.SourceModifier = SourceModifier;
+	EventSource.ThreatParams = ThreatParams;
+
+	ESaiyoraPlane AppliedByPlane = ESaiyoraPlane::Both;
+	UDamageHandler* GeneratorComponent = GetHealthEventGenerator(AppliedBy, AppliedByPlane);
+	TArray<FCombatModifier> OutgoingStatMods;
+	if (!bIgnoreModifiers && !bFromSnapshot && IsValid(GeneratorComponent))
+	{
+		GeneratorComponent->GetOutgoingHealthEventStatModifiers(EventType, OutgoingStatMods);
+	}
+	
+	const FHealthEvent HealthEvent = ApplyHealthEventInternal(EventSource, AppliedByPlane, GeneratorComponent, OutgoingStatMods);
+	if (HealthEvent.Result.Success && IsValid(GeneratorComponent))
+	{
+		GeneratorComponent->NotifyOfOutgoingHealthEvent(HealthEvent);
+	}
+	if (HealthEvent.Result.KillingBlow)
+	{
+		Die();
+	}
+	
+	return HealthEvent;
+}
+
+TArray<FHealthEvent> UDamageHandler::ApplyHealthEventBatch(const FHealthEventSource& EventSource, const TArray<AActor*>& Targets)
+{
+	TArray<FHealthEvent> HealthEvents;
+	if (!IsValid(EventSource.AppliedBy) || !IsValid(EventSource.Source) || EventSource.AppliedBy->GetLocalRole() != ROLE_Authority)
+	{
+		return HealthEvents;
+	}
+	HealthEvents.SetNum(Targets.Num());
+	
+	ESaiyoraPlane AppliedByPlane = ESaiyoraPlane::Both;
+	UDamageHandler* GeneratorComponent = GetHealthEventGenerator(EventSource.AppliedBy, AppliedByPlane);
+	TArray<FCombatModifier> OutgoingStatMods;
+	if (!EventSource.bIgnoreModifiers && !EventSource.bFromSnapshot && IsValid(GeneratorComponent))
+	{
+		GeneratorComponent->GetOutgoingHealthEventStatModifiers(EventSource.EventType, OutgoingStatMods);
+	}
+
+	TArray<FHealthEvent> SuccessfulEvents;
+	//Deaths are held until the attacker has been notified, matching the order single target events use.
+	TArray<UDamageHandler*> KilledHandlers;
+	//A target listed more than once only takes the event once. Later duplicates are left as failed events.
+	TSet<const AActor*> AppliedTargets;
+	AppliedTargets.Reserve(Targets.Num());
+	for (int32 i = 0; i < Targets.Num(); ++i)
+	{
+		AActor* Target = Targets[i];
+		if (!IsValid(Target) || !Target->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()))
+		{
+			continue;
+		}
+		bool bAlreadyApplied = false;
+		AppliedTargets.Add(Target, &bAlreadyApplied);
+		if (bAlreadyApplied)
+		{
+			continue;
+		}
+		UDamageHandler* TargetComponent = ISaiyoraCombatInterface::Execute_GetDamageHandler(Target);
+		if (!IsValid(TargetComponent))
+		{
+			continue;
+		}
+		HealthEvents[i] = TargetComponent->ApplyHealthEventInternal(EventSource, AppliedByPlane, GeneratorComponent, OutgoingStatMods);
+		if (HealthEvents[i].Result.Success)
+		{
+			SuccessfulEvents.Add(HealthEvents[i]);
+			if (HealthEvents[i].Result.KillingBlow)
+			{
+				KilledHandlers.Add(TargetComponent);
+			}
+		}
+	}
+	
+	if (SuccessfulEvents.Num() > 0 && IsValid(GeneratorComponent))
+	{
+		GeneratorComponent->NotifyOfOutgoingHealthEventBatch(SuccessfulEvents);
+	}
+	for (UDamageHandler* KilledHandler : KilledHandlers)
+	{
+		KilledHandler->Die();
+	}
+	
+	return HealthEvents;
+}
+
+UDamageHandler* UDamageHandler::GetHealthEventGenerator(AActor* AppliedBy, ESaiyoraPlane& OutAppliedByPlane)
+{
+	OutAppliedByPlane = ESaiyoraPlane::Both;
+	if (!IsValid(AppliedBy) || !AppliedBy->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()))
+	{
+		return nullptr;
+	}
+	const UCombatStatusComponent* AppliedByCombatStatusComp = ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(AppliedBy);
+	if (IsValid(AppliedByCombatStatusComp))
+	{
+		OutAppliedByPlane = AppliedByCombatStatusComp->GetCurrentPlane();
+	}
+	return ISaiyoraCombatInterface::Execute_GetDamageHandler(AppliedBy);
+}
+
+FHealthEvent UDamageHandler::ApplyHealthEventInternal(const FHealthEventSource& EventSource, const ESaiyoraPlane AppliedByPlane, UDamageHandler* GeneratorComponent,
+	const TArray<FCombatModifier>& OutgoingStatModifiers)
+{
+	FHealthEvent HealthEvent;
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return HealthEvent;
+	}
+    if (!bHasHealth || IsDead() || EventSource.EventType == EHealthEventType::None || EventSource.Amount < 0.0f)
     {
         return HealthEvent;
     }
-	switch (EventType)
+	switch (EventSource.EventType)
 	{
     case EHealthEventType::Damage :
     	if (!bCanEverReceiveDamage) return HealthEvent;
@@ -450,57 +592,47 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
     default :
     	return HealthEvent;
 	}
-	HealthEvent.Info.EventType = EventType;
-    HealthEvent.Info.Value = Amount;
-    HealthEvent.Info.SnapshotValue = Amount;
-    HealthEvent.Info.AppliedBy = AppliedBy;
+	HealthEvent.Info.EventType = EventSource.EventType;
+    HealthEvent.Info.Value = EventSource.Amount;
+    HealthEvent.Info.SnapshotValue = EventSource.Amount;
+    HealthEvent.Info.AppliedBy = EventSource.AppliedBy;
     HealthEvent.Info.AppliedTo = GetOwner();
-    HealthEvent.Info.Source = Source;
-    HealthEvent.Info.HitStyle = HitStyle;
-    HealthEvent.Info.School = School;
-	if (HealthEvent.Info.AppliedBy->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()))
-	{
-		const UCombatStatusComponent* AppliedByCombatStatusComp = ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(HealthEvent.Info.AppliedBy);
-		HealthEvent.Info.AppliedByPlane = IsValid(AppliedByCombatStatusComp) ? AppliedByCombatStatusComp->GetCurrentPlane() : ESaiyoraPlane::Both;
-	}
-	else
-	{
-		HealthEvent.Info.AppliedByPlane = ESaiyoraPlane::Both;
-	}
+    HealthEvent.Info.Source = EventSource.Source;
+    HealthEvent.Info.HitStyle = EventSource.HitStyle;
+    HealthEvent.Info.School = EventSource.School;
+	HealthEvent.Info.AppliedByPlane = AppliedByPlane;
     HealthEvent.Info.AppliedToPlane = IsValid(CombatStatusComponentRef) ? CombatStatusComponentRef->GetCurrentPlane() : ESaiyoraPlane::Both;
     HealthEvent.Info.AppliedXPlane = UAbilityFunctionLibrary::IsXPlane(HealthEvent.Info.AppliedByPlane, HealthEvent.Info.AppliedToPlane);
-	if (ThreatParams.bGeneratesThreat)
+	if (EventSource.ThreatParams.bGeneratesThreat)
 	{
-		HealthEvent.ThreatInfo = ThreatParams;
-		if (!ThreatParams.bSeparateBaseThreat)
+		HealthEvent.ThreatInfo = EventSource.ThreatParams;
+		if (!EventSource.ThreatParams.bSeparateBaseThreat)
 		{
 			HealthEvent.ThreatInfo.BaseThreat = HealthEvent.Info.Value;
 		}
 	}
-
-	UDamageHandler* GeneratorComponent = AppliedBy->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()) ?
-		ISaiyoraCombatInterface::Execute_GetDamageHandler(AppliedBy) : nullptr;
 	
-    if (!bIgnoreModifiers)
+    if (!EventSource.bIgnoreModifiers)
     {
-        if (!bFromSnapshot && IsValid(GeneratorComponent))
+    	//Conditional outgoing modifiers and the source modifier can inspect the target, so only the stat modifiers are shared across a batch.
+        if (!EventSource.bFromSnapshot && IsValid(GeneratorComponent))
         {
-            HealthEvent.Info.Value = GeneratorComponent->GetModifiedOutgoingHealthEventValue(HealthEvent.Info, SourceModifier);
+            HealthEvent.Info.Value = GeneratorComponent->GetModifiedOutgoingHealthEventValue(HealthEvent.Info, EventSource.SourceModifier, OutgoingStatModifiers);
             HealthEvent.Info.SnapshotValue = HealthEvent.Info.Value;
         }
         HealthEvent.Info.Value = GetModifiedIncomingHealthEventValue(HealthEvent.Info);
     }
-    if (!bIgnoreRestrictions && (IncomingHealthEventRestrictions.IsRestricted(HealthEvent.Info) || (IsValid(GeneratorComponent) && GeneratorComponent->CheckOutgoingHealthEventRestricted(HealthEvent.Info))))
+    if (!EventSource.bIgnoreRestrictions && (IncomingHealthEventRestrictions.IsRestricted(HealthEvent.Info) || (IsValid(GeneratorComponent) && GeneratorComponent->CheckOutgoingHealthEventRestricted(HealthEvent.Info))))
     {
         return HealthEvent;
     }
 
 	HealthEvent.Result.Success = true;
-	if (EventType == EHealthEventType::Damage)
+	if (EventSource.EventType == EHealthEventType::Damage)
 	{
 		HealthEvent.Result.PreviousValue = CurrentHealth;
 		float RemainingDamage = HealthEvent.Info.Value;
-		if (!bBypassAbsorbs)
+		if (!EventSource.bBypassAbsorbs)
 		{
 			if (CurrentAbsorb >= RemainingDamage)
 			{
@@ -510,6 +642,7 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
 				if (PreviousAbsorb != CurrentAbsorb)
 				{
 					OnAbsorbChanged.Broadcast(GetOwner(), PreviousAbsorb, CurrentAbsorb);
+					QueueHealthChange();
 				}
 			}
 			else
@@ -520,6 +653,7 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
 				if (PreviousAbsorb != CurrentAbsorb)
 				{
 					OnAbsorbChanged.Broadcast(GetOwner(), PreviousAbsorb, CurrentAbsorb);
+					QueueHealthChange();
 				}
 			}
 		}
@@ -527,12 +661,13 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
 		if (CurrentHealth != HealthEvent.Result.PreviousValue)
 		{
 			OnHealthChanged.Broadcast(GetOwner(), HealthEvent.Result.PreviousValue, CurrentHealth);
+			QueueHealthChange();
 		}
 		HealthEvent.Result.NewValue = CurrentHealth;
 		HealthEvent.Result.AppliedValue = HealthEvent.Result.PreviousValue - CurrentHealth;
 		if (CurrentHealth == 0.0f)
 		{
-			if (bIgnoreDeathRestrictions || !DeathRestrictions.IsRestricted(HealthEvent))
+			if (EventSource.bIgnoreDeathRestrictions || !DeathRestrictions.IsRestricted(HealthEvent))
 			{
 				HealthEvent.Result.KillingBlow = true;
 			}
@@ -543,13 +678,14 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
 			}
 		}
 	}
-	else if (EventType == EHealthEventType::Healing)
+	else if (EventSource.EventType == EHealthEventType::Healing)
 	{
 		HealthEvent.Result.PreviousValue = CurrentHealth;
 		CurrentHealth = FMath::Clamp(CurrentHealth + HealthEvent.Info.Value, 0.0f, MaxHealth);
 		if (CurrentHealth != HealthEvent.Result.PreviousValue)
 		{
 			OnHealthChanged.Broadcast(GetOwner(), HealthEvent.Result.PreviousValue, CurrentHealth);
+			QueueHealthChange();
 		}
 		HealthEvent.Result.NewValue = CurrentHealth;
 		HealthEvent.Result.AppliedValue = CurrentHealth - HealthEvent.Result.PreviousValue;
@@ -559,30 +695,27 @@ FHealthEvent UDamageHandler::ApplyHealthEvent(const EHealthEventType EventType,
 			PendingKillingBlow = FHealthEvent();
 		}
 	}
-	else if (EventType == EHealthEventType::Absorb)
+	else if (EventSource.EventType == EHealthEventType::Absorb)
 	{
 		HealthEvent.Result.PreviousValue = CurrentAbsorb;
 		CurrentAbsorb = FMath::Clamp(CurrentAbsorb + HealthEvent.Info.Value, 0.0f, MaxHealth);
 		if (CurrentAbsorb != HealthEvent.Result.PreviousValue)
 		{
 			OnAbsorbChanged.Broadcast(GetOwner(), HealthEvent.Result.PreviousValue, CurrentAbsorb);
+			QueueHealthChange();
 		}
 		HealthEvent.Result.NewValue = CurrentAbsorb;
 		HealthEvent.Result.AppliedValue = CurrentAbsorb - HealthEvent.Result.PreviousValue;
 	}
 	
 	OnIncomingHealthEvent.Broadcast(HealthEvent);
-	if (IsValid(OwnerAsPawn) && !OwnerAsPawn->IsLocallyControlled())
+	if (IsValid(CombatEventBus))
 	{
-		ClientNotifyOfIncomingHealthEvent(HealthEvent);
-	}
-	if (IsValid(GeneratorComponent))
-	{
-		GeneratorComponent->NotifyOfOutgoingHealthEvent(HealthEvent);
+		CombatEventBus->QueueHealthEvent(HealthEvent);
 	}
-	if (HealthEvent.Result.KillingBlow)
+	if (IsValid(OwnerAsPawn) && !OwnerAsPawn->IsLocallyControlled())
 	{
-		Die();
+		ClientNotifyOfIncomingHealthEvent(HealthEvent);
 	}
 	
 	return HealthEvent;
@@ -597,6 +730,10 @@ void UDamageHandler::NotifyOfOutgoingHealthEvent(const FHealthEvent& HealthEvent
 		{
 			OnKillingBlow.Broadcast(HealthEvent);
 		}
+		if (OnOutgoingHealthEventBatch.IsBound())
+		{
+			OnOutgoingHealthEventBatch.Broadcast(TArray<FHealthEvent>({ HealthEvent }));
+		}
 		if (IsValid(OwnerAsPawn) && !OwnerAsPawn->IsLocallyControlled())
 		{
 			ClientNotifyOfOutgoingHealthEvent(HealthEvent);
@@ -604,6 +741,32 @@ void UDamageHandler::NotifyOfOutgoingHealthEvent(const FHealthEvent& HealthEvent
 	}
 }
 
+void UDamageHandler::NotifyOfOutgoingHealthEventBatch(const TArray<FHealthEvent>& HealthEvents)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		BroadcastOutgoingHealthEvents(HealthEvents);
+		if (IsValid(OwnerAsPawn) && !OwnerAsPawn->IsLocallyControlled())
+		{
+			ClientNotifyOfOutgoingHealthEventBatch(HealthEvents);
+		}
+	}
+}
+
+void UDamageHandler::BroadcastOutgoingHealthEvents(const TArray<FHealthEvent>& HealthEvents)
+{
+	//Per-event delegates still fire for listeners like combat groups that only care about individual events.
+	for (const FHealthEvent& HealthEvent : HealthEvents)
+	{
+		OnOutgoingHealthEvent.Broadcast(HealthEvent);
+		if (HealthEvent.Result.KillingBlow)
+		{
+			OnKillingBlow.Broadcast(HealthEvent);
+		}
+	}
+	OnOutgoingHealthEventBatch.Broadcast(HealthEvents);
+}
+
 void UDamageHandler::ClientNotifyOfOutgoingHealthEvent_Implementation(const FHealthEvent& HealthEvent)
 {
 	OnOutgoingHealthEvent.Broadcast(HealthEvent);
@@ -611,11 +774,24 @@ void UDamageHandler::ClientNotifyOfOutgoingHealthEvent_Implementation(const FHea
 	{
 		OnKillingBlow.Broadcast(HealthEvent);
 	}
+	if (OnOutgoingHealthEventBatch.IsBound())
+	{
+		OnOutgoingHealthEventBatch.Broadcast(TArray<FHealthEvent>({ HealthEvent }));
+	}
+}
+
+void UDamageHandler::ClientNotifyOfOutgoingHealthEventBatch_Implementation(const TArray<FHealthEvent>& HealthEvents)
+{
+	BroadcastOutgoingHealthEvents(HealthEvents);
 }
 
 void UDamageHandler::ClientNotifyOfIncomingHealthEvent_Implementation(const FHealthEvent& HealthEvent)
 {
 	OnIncomingHealthEvent.Broadcast(HealthEvent);
+	if (IsValid(CombatEventBus))
+	{
+		CombatEventBus->QueueHealthEvent(HealthEvent);
+	}
 }
 
 #pragma endregion
@@ -636,46 +812,57 @@ void UDamageHandler::RemoveDeathRestriction(const FDeathRestriction& Restriction
 #pragma region Modifiers
 
 float UDamageHandler::GetModifiedOutgoingHealthEventValue(const FHealthEventInfo& EventInfo, const FHealthEventModCondition& SourceMod) const
+{
+	TArray<FCombatModifier> StatMods;
+	GetOutgoingHealthEventStatModifiers(EventInfo.EventType, StatMods);
+	return GetModifiedOutgoingHealthEventValue(EventInfo, SourceMod, StatMods);
+}
+
+float UDamageHandler::GetModifiedOutgoingHealthEventValue(const FHealthEventInfo& EventInfo, const FHealthEventModCondition& SourceMod, const TArray<FCombatModifier>& StatModifiers) const
 {
 	TArray<FCombatModifier> Mods;
-	OutgoingHealthEventModifiers.GetModifiers(Mods, EventInfo);
+	Mods.Reserve(StatModifiers.Num() + 1);
 	if (SourceMod.IsBound())
 	{
 		Mods.Add(SourceMod.Execute(EventInfo));
 	}
+	Mods.Append(StatModifiers);
+	return OutgoingHealthEventModifiers.GetModifiedValue(EventInfo.Value, Mods, EventInfo);
+}
+
+void UDamageHandler::GetOutgoingHealthEventStatModifiers(const EHealthEventType EventType, TArray<FCombatModifier>& OutModifiers) const
+{
 	if (IsValid(StatHandlerRef))
 	{
-		switch (EventInfo.EventType)
+		switch (EventType)
 		{
 		case EHealthEventType::Damage :
 			if (StatHandlerRef->IsStatValid(FSaiyoraCombatTags::Get().Stat_DamageDone))
 			{
-				Mods.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_DamageDone), EModifierType::Multiplicative));
+				OutModifiers.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_DamageDone), EModifierType::Multiplicative));
 			}
 			break;
 		case EHealthEventType::Healing :
 			if (StatHandlerRef->IsStatValid(FSaiyoraCombatTags::Get().Stat_HealingDone))
 			{
-				Mods.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_HealingDone), EModifierType::Multiplicative));
+				OutModifiers.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_HealingDone), EModifierType::Multiplicative));
 			}
 			break;
 		case EHealthEventType::Absorb :
 			if (StatHandlerRef->IsStatValid(FSaiyoraCombatTags::Get().Stat_AbsorbDone))
 			{
-				Mods.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_AbsorbDone), EModifierType::Multiplicative));
+				OutModifiers.Add(FCombatModifier(StatHandlerRef->GetStatValue(FSaiyoraCombatTags::Get().Stat_AbsorbDone), EModifierType::Multiplicative));
 			}
 			break;
 		default :
 			break;
 		}
 	}
-	return FCombatModifier::ApplyModifiers(Mods, EventInfo.Value);
 }
 
 float UDamageHandler::GetModifiedIncomingHealthEventValue(const FHealthEventInfo& EventInfo) const
 {
 	TArray<FCombatModifier> Mods;
-	IncomingHealthEventModifiers.GetModifiers(Mods, EventInfo);
 	if (IsValid(StatHandlerRef))
 	{
 		switch (EventInfo.EventType)
@@ -702,7 +889,7 @@ float UDamageHandler::GetModifiedIncomingHealthEventValue(const FHealthEventInfo
 			break;
 		}
 	}
-	return FCombatModifier::ApplyModifiers(Mods, EventInfo.Value);
+	return IncomingHealthEventModifiers.GetModifiedValue(EventInfo.Value, Mods, EventInfo);
 }
 
 #pragma endregion
\ No newline at end of file
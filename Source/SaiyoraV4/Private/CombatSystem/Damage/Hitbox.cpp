@@ -1,9 +1,11 @@
 #include "CombatSystem/Damage/Hitbox.h"
 #include "AbilityComponent.h"
+#include "CombatantRegistrySubsystem.h"
 #include "CombatNetSubsystem.h"
 #include "SaiyoraCombatInterface.h"
 #include "CoreClasses/SaiyoraGameState.h"
 #include "CombatStatusComponent.h"
+#include "DamageHandler.h"
 #include "NPCAbilityComponent.h"
 
 UHitbox::UHitbox()
@@ -25,6 +27,7 @@ void UHitbox::InitializeComponent()
 	if (GetOwner()->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()))
 	{
 		CombatStatusComponentRef = ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(GetOwner());
+		DamageHandlerRef = ISaiyoraCombatInterface::Execute_GetDamageHandler(GetOwner());
 		UAbilityComponent* AbilityCompRef = ISaiyoraCombatInterface::Execute_GetAbilityComponent(GetOwner());
 		if (IsValid(AbilityCompRef))
 		{
@@ -46,6 +49,13 @@ void UHitbox::BeginPlay()
 	{
 		UpdateFactionCollision(CombatStatusComponentRef->GetCurrentFaction());
 	}
+
+	//Hitboxes on actors that aren't combatants have no faction or plane to be bucketed by, so radius queries never return them.
+	UCombatantRegistrySubsystem* CombatantRegistry = GetWorld()->GetSubsystem<UCombatantRegistrySubsystem>();
+	if (IsValid(CombatantRegistry) && IsValid(CombatStatusComponentRef))
+	{
+		CombatantRegistry->RegisterHitbox(this);
+	}
 	
 	if (GetOwnerRole() == ROLE_Authority)
 	{
@@ -57,6 +67,30 @@ void UHitbox::BeginPlay()
 	}
 }
 
+void UHitbox::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UCombatantRegistrySubsystem* CombatantRegistry = GetWorld()->GetSubsystem<UCombatantRegistrySubsystem>();
+	if (IsValid(CombatantRegistry))
+	{
+		CombatantRegistry->UnregisterHitbox(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UHitbox::IsActiveNPCHitbox() const
+{
+	if (!IsValid(NPCComponentRef))
+	{
+		return false;
+	}
+	const ENPCCombatBehavior Behavior = NPCComponentRef->GetCombatBehavior();
+	if (Behavior != ENPCCombatBehavior::Patrolling && Behavior != ENPCCombatBehavior::Combat)
+	{
+		return false;
+	}
+	return !IsValid(DamageHandlerRef) || !DamageHandlerRef->IsDead();
+}
+
 void UHitbox::UpdateFactionCollision(const EFaction NewFaction)
 {
 	switch (NewFaction)
@@ -0,0 +1,50 @@
+﻿#include "CombatEventSubsystem.h"
+#include "DamageHandler.h"
+
+TStatId UCombatEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatEventSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatEventSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (HealthChanges.Num() > 0)
+	{
+		for (const TWeakObjectPtr<UDamageHandler>& Handler : HealthChanges)
+		{
+			if (Handler.IsValid())
+			{
+				DispatchingHealthChanges.Add(Handler.Get());
+			}
+		}
+		HealthChanges.Reset();
+		OnHealthChanges.Broadcast(DispatchingHealthChanges);
+		DispatchingHealthChanges.Reset();
+	}
+	if (HealthEvents.Num() > 0)
+	{
+		Swap(HealthEvents, DispatchingHealthEvents);
+		OnHealthEvents.Broadcast(DispatchingHealthEvents);
+		DispatchingHealthEvents.Reset();
+	}
+	if (ThreatEvents.Num() > 0)
+	{
+		Swap(ThreatEvents, DispatchingThreatEvents);
+		OnThreatEvents.Broadcast(DispatchingThreatEvents);
+		DispatchingThreatEvents.Reset();
+	}
+	if (BuffApplyEvents.Num() > 0)
+	{
+		Swap(BuffApplyEvents, DispatchingBuffApplyEvents);
+		OnBuffApplyEvents.Broadcast(DispatchingBuffApplyEvents);
+		DispatchingBuffApplyEvents.Reset();
+	}
+	if (BuffRemoveEvents.Num() > 0)
+	{
+		Swap(BuffRemoveEvents, DispatchingBuffRemoveEvents);
+		OnBuffRemoveEvents.Broadcast(DispatchingBuffRemoveEvents);
+		DispatchingBuffRemoveEvents.Reset();
+	}
+}
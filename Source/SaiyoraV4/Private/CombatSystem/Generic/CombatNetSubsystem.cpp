@@ -5,6 +5,164 @@
 #include "SaiyoraGameInstance.h"
 #include "SaiyoraPlayerCharacter.h"
 
+static TAutoConsoleVariable<float> HitboxSnapshotRelevanceDistance(
+		TEXT("game.HitboxSnapshotRelevanceDistance"),
+		6000.0f,
+		TEXT("NPC hitboxes further than this from every player's camera are not snapshotted for rewinding. 0 disables the distance check."),
+		ECVF_Default);
+
+static TAutoConsoleVariable<int32> LogShotValidationStats(
+		TEXT("game.LogShotValidationStats"),
+		0,
+		TEXT("Logs the server's shot validation counters (validated, rejected, rewind batches, average rewind depth) for every frame that validated shots."),
+		ECVF_Default);
+
+#pragma region Structs
+
+void FRewindRecord::AddSnapshot(const float Timestamp, const FTransform& Transform)
+{
+	int32 Slot;
+	if (Count < Capacity)
+	{
+		Slot = GetSlot(Count);
+		Count++;
+	}
+	else
+	{
+		//Overwrite the oldest snapshot and advance the head to the next oldest.
+		Slot = Head;
+		Head = (Head + 1) % Capacity;
+	}
+	Timestamps[Slot] = Timestamp;
+	Locations[Slot] = Transform.GetLocation();
+	Rotations[Slot] = Transform.GetRotation();
+	Scales[Slot] = Transform.GetScale3D();
+}
+
+FTransform FRewindRecord::GetTransform(const int32 Index) const
+{
+	const int32 Slot = GetSlot(Index);
+	return FTransform(Rotations[Slot], Locations[Slot], Scales[Slot]);
+}
+
+int32 FRewindRecord::FindFirstSnapshotAfter(const float Timestamp) const
+{
+	int32 Low = 0;
+	int32 High = Count;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (Timestamps[GetSlot(Mid)] < Timestamp)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low;
+}
+
+void FRewindRecord::MarkStatic(const float Timestamp, const FTransform& Transform)
+{
+	AddSnapshot(Timestamp, Transform);
+	bStatic = true;
+	StaticSince = Timestamp;
+}
+
+void FRewindRecord::ClearStatic()
+{
+	Head = 0;
+	Count = 0;
+	bStatic = false;
+	StaticSince = 0.0f;
+}
+
+void FHitboxRewindQuery::AddHitbox(UHitbox* Hitbox, const FTransform& RewoundTransform)
+{
+	if (!IsValid(Hitbox))
+	{
+		return;
+	}
+	FRewoundBox& Box = Boxes.AddDefaulted_GetRef();
+	Box.Hitbox = Hitbox;
+	Box.Owner = Hitbox->GetOwner();
+	Box.Center = RewoundTransform.GetLocation();
+	Box.Rotation = RewoundTransform.GetRotation();
+	Box.Extent = Hitbox->GetUnscaledBoxExtent() * RewoundTransform.GetScale3D().GetAbs();
+}
+
+void FHitboxRewindQuery::Sweep(const FVector& Start, const FVector& End, const float Radius, const TArray<AActor*>& ActorsToIgnore, TArray<FHitResult>& OutHits) const
+{
+	const FVector Delta = End - Start;
+	for (const FRewoundBox& Box : Boxes)
+	{
+		if (!IsValid(Box.Hitbox) || ActorsToIgnore.Contains(Box.Owner))
+		{
+			continue;
+		}
+		//Move the sweep into the box's local space, so that it can be tested against an axis-aligned box.
+		const FVector LocalStart = Box.Rotation.UnrotateVector(Start - Box.Center);
+		const FVector LocalDelta = Box.Rotation.UnrotateVector(Delta);
+		const FVector InflatedExtent = Box.Extent + FVector(FMath::Max(Radius, 0.0f));
+		//Slab test: find the portion of the sweep that is inside the box on every axis.
+		double EntryTime = 0.0;
+		double ExitTime = 1.0;
+		bool bMissed = false;
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			if (FMath::IsNearlyZero(LocalDelta[Axis]))
+			{
+				if (FMath::Abs(LocalStart[Axis]) > InflatedExtent[Axis])
+				{
+					bMissed = true;
+					break;
+				}
+				continue;
+			}
+			double SlabEntry = (-InflatedExtent[Axis] - LocalStart[Axis]) / LocalDelta[Axis];
+			double SlabExit = (InflatedExtent[Axis] - LocalStart[Axis]) / LocalDelta[Axis];
+			if (SlabEntry > SlabExit)
+			{
+				Swap(SlabEntry, SlabExit);
+			}
+			EntryTime = FMath::Max(EntryTime, SlabEntry);
+			ExitTime = FMath::Min(ExitTime, SlabExit);
+			if (EntryTime > ExitTime)
+			{
+				bMissed = true;
+				break;
+			}
+		}
+		if (bMissed)
+		{
+			continue;
+		}
+		const FVector TraceLocation = Start + Delta * EntryTime;
+		//The impact point is the closest point on the box to the sweep's position at the time of impact.
+		const FVector LocalImpact = (LocalStart + LocalDelta * EntryTime).BoundToBox(-Box.Extent, Box.Extent);
+		FHitResult& Hit = OutHits.Add_GetRef(FHitResult(Box.Owner, Box.Hitbox, TraceLocation, -Delta.GetSafeNormal()));
+		Hit.ImpactPoint = Box.Center + Box.Rotation.RotateVector(LocalImpact);
+		Hit.Time = EntryTime;
+		Hit.Distance = Delta.Size() * EntryTime;
+		Hit.TraceStart = Start;
+		Hit.TraceEnd = End;
+		Hit.bBlockingHit = true;
+		Hit.bStartPenetrating = EntryTime <= 0.0;
+	}
+	OutHits.Sort([](const FHitResult& A, const FHitResult& B) { return A.Time < B.Time; });
+}
+
+void FProjectilePredictionSlot::Reset(const int32 NewPredictionID)
+{
+	bInUse = true;
+	PredictionID = NewPredictionID;
+	TickIDCounters.Reset();
+	Projectiles.Reset();
+}
+
+#pragma endregion
 #pragma region Hitbox Rewinding
 
 void UCombatNetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
@@ -25,118 +183,249 @@ void UCombatNetSubsystem::RegisterNewHitbox(UHitbox* Hitbox)
         return;
     }
     Snapshots.Add(Hitbox);
+    MaxHitboxExtent = FMath::Max(MaxHitboxExtent, Hitbox->GetScaledBoxExtent().Size());
+    //New hitboxes are recorded until the next relevance update decides otherwise.
+    RelevantHitboxes.Add(Hitbox);
     if (Snapshots.Num() == 1)
     {
         GetWorld()->GetTimerManager().SetTimer(SnapshotHandle, this, &UCombatNetSubsystem::CreateSnapshot, SnapshotInterval, true);
+        GetWorld()->GetTimerManager().SetTimer(RelevanceHandle, this, &UCombatNetSubsystem::UpdateSnapshotRelevance, RelevanceInterval, true);
     }
 }
 
 void UCombatNetSubsystem::CreateSnapshot()
 {
 	const float Timestamp = GetWorld()->GetGameState()->GetServerWorldTimeSeconds();
-    for (TTuple<UHitbox*, FRewindRecord>& Snapshot : Snapshots)
-    {
-        if (IsValid(Snapshot.Key))
-        {
-            Snapshot.Value.Transforms.Add(TTuple<float, FTransform>(Timestamp, Snapshot.Key->GetComponentTransform()));
-            //Everything else in here is just making sure we aren't saving snapshots significantly older than the max lag compensation.
-            int32 LowestAcceptableIndex = -1;
-            for (int i = 0; i < Snapshot.Value.Transforms.Num(); i++)
-            {
-                if (Snapshot.Value.Transforms[i].Key < Timestamp - MaxLagCompensation)
-                {
-                    LowestAcceptableIndex = i;
-                }
-                else
-                {
-                    break;
-                }
-            }
-            if (LowestAcceptableIndex > -1)
-            {
-                Snapshot.Value.Transforms.RemoveAt(0, LowestAcceptableIndex + 1);
-            }
-        }
-    }
+	float FrameDisplacement = 0.0f;
+	for (UHitbox* Hitbox : RelevantHitboxes)
+	{
+		if (!IsValid(Hitbox))
+		{
+			continue;
+		}
+		FRewindRecord* Record = Snapshots.Find(Hitbox);
+		if (Record)
+		{
+			const FTransform Transform = Hitbox->GetComponentTransform();
+			//The record is a fixed size ring buffer, so this overwrites the oldest snapshot once it is full instead of removing old entries.
+			Record->AddSnapshot(Timestamp, Transform);
+			//The oldest snapshot covers max lag compensation, so this is the furthest this hitbox can be rewound from where it is now.
+			FrameDisplacement = FMath::Max(FrameDisplacement, FVector::Dist(Record->GetTransform(0).GetLocation(), Transform.GetLocation()));
+			MaxHitboxExtent = FMath::Max(MaxHitboxExtent, Hitbox->GetScaledBoxExtent().Size());
+		}
+	}
+	if (FrameDisplacement >= MaxRewindDisplacement || Timestamp - MaxRewindDisplacementTime > MaxLagCompensation)
+	{
+		MaxRewindDisplacement = FrameDisplacement;
+		MaxRewindDisplacementTime = Timestamp;
+	}
 }
 
-FTransform UCombatNetSubsystem::RewindHitbox(UHitbox* Hitbox, const float Timestamp)
+void UCombatNetSubsystem::UpdateSnapshotRelevance()
+{
+	const float Timestamp = GetWorld()->GetGameState()->GetServerWorldTimeSeconds();
+	TArray<FVector> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (IsValid(Controller))
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+	const float MaxDistance = HitboxSnapshotRelevanceDistance.GetValueOnGameThread();
+	const float MaxDistanceSquared = MaxDistance > 0.0f ? FMath::Square(MaxDistance) : 0.0f;
+	RelevantHitboxes.Reset();
+	for (TTuple<UHitbox*, FRewindRecord>& Snapshot : Snapshots)
+	{
+		if (!IsValid(Snapshot.Key))
+		{
+			continue;
+		}
+		if (IsHitboxRelevant(Snapshot.Key, ViewLocations, MaxDistanceSquared))
+		{
+			if (Snapshot.Value.IsStatic())
+			{
+				Snapshot.Value.ClearStatic();
+				Snapshot.Value.AddSnapshot(Timestamp, Snapshot.Key->GetComponentTransform());
+			}
+			RelevantHitboxes.Add(Snapshot.Key);
+		}
+		else if (!Snapshot.Value.IsStatic())
+		{
+			Snapshot.Value.MarkStatic(Timestamp, Snapshot.Key->GetComponentTransform());
+		}
+	}
+}
+
+bool UCombatNetSubsystem::IsHitboxRelevant(const UHitbox* Hitbox, const TArray<FVector>& ViewLocations, const float MaxDistanceSquared) const
+{
+	//Player hitboxes are always recorded, there are only ever a few of them.
+	if (!Hitbox->IsNPCHitbox())
+	{
+		return true;
+	}
+	if (!Hitbox->IsActiveNPCHitbox())
+	{
+		return false;
+	}
+	if (MaxDistanceSquared <= 0.0f)
+	{
+		return true;
+	}
+	const FVector HitboxLocation = Hitbox->GetComponentLocation();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		if (FVector::DistSquared(HitboxLocation, ViewLocation) <= MaxDistanceSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FTransform UCombatNetSubsystem::GetRewoundTransform(UHitbox* Hitbox, const float Timestamp) const
 {
 	const float CurrentTime = GetWorld()->GetGameState()->GetServerWorldTimeSeconds();
 	const float RewindTimestamp = FMath::Clamp(Timestamp, CurrentTime - MaxLagCompensation, CurrentTime);
-    const FTransform OriginalTransform = Hitbox->GetComponentTransform();
-    //Zero rewind time means just use the current transform.
-    if (RewindTimestamp == CurrentTime)
-    {
-    	return OriginalTransform;
-    }
-    FRewindRecord* Record = Snapshots.Find(Hitbox);
-    //If this hitbox wasn't registered or hasn't had a snapshot yet, we won't rewind it.
-    if (!Record)
-    {
-    	return OriginalTransform;
-    }
-    if (Record->Transforms.Num() == 0)
-    {
-    	return OriginalTransform;
-    }
-    int32 AfterIndex = -1;
-    //Iterate trying to find the first record that comes AFTER the timestamp.
-    for (int i = 0; i < Record->Transforms.Num(); i++)
-    {
-    	if (RewindTimestamp <= Record->Transforms[i].Key)
-    	{
-    		AfterIndex = i;
-    		break;
-    	}
-    }
-    //If the very first snapshot is after the timestamp, immediately apply max lag compensation (rewinding to the oldest snapshot).
-    if (AfterIndex == 0)
-    {
-    	Hitbox->SetWorldTransform(Record->Transforms[0].Value);
-    	if (IsValid(DebugOptions) && DebugOptions->bDrawRewindHitboxes)
-    	{
-    		DebugOptions->DrawRewindHitbox(Hitbox, OriginalTransform);
-    	}
-    	return OriginalTransform;
-    }
-    float BeforeTimestamp;
-    float AfterTimestamp;
-    FTransform BeforeTransform;
-    FTransform AfterTransform;
-    if (Record->Transforms.IsValidIndex(AfterIndex))
-    {
-    	BeforeTimestamp = Record->Transforms[AfterIndex - 1].Key;
-    	BeforeTransform = Record->Transforms[AfterIndex - 1].Value;
-    	AfterTimestamp = Record->Transforms[AfterIndex].Key;
-    	AfterTransform = Record->Transforms[AfterIndex].Value;
-    }
-    else
-    {
-    	//If we didn't find a record after the timestamp, we can interpolate from the last record to current position.
-    	BeforeTimestamp = Record->Transforms[Record->Transforms.Num() - 1].Key;
-    	BeforeTransform = Record->Transforms[Record->Transforms.Num() - 1].Value;
-    	AfterTimestamp = CurrentTime;
-    	AfterTransform = Hitbox->GetComponentTransform();
-    }
-    //Find out what fraction of the way from the before timestamp to the after timestamp our target timestamp is.
-    const float SnapshotGap = AfterTimestamp - BeforeTimestamp;
-    const float SnapshotFraction = (RewindTimestamp - BeforeTimestamp) / SnapshotGap;
-    //Interpolate location.
-    const FVector LocDiff = AfterTransform.GetLocation() - BeforeTransform.GetLocation();
-    const FVector InterpVector = LocDiff * SnapshotFraction;
-    Hitbox->SetWorldLocation(BeforeTransform.GetLocation() + InterpVector);
-    //Interpolate rotation.
-    const FRotator RotDiff = AfterTransform.Rotator() - BeforeTransform.Rotator();
-    const FRotator InterpRotator = RotDiff * SnapshotFraction;
-    Hitbox->SetWorldRotation(BeforeTransform.Rotator() + InterpRotator);
-    //Don't interpolate scale (I don't currently have smooth scale changes). Just pick whichever is closer to the target timestamp.
-    Hitbox->SetWorldScale3D(SnapshotFraction <= 0.5f ? BeforeTransform.GetScale3D() : AfterTransform.GetScale3D());
-	if (IsValid(DebugOptions) && DebugOptions->bDrawRewindHitboxes)
-	{
-		DebugOptions->DrawRewindHitbox(Hitbox, OriginalTransform);
-	}
-    return OriginalTransform;
+	const FTransform CurrentTransform = Hitbox->GetComponentTransform();
+	//Zero rewind time means just use the current transform.
+	if (RewindTimestamp == CurrentTime)
+	{
+		return CurrentTransform;
+	}
+	const FRewindRecord* Record = Snapshots.Find(Hitbox);
+	//If this hitbox wasn't registered or hasn't had a snapshot yet, we won't rewind it.
+	if (!Record || Record->Num() == 0)
+	{
+		return CurrentTransform;
+	}
+	//Hitboxes that haven't been relevant since before the rewind time are treated as not having moved.
+	if (Record->IsStatic() && RewindTimestamp >= Record->GetStaticSince())
+	{
+		return CurrentTransform;
+	}
+	const int32 AfterIndex = Record->FindFirstSnapshotAfter(RewindTimestamp);
+	//If the very first snapshot is after the timestamp, immediately apply max lag compensation (rewinding to the oldest snapshot).
+	if (AfterIndex == 0)
+	{
+		return Record->GetTransform(0);
+	}
+	float BeforeTimestamp;
+	float AfterTimestamp;
+	FTransform BeforeTransform;
+	FTransform AfterTransform;
+	if (AfterIndex < Record->Num())
+	{
+		BeforeTimestamp = Record->GetTimestamp(AfterIndex - 1);
+		BeforeTransform = Record->GetTransform(AfterIndex - 1);
+		AfterTimestamp = Record->GetTimestamp(AfterIndex);
+		AfterTransform = Record->GetTransform(AfterIndex);
+	}
+	else
+	{
+		//If we didn't find a record after the timestamp, we can interpolate from the last record to current position.
+		BeforeTimestamp = Record->GetTimestamp(Record->Num() - 1);
+		BeforeTransform = Record->GetTransform(Record->Num() - 1);
+		AfterTimestamp = CurrentTime;
+		AfterTransform = CurrentTransform;
+	}
+	//Find out what fraction of the way from the before timestamp to the after timestamp our target timestamp is.
+	const float SnapshotGap = AfterTimestamp - BeforeTimestamp;
+	const float SnapshotFraction = SnapshotGap > 0.0f ? FMath::Clamp((RewindTimestamp - BeforeTimestamp) / SnapshotGap, 0.0f, 1.0f) : 1.0f;
+	FTransform RewoundTransform;
+	RewoundTransform.SetLocation(FMath::Lerp(BeforeTransform.GetLocation(), AfterTransform.GetLocation(), SnapshotFraction));
+	RewoundTransform.SetRotation(FQuat::Slerp(BeforeTransform.GetRotation(), AfterTransform.GetRotation(), SnapshotFraction));
+	//Don't interpolate scale (I don't currently have smooth scale changes). Just pick whichever is closer to the target timestamp.
+	RewoundTransform.SetScale3D(SnapshotFraction <= 0.5f ? BeforeTransform.GetScale3D() : AfterTransform.GetScale3D());
+	return RewoundTransform;
+}
+
+void UCombatNetSubsystem::BuildRewindQuery(const TArray<UHitbox*>& Hitboxes, const float Timestamp, FHitboxRewindQuery& OutQuery) const
+{
+	for (UHitbox* Hitbox : Hitboxes)
+	{
+		if (!IsValid(Hitbox))
+		{
+			continue;
+		}
+		const FTransform RewoundTransform = GetRewoundTransform(Hitbox, Timestamp);
+		OutQuery.AddHitbox(Hitbox, RewoundTransform);
+		if (IsValid(DebugOptions) && DebugOptions->bDrawRewindHitboxes)
+		{
+			DebugOptions->DrawRewindHitbox(Hitbox, RewoundTransform);
+		}
+	}
+}
+
+#pragma endregion
+#pragma region Shot Validation
+
+void UCombatNetSubsystem::UpdateShotBatchFrame()
+{
+	if (ShotBatchFrame == GFrameCounter)
+	{
+		return;
+	}
+	ShotBatchFrame = GFrameCounter;
+	ShotBatches.Reset();
+	if (CurrentFrameStats.RewindRequests > 0 || CurrentFrameStats.ShotsValidated > 0 || CurrentFrameStats.ShotsRejected > 0)
+	{
+		LastFrameStats = CurrentFrameStats;
+		if (LogShotValidationStats.GetValueOnGameThread() > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Shot validation: %i validated, %i rejected, %i rewind batches, %i hitboxes rewound, %f average rewind depth."),
+				LastFrameStats.ShotsValidated, LastFrameStats.ShotsRejected, LastFrameStats.RewindBatches, LastFrameStats.HitboxesRewound, LastFrameStats.GetAverageRewindDepth());
+		}
+	}
+	CurrentFrameStats = FShotValidationStats();
+}
+
+const FHitboxRewindQuery& UCombatNetSubsystem::GetBatchedRewindQuery(const ASaiyoraPlayerCharacter* Shooter, const float Timestamp, const int32 ObjectMask,
+	const TArray<UHitbox*>& Hitboxes)
+{
+	UpdateShotBatchFrame();
+	CurrentFrameStats.RewindRequests++;
+	CurrentFrameStats.TotalRewindDepth += FMath::Max(GetWorld()->GetGameState()->GetServerWorldTimeSeconds() - Timestamp, 0.0f);
+	FShotRewindBatch* Batch = ShotBatches.FindByPredicate([Shooter, Timestamp, ObjectMask](const FShotRewindBatch& Existing)
+	{
+		return Existing.Shooter == Shooter && Existing.Timestamp == Timestamp && Existing.ObjectMask == ObjectMask;
+	});
+	if (!Batch)
+	{
+		Batch = &ShotBatches.AddDefaulted_GetRef();
+		Batch->Shooter = Shooter;
+		Batch->Timestamp = Timestamp;
+		Batch->ObjectMask = ObjectMask;
+		CurrentFrameStats.RewindBatches++;
+	}
+	//Only rewind hitboxes that an earlier shot in this batch didn't already add.
+	TArray<UHitbox*> NewHitboxes;
+	for (UHitbox* Hitbox : Hitboxes)
+	{
+		bool bAlreadyInBatch = false;
+		Batch->Hitboxes.Add(Hitbox, &bAlreadyInBatch);
+		if (!bAlreadyInBatch)
+		{
+			NewHitboxes.Add(Hitbox);
+		}
+	}
+	if (NewHitboxes.Num() > 0)
+	{
+		BuildRewindQuery(NewHitboxes, Timestamp, Batch->Query);
+		CurrentFrameStats.HitboxesRewound += NewHitboxes.Num();
+	}
+	return Batch->Query;
+}
+
+void UCombatNetSubsystem::RecordShotValidation(const int32 NumPredicted, const int32 NumValidated)
+{
+	UpdateShotBatchFrame();
+	CurrentFrameStats.ShotsValidated += NumValidated;
+	CurrentFrameStats.ShotsRejected += FMath::Max(NumPredicted - NumValidated, 0);
 }
 
 #pragma endregion
@@ -144,16 +433,17 @@ FTransform UCombatNetSubsystem::RewindHitbox(UHitbox* Hitbox, const float Timest
 
 int32 UCombatNetSubsystem::GetNewProjectileID(ASaiyoraPlayerCharacter* Player, const FPredictedTick& Tick)
 {
-	if (!IsValid(Player))
+	if (!IsValid(Player) || Tick.TickNumber < 0)
 	{
 		return -1;
 	}
-	//Get the projectile info for this player.
-	FPlayerProjectileInfo& PlayerProjectileInfo = PlayerProjectiles.FindOrAdd(Player);
-	//Get the player's projectile info for the given tick.
-	FPredictedTickProjectiles& PredictedTickInfo = PlayerProjectileInfo.TickProjectiles.FindOrAdd(Tick);
+	FProjectilePredictionSlot& Slot = GetPredictionSlot(Player, Tick.PredictionID);
+	if (!Slot.TickIDCounters.IsValidIndex(Tick.TickNumber))
+	{
+		Slot.TickIDCounters.SetNumZeroed(Tick.TickNumber + 1);
+	}
 	//Increment the ID counter for this tick.
-	return PredictedTickInfo.IDCounter++;
+	return Slot.TickIDCounters[Tick.TickNumber]++;
 }
 
 void UCombatNetSubsystem::RegisterClientProjectile(ASaiyoraPlayerCharacter* Player, APredictableProjectile* Projectile)
@@ -162,12 +452,7 @@ void UCombatNetSubsystem::RegisterClientProjectile(ASaiyoraPlayerCharacter* Play
 	{
 		return;
 	}
-	//Get the projectile info for the given player.
-	FPlayerProjectileInfo& PlayerProjectileInfo = PlayerProjectiles.FindOrAdd(Player);
-	//Get the player's projectile info for this predicted tick.
-	FPredictedTickProjectiles& ProjectileIDs = PlayerProjectileInfo.TickProjectiles.FindOrAdd(Projectile->GetSourceInfo().SourceTick);
-	//Add the projectile and its ID to the projectile map for this tick.
-	ProjectileIDs.Projectiles.Add(Projectile->GetSourceInfo().ID, Projectile);
+	AddPredictedProjectile(Player, Projectile->GetSourceInfo().SourceTick, Projectile->GetSourceInfo().ID, Projectile);
 }
 
 void UCombatNetSubsystem::ReplaceProjectile(APredictableProjectile* AuthProjectile)
@@ -176,20 +461,12 @@ void UCombatNetSubsystem::ReplaceProjectile(APredictableProjectile* AuthProjecti
 	{
 		return;
 	}
-	//Get the projectile info for the projectile's owner.
-	FPlayerProjectileInfo* PlayerProjectileInfo = PlayerProjectiles.Find(AuthProjectile->GetSourceInfo().Owner);
-	if (!PlayerProjectileInfo)
+	const FProjectileSource& SourceInfo = AuthProjectile->GetSourceInfo();
+	APredictableProjectile* ClientProjectile = nullptr;
+	if (!TakePredictedProjectile(SourceInfo.Owner, SourceInfo.SourceTick, SourceInfo.ID, ClientProjectile))
 	{
 		return;
 	}
-	//Get the info for the predicted tick this projectile was spawned during.
-	FPredictedTickProjectiles* TickInfo = PlayerProjectileInfo->TickProjectiles.Find(AuthProjectile->GetSourceInfo().SourceTick);
-	if (!TickInfo)
-	{
-		return;
-	}
-	//Get the client predicted projectile matching the auth projectile's ID.
-	APredictableProjectile* ClientProjectile = TickInfo->Projectiles.FindRef(AuthProjectile->GetSourceInfo().ID);
 	//If we found a client projectile, replace it (destroying it) with the server projectile.
 	//Update the server projectile to be invisible if the client projectile was predicted to be destroyed already.
 	if (IsValid(ClientProjectile))
@@ -197,13 +474,86 @@ void UCombatNetSubsystem::ReplaceProjectile(APredictableProjectile* AuthProjecti
 		const bool bWasLocallyDestroyed = ClientProjectile->Replace();
 		AuthProjectile->UpdateLocallyDestroyed(bWasLocallyDestroyed);
 	}
-	//Remove the info for this tick/ID combo since it has already been replaced.
-	TickInfo->Projectiles.Remove(AuthProjectile->GetSourceInfo().ID);
-	//If there's no more predicted projectiles for this predicted tick, we can go ahead and remove the info struct for this tick.
-	if (TickInfo->Projectiles.Num() == 0)
+}
+
+int32 UCombatNetSubsystem::GetNumLiveProjectileSlots() const
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	int32 LiveSlots = 0;
+	for (const TTuple<ASaiyoraPlayerCharacter*, FPlayerProjectileInfo>& PlayerInfo : PlayerProjectiles)
+	{
+		for (const FProjectilePredictionSlot& Slot : PlayerInfo.Value.Slots)
+		{
+			if (Slot.bInUse && CurrentTime - Slot.LastUsedTime <= ProjectileSlotExpiry)
+			{
+				LiveSlots++;
+			}
+		}
+	}
+	return LiveSlots;
+}
+
+FProjectilePredictionSlot& UCombatNetSubsystem::GetPredictionSlot(ASaiyoraPlayerCharacter* Player, const int32 PredictionID)
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	FProjectilePredictionSlot& Slot = PlayerProjectiles.FindOrAdd(Player).Slots[FPlayerProjectileInfo::GetSlotIndex(PredictionID)];
+	if (!Slot.bInUse || Slot.PredictionID != PredictionID || CurrentTime - Slot.LastUsedTime > ProjectileSlotExpiry)
+	{
+		if (Slot.bInUse && Slot.Projectiles.Num() > 0)
+		{
+			ExpiredProjectileSlots++;
+		}
+		Slot.Reset(PredictionID);
+	}
+	Slot.LastUsedTime = CurrentTime;
+	return Slot;
+}
+
+FProjectilePredictionSlot* UCombatNetSubsystem::FindPredictionSlot(ASaiyoraPlayerCharacter* Player, const int32 PredictionID)
+{
+	FPlayerProjectileInfo* PlayerInfo = PlayerProjectiles.Find(Player);
+	if (!PlayerInfo)
+	{
+		return nullptr;
+	}
+	FProjectilePredictionSlot& Slot = PlayerInfo->Slots[FPlayerProjectileInfo::GetSlotIndex(PredictionID)];
+	if (!Slot.bInUse || Slot.PredictionID != PredictionID || GetWorld()->GetTimeSeconds() - Slot.LastUsedTime > ProjectileSlotExpiry)
+	{
+		return nullptr;
+	}
+	return &Slot;
+}
+
+void UCombatNetSubsystem::AddPredictedProjectile(ASaiyoraPlayerCharacter* Player, const FPredictedTick& Tick, const int32 ID, APredictableProjectile* Projectile)
+{
+	FProjectilePredictionSlot& Slot = GetPredictionSlot(Player, Tick.PredictionID);
+	FPredictedProjectileEntry& Entry = Slot.Projectiles.AddDefaulted_GetRef();
+	Entry.TickNumber = Tick.TickNumber;
+	Entry.ID = ID;
+	Entry.Projectile = Projectile;
+}
+
+bool UCombatNetSubsystem::TakePredictedProjectile(ASaiyoraPlayerCharacter* Player, const FPredictedTick& Tick, const int32 ID, APredictableProjectile*& OutProjectile)
+{
+	OutProjectile = nullptr;
+	//Get the slot for the prediction this projectile was spawned during. If it has already been reused, the predicted projectile is gone.
+	FProjectilePredictionSlot* Slot = FindPredictionSlot(Player, Tick.PredictionID);
+	if (!Slot)
+	{
+		return false;
+	}
+	const int32 EntryIndex = Slot->Projectiles.IndexOfByPredicate([&Tick, ID](const FPredictedProjectileEntry& Entry)
+	{
+		return Entry.TickNumber == Tick.TickNumber && Entry.ID == ID;
+	});
+	if (EntryIndex == INDEX_NONE)
 	{
-		PlayerProjectileInfo->TickProjectiles.Remove(AuthProjectile->GetSourceInfo().SourceTick);
+		return false;
 	}
+	OutProjectile = Slot->Projectiles[EntryIndex].Projectile;
+	//Remove the entry for this tick/ID combo since it has already been replaced.
+	Slot->Projectiles.RemoveAtSwap(EntryIndex);
+	return true;
 }
 
 #pragma endregion 
\ No newline at end of file
@@ -56,28 +56,17 @@ FCombatModifier::FCombatModifier(const float BaseValue, const EModifierType Modi
 
 float FCombatModifier::ApplyModifiers(const TArray<FCombatModifier>& ModArray, const float BaseValue)
 {
-    float AddMod = 0.0f;
-    float MultMod = 1.0f;
+    return ApplyModifiers(ModArray, BaseValue, FCombatModifierTerms());
+}
+
+float FCombatModifier::ApplyModifiers(const TArray<FCombatModifier>& ModArray, const float BaseValue, const FCombatModifierTerms& PrecomputedTerms)
+{
+    FCombatModifierTerms Terms = PrecomputedTerms;
     for (const FCombatModifier& Mod : ModArray)
     {
-        switch (Mod.Type)
-        {
-        case EModifierType::Invalid :
-            break;
-        case EModifierType::Additive :
-            AddMod += Mod.Value * ((IsValid(Mod.BuffSource) && Mod.bStackable) ? Mod.BuffSource->GetCurrentStacks() : 1);
-            break;
-        case EModifierType::Multiplicative :
-            //This means no negative multipliers.
-            //If you want a 5% reduction as a modifier, you would use .95. At, for example, 2 stacks, this would become:
-            //.95 - 1, which is -.05, then -.05 * 2, which is -.1, then -.1 + 1, which is .9, so a 10% reduction.
-            MultMod *= FMath::Max(0.0f, ((IsValid(Mod.BuffSource) && Mod.bStackable) ? Mod.BuffSource->GetCurrentStacks() : 1) * (Mod.Value - 1.0f) + 1.0f);
-            break;
-        default :
-            break;
-        }
-    }
-    return FMath::Max(0.0f, FMath::Max(0.0f, BaseValue + AddMod) * MultMod);
+        Terms.Fold(Mod);
+    }
+    return Terms.Apply(BaseValue);
 }
 
 int32 FCombatModifier::ApplyModifiers(const TArray<FCombatModifier>& ModArray, const int32 BaseValue)
@@ -86,6 +75,83 @@ int32 FCombatModifier::ApplyModifiers(const TArray<FCombatModifier>& ModArray, c
     return FMath::TruncToInt32(ApplyModifiers(ModArray, ValueAsFloat));
 }
 
+int32 FCombatModifier::GetStackMultiplier() const
+{
+    return (IsValid(BuffSource) && bStackable) ? BuffSource->GetCurrentStacks() : 1;
+}
+
+void FCombatModifierTerms::Fold(const FCombatModifier& Modifier)
+{
+    switch (Modifier.Type)
+    {
+    case EModifierType::Invalid :
+        break;
+    case EModifierType::Additive :
+        Additive += Modifier.Value * Modifier.GetStackMultiplier();
+        break;
+    case EModifierType::Multiplicative :
+        //This means no negative multipliers.
+        //If you want a 5% reduction as a modifier, you would use .95. At, for example, 2 stacks, this would become:
+        //.95 - 1, which is -.05, then -.05 * 2, which is -.1, then -.1 + 1, which is .9, so a 10% reduction.
+        Multiplicative *= FMath::Max(0.0f, Modifier.GetStackMultiplier() * (Modifier.Value - 1.0f) + 1.0f);
+        break;
+    default :
+        break;
+    }
+}
+
+FCombatModifierHandle FCompiledModifierCache::Add(const FCombatModifier& Modifier)
+{
+    if (Modifier.Type == EModifierType::Invalid)
+    {
+        return FCombatModifierHandle::Invalid;
+    }
+    const FCombatModifierHandle OutHandle = FCombatModifierHandle::MakeHandle();
+    Modifiers.Add(OutHandle, Modifier);
+    bDirty = true;
+    return OutHandle;
+}
+
+void FCompiledModifierCache::Remove(const FCombatModifierHandle& Handle)
+{
+    if (Modifiers.Remove(Handle) > 0)
+    {
+        bDirty = true;
+    }
+}
+
+void FCompiledModifierCache::Update(const FCombatModifierHandle& Handle, const FCombatModifier& NewModifier)
+{
+    if (NewModifier.Type == EModifierType::Invalid)
+    {
+        return;
+    }
+    if (FCombatModifier* Existing = Modifiers.Find(Handle))
+    {
+        *Existing = NewModifier;
+        bDirty = true;
+    }
+}
+
+const FCombatModifierTerms& FCompiledModifierCache::GetTerms() const
+{
+    if (bDirty)
+    {
+        Recompile();
+    }
+    return Terms;
+}
+
+void FCompiledModifierCache::Recompile() const
+{
+    Terms = FCombatModifierTerms();
+    for (const TPair<FCombatModifierHandle, FCombatModifier>& Modifier : Modifiers)
+    {
+        Terms.Fold(Modifier.Value);
+    }
+    bDirty = false;
+}
+
 FCombatModifierHandle FModifiableFloat::AddModifier(const FCombatModifier& Modifier)
 {
     if (!bIsModifiable || Modifier.Type == EModifierType::Invalid)
@@ -0,0 +1,156 @@
+﻿#include "CombatantRegistrySubsystem.h"
+#include "AbilityFunctionLibrary.h"
+#include "CombatStatusComponent.h"
+#include "Hitbox.h"
+
+#pragma region Structs
+
+void FCombatantBucket::Reset()
+{
+	Hitboxes.Reset();
+	Cells.Reset();
+	MaxBoundsRadius = 0.0f;
+}
+
+#pragma endregion
+#pragma region Registration
+
+void UCombatantRegistrySubsystem::RegisterHitbox(UHitbox* Hitbox)
+{
+	if (!IsValid(Hitbox))
+	{
+		return;
+	}
+	Hitboxes.AddUnique(Hitbox);
+	//Force a rebuild so the new hitbox can be found this frame.
+	LastRebuildFrame = MAX_uint64;
+}
+
+void UCombatantRegistrySubsystem::UnregisterHitbox(UHitbox* Hitbox)
+{
+	if (Hitboxes.RemoveSwap(Hitbox) > 0)
+	{
+		LastRebuildFrame = MAX_uint64;
+	}
+}
+
+#pragma endregion
+#pragma region Queries
+
+FIntPoint UCombatantRegistrySubsystem::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+float UCombatantRegistrySubsystem::GetSquaredDistanceToHitbox(const FRegisteredHitbox& Entry, const FVector& Location)
+{
+	//Hitboxes are boxes, so the closest point is the query location clamped to the box's extent in the box's local space.
+	const FVector LocalLocation = Entry.Transform.InverseTransformPositionNoScale(Location);
+	const FVector ClosestPoint = LocalLocation.BoundToBox(-Entry.Extent, Entry.Extent);
+	return FVector::DistSquared(LocalLocation, ClosestPoint);
+}
+
+void UCombatantRegistrySubsystem::UpdateGrid()
+{
+	if (LastRebuildFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastRebuildFrame = GFrameCounter;
+	for (FCombatantBucket& Bucket : Buckets)
+	{
+		Bucket.Reset();
+	}
+	for (int i = Hitboxes.Num() - 1; i >= 0; i--)
+	{
+		UHitbox* Hitbox = Hitboxes[i];
+		if (!IsValid(Hitbox) || !IsValid(Hitbox->GetOwner()))
+		{
+			Hitboxes.RemoveAtSwap(i);
+			continue;
+		}
+		//Hitboxes with collision disabled (dead or resetting NPCs) couldn't be found by an overlap either.
+		if (Hitbox->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+		{
+			continue;
+		}
+		const UCombatStatusComponent* CombatStatus = Hitbox->GetCombatStatusComponent();
+		if (!IsValid(CombatStatus))
+		{
+			continue;
+		}
+		FCombatantBucket& Bucket = Buckets[GetBucketIndex(CombatStatus->GetCurrentFaction(), CombatStatus->GetCurrentPlane())];
+		FRegisteredHitbox Entry;
+		Entry.Hitbox = Hitbox;
+		Entry.Owner = Hitbox->GetOwner();
+		Entry.Transform = Hitbox->GetComponentTransform();
+		Entry.Extent = Hitbox->GetScaledBoxExtent();
+		Entry.BoundsRadius = Entry.Extent.Size();
+		Bucket.MaxBoundsRadius = FMath::Max(Bucket.MaxBoundsRadius, Entry.BoundsRadius);
+		const int32 EntryIndex = Bucket.Hitboxes.Add(Entry);
+		Bucket.Cells.FindOrAdd(GetCell(Entry.Transform.GetLocation())).Add(EntryIndex);
+	}
+}
+
+void UCombatantRegistrySubsystem::GetCombatantsInRadius(TArray<AActor*>& OutActors, const FVector& Origin, const float Radius, const EFaction QueryFaction,
+	const ESaiyoraFactionFilter FactionFilter, const ESaiyoraPlane QueryPlane, const ESaiyoraPlaneFilter PlaneFilter)
+{
+	OutActors.Reset();
+	if (Radius < 0.0f)
+	{
+		return;
+	}
+	UpdateGrid();
+	const float RadiusSquared = FMath::Square(Radius);
+	for (int32 FactionIndex = 0; FactionIndex < NumFactions; FactionIndex++)
+	{
+		const EFaction BucketFaction = static_cast<EFaction>(FactionIndex);
+		if (!UAbilityFunctionLibrary::FactionPassesFilter(QueryFaction, BucketFaction, FactionFilter))
+		{
+			continue;
+		}
+		for (int32 PlaneIndex = 0; PlaneIndex < NumPlanes; PlaneIndex++)
+		{
+			const ESaiyoraPlane BucketPlane = static_cast<ESaiyoraPlane>(PlaneIndex);
+			if (!UAbilityFunctionLibrary::PlanePassesFilter(QueryPlane, BucketPlane, PlaneFilter))
+			{
+				continue;
+			}
+			const FCombatantBucket& Bucket = Buckets[GetBucketIndex(BucketFaction, BucketPlane)];
+			if (Bucket.Hitboxes.Num() == 0)
+			{
+				continue;
+			}
+			//Hitbox centers can be up to the largest hitbox's bounds radius outside of the query sphere and still overlap it.
+			const float SearchRadius = Radius + Bucket.MaxBoundsRadius;
+			const FIntPoint MinCell = GetCell(Origin - FVector(SearchRadius));
+			const FIntPoint MaxCell = GetCell(Origin + FVector(SearchRadius));
+			for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+			{
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+				{
+					const TArray<int32>* CellEntries = Bucket.Cells.Find(FIntPoint(X, Y));
+					if (!CellEntries)
+					{
+						continue;
+					}
+					for (const int32 EntryIndex : *CellEntries)
+					{
+						const FRegisteredHitbox& Entry = Bucket.Hitboxes[EntryIndex];
+						//Cheap bounding sphere rejection before the exact box distance.
+						if (FVector::DistSquared(Origin, Entry.Transform.GetLocation()) > FMath::Square(Radius + Entry.BoundsRadius))
+						{
+							continue;
+						}
+						if (GetSquaredDistanceToHitbox(Entry, Origin) <= RadiusSquared)
+						{
+							OutActors.AddUnique(Entry.Owner);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,162 @@
+﻿#include "LineOfSightSubsystem.h"
+#include "CombatStructs.h"
+
+#pragma region Structs
+
+FLineOfSightKey::FLineOfSightKey(const FVector& From, const FVector& To, const ESaiyoraPlane InPlane, const float Quantization)
+{
+	const FIntVector QuantizedFrom = FIntVector(FMath::RoundToInt32(From.X / Quantization), FMath::RoundToInt32(From.Y / Quantization), FMath::RoundToInt32(From.Z / Quantization));
+	const FIntVector QuantizedTo = FIntVector(FMath::RoundToInt32(To.X / Quantization), FMath::RoundToInt32(To.Y / Quantization), FMath::RoundToInt32(To.Z / Quantization));
+	const bool bFromFirst = QuantizedFrom.X != QuantizedTo.X ? QuantizedFrom.X < QuantizedTo.X
+		: QuantizedFrom.Y != QuantizedTo.Y ? QuantizedFrom.Y < QuantizedTo.Y : QuantizedFrom.Z <= QuantizedTo.Z;
+	A = bFromFirst ? QuantizedFrom : QuantizedTo;
+	B = bFromFirst ? QuantizedTo : QuantizedFrom;
+	Plane = InPlane;
+}
+
+#pragma endregion
+#pragma region Subsystem
+
+void ULineOfSightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	TraceDelegate.BindUObject(this, &ULineOfSightSubsystem::OnTraceCompleted);
+}
+
+TStatId ULineOfSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULineOfSightSubsystem, STATGROUP_Tickables);
+}
+
+void ULineOfSightSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const float Timestamp = GetWorld()->GetTimeSeconds();
+	for (TMap<FLineOfSightKey, FLineOfSightCacheEntry>::TIterator CacheIt = Cache.CreateIterator(); CacheIt; ++CacheIt)
+	{
+		if (Timestamp - CacheIt.Value().Timestamp > CacheLifetime)
+		{
+			CacheIt.RemoveCurrent();
+		}
+	}
+
+	//Every check queued since the last tick is dispatched here, so traces are batched at one point in the frame.
+	for (const TTuple<FLineOfSightKey, FLineOfSightRequest>& Queued : QueuedTraces)
+	{
+		//An identical trace already waiting on results will cache the same answer.
+		if (InFlightTraces.Contains(Queued.Key))
+		{
+			continue;
+		}
+		const uint32 TraceID = NextTraceID++;
+		TraceKeys.Add(TraceID, Queued.Key);
+		const FLineOfSightRequest& Request = Queued.Value;
+		GetWorld()->AsyncLineTraceByProfile(EAsyncTraceType::Single, Request.From, Request.To, GetLineOfSightTraceProfile(Request.Plane),
+			FCollisionQueryParams(SCENE_QUERY_STAT(LineOfSight), false), &TraceDelegate, TraceID);
+		InFlightTraces.Add(Queued.Key);
+	}
+	QueuedTraces.Empty();
+}
+
+FName ULineOfSightSubsystem::GetLineOfSightTraceProfile(const ESaiyoraPlane Plane)
+{
+	switch (Plane)
+	{
+	case ESaiyoraPlane::Ancient :
+		return FSaiyoraCollision::CT_GeometryAncient;
+	case ESaiyoraPlane::Modern :
+		return FSaiyoraCollision::CT_GeometryModern;
+	case ESaiyoraPlane::Both :
+		return FSaiyoraCollision::CT_GeometryBothPlanes;
+	default :
+		return FSaiyoraCollision::CT_GeometryNone;
+	}
+}
+
+#pragma endregion
+#pragma region Requests
+
+bool ULineOfSightSubsystem::GetOrRequestLineOfSight(const FVector& From, const FVector& To, const ESaiyoraPlane Plane, bool& bOutVisible)
+{
+	const FLineOfSightKey Key(From, To, Plane, EndpointQuantization);
+	if (FindCachedResult(Key, bOutVisible))
+	{
+		return true;
+	}
+	QueuedTraces.Add(Key, FLineOfSightRequest(From, To, Plane));
+	return false;
+}
+
+bool ULineOfSightSubsystem::FindCachedResult(const FLineOfSightKey& Key, bool& bOutVisible) const
+{
+	const FLineOfSightCacheEntry* Entry = Cache.Find(Key);
+	if (!Entry || GetWorld()->GetTimeSeconds() - Entry->Timestamp > CacheLifetime)
+	{
+		return false;
+	}
+	bOutVisible = Entry->bVisible;
+	return true;
+}
+
+void ULineOfSightSubsystem::CacheResult(const FLineOfSightKey& Key, const bool bVisible)
+{
+	FLineOfSightCacheEntry& Entry = Cache.FindOrAdd(Key);
+	Entry.bVisible = bVisible;
+	Entry.Timestamp = GetWorld()->GetTimeSeconds();
+}
+
+bool ULineOfSightSubsystem::CheckLineOfSight(const FVector& From, const FVector& To, const ESaiyoraPlane Plane)
+{
+	if (FrameResultsFrame != GFrameCounter)
+	{
+		FrameResults.Reset();
+		FrameResultsFrame = GFrameCounter;
+	}
+	const FLineOfSightKey Key(From, To, Plane, AuthoritativeQuantization);
+	if (const bool* FrameResult = FrameResults.Find(Key))
+	{
+		return *FrameResult;
+	}
+	const bool bVisible = TraceLineOfSight(FLineOfSightRequest(From, To, Plane));
+	FrameResults.Add(Key, bVisible);
+	return bVisible;
+}
+
+void ULineOfSightSubsystem::CheckLineOfSightBatch(const TArray<FLineOfSightRequest>& Requests, TArray<bool>& OutVisible)
+{
+	OutVisible.SetNumUninitialized(Requests.Num());
+	for (int32 i = 0; i < Requests.Num(); i++)
+	{
+		OutVisible[i] = CheckLineOfSight(Requests[i].From, Requests[i].To, Requests[i].Plane);
+	}
+}
+
+bool ULineOfSightSubsystem::TraceLineOfSight(const FLineOfSightRequest& Request) const
+{
+	FHitResult Hit;
+	return !GetWorld()->LineTraceSingleByProfile(Hit, Request.From, Request.To, GetLineOfSightTraceProfile(Request.Plane),
+		FCollisionQueryParams(SCENE_QUERY_STAT(LineOfSight), false));
+}
+
+void ULineOfSightSubsystem::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Data)
+{
+	FLineOfSightKey Key;
+	if (!TraceKeys.RemoveAndCopyValue(Data.UserData, Key))
+	{
+		return;
+	}
+	bool bVisible = true;
+	for (const FHitResult& Hit : Data.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			bVisible = false;
+			break;
+		}
+	}
+	CacheResult(Key, bVisible);
+	InFlightTraces.Remove(Key);
+}
+
+#pragma endregion
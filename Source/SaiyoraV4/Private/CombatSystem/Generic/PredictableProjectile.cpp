@@ -65,6 +65,7 @@ void APredictableProjectile::InitializeProjectile(UCombatAbility* Source, const
 	}
 	bIsFake = GetOwner()->GetLocalRole() != ROLE_Authority;
 	SourceInfo.Owner = Cast<ASaiyoraPlayerCharacter>(GetOwner());
+	SourceInfo.Shooter = GetOwner();
 	SourceInfo.SourceClass = Source->GetClass();
 	SourceInfo.SourceTick = Tick;
 	SourceInfo.SourceAbility = Source;
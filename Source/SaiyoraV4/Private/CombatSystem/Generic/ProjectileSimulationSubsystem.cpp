@@ -0,0 +1,285 @@
+﻿#include "ProjectileSimulationSubsystem.h"
+#include "AbilityComponent.h"
+#include "CombatAbility.h"
+#include "SaiyoraPlayerCharacter.h"
+#include "GameFramework/GameStateBase.h"
+
+#pragma region Structs
+
+int32 FSimulatedProjectileArray::Add(const FProjectileSource& Source, const FVector& Location, const FVector& Velocity, const float Gravity,
+	const float CatchUpTime, const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit, AActor* Visual, const bool bReplicateHits)
+{
+	Locations.Add(Location);
+	Velocities.Add(Velocity);
+	GravityZ.Add(Gravity);
+	RemainingLifetimes.Add(Params.Lifetime);
+	RemainingLag.Add(CatchUpTime);
+	HitboxRadii.Add(Params.HitboxRadius);
+	CollisionRadii.Add(Params.CollisionRadius);
+	switch (Params.Hostility)
+	{
+	case EFaction::Friendly :
+		HitboxProfiles.Add(FSaiyoraCollision::P_ProjectileHitboxPlayers);
+		break;
+	case EFaction::Enemy :
+		HitboxProfiles.Add(FSaiyoraCollision::P_ProjectileHitboxNPCs);
+		break;
+	case EFaction::Neutral :
+		HitboxProfiles.Add(FSaiyoraCollision::P_ProjectileHitboxAll);
+		break;
+	default :
+		HitboxProfiles.Add(FSaiyoraCollision::P_NoCollision);
+		break;
+	}
+	switch (Params.Plane)
+	{
+	case ESaiyoraPlane::Ancient :
+		CollisionProfiles.Add(FSaiyoraCollision::P_ProjectileCollisionAncient);
+		break;
+	case ESaiyoraPlane::Modern :
+		CollisionProfiles.Add(FSaiyoraCollision::P_ProjectileCollisionModern);
+		break;
+	case ESaiyoraPlane::Both :
+		CollisionProfiles.Add(FSaiyoraCollision::P_ProjectileCollisionAll);
+		break;
+	default :
+		CollisionProfiles.Add(FSaiyoraCollision::P_NoCollision);
+		break;
+	}
+	ReplicatesHits.Add(bReplicateHits);
+	Sources.Add(Source);
+	Callbacks.Add(OnHit);
+	return Visuals.Add(Visual);
+}
+
+void FSimulatedProjectileArray::RemoveAtSwap(const int32 Index)
+{
+	Locations.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	GravityZ.RemoveAtSwap(Index, 1, false);
+	RemainingLifetimes.RemoveAtSwap(Index, 1, false);
+	RemainingLag.RemoveAtSwap(Index, 1, false);
+	HitboxRadii.RemoveAtSwap(Index, 1, false);
+	CollisionRadii.RemoveAtSwap(Index, 1, false);
+	HitboxProfiles.RemoveAtSwap(Index, 1, false);
+	CollisionProfiles.RemoveAtSwap(Index, 1, false);
+	ReplicatesHits.RemoveAtSwap(Index, 1, false);
+	Sources.RemoveAtSwap(Index, 1, false);
+	Callbacks.RemoveAtSwap(Index, 1, false);
+	Visuals.RemoveAtSwap(Index, 1, false);
+}
+
+#pragma endregion
+#pragma region Simulation
+
+TStatId UProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UProjectileSimulationSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<UAbilityComponent>& MispredictionSource : MispredictionSources)
+	{
+		if (MispredictionSource.IsValid())
+		{
+			MispredictionSource->OnAbilityMispredicted.RemoveDynamic(this, &UProjectileSimulationSubsystem::OnAbilityMispredicted);
+		}
+	}
+	MispredictionSources.Empty();
+	Super::Deinitialize();
+}
+
+void UProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Projectiles.Num() == 0)
+	{
+		return;
+	}
+	UWorld* World = GetWorld();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SimulatedProjectileSweep), false);
+	TArray<FHitResult> HitboxHits;
+	//Iterate backwards so that removing a projectile only ever swaps in one that has already been simulated this frame.
+	for (int32 i = Projectiles.Num() - 1; i >= 0; i--)
+	{
+		float StepTime = DeltaTime;
+		if (Projectiles.RemainingLag[i] > 0.0f)
+		{
+			const float AddTime = FMath::Min(DeltaTime, Projectiles.RemainingLag[i]);
+			Projectiles.RemainingLag[i] -= AddTime;
+			StepTime += AddTime;
+		}
+		Projectiles.Velocities[i].Z += Projectiles.GravityZ[i] * StepTime;
+		const FVector Start = Projectiles.Locations[i];
+		const FVector End = Start + Projectiles.Velocities[i] * StepTime;
+		
+		QueryParams.ClearIgnoredActors();
+		QueryParams.AddIgnoredActor(Projectiles.Sources[i].Shooter);
+		//Level geometry blocks the projectile, so only hitboxes in front of the blocking hit are considered.
+		FHitResult Hit;
+		bool bHit = World->SweepSingleByProfile(Hit, Start, End, FQuat::Identity, Projectiles.CollisionProfiles[i],
+			FCollisionShape::MakeSphere(Projectiles.CollisionRadii[i]), QueryParams);
+		HitboxHits.Reset();
+		World->SweepMultiByProfile(HitboxHits, Start, bHit ? Hit.Location : End, FQuat::Identity, Projectiles.HitboxProfiles[i],
+			FCollisionShape::MakeSphere(Projectiles.HitboxRadii[i]), QueryParams);
+		//Hitboxes only overlap projectiles, and overlaps are sorted by distance along the sweep.
+		if (HitboxHits.Num() > 0)
+		{
+			Hit = HitboxHits[0];
+			bHit = true;
+		}
+		if (bHit)
+		{
+			//Remove before executing the callback, in case the callback spawns or destroys other projectiles.
+			const FSimulatedProjectileCallback Callback = Projectiles.Callbacks[i];
+			const FProjectileSource Source = Projectiles.Sources[i];
+			const bool bReplicateHit = Projectiles.ReplicatesHits[i];
+			RemoveProjectile(i);
+			if (bReplicateHit && IsValid(Source.SourceAbility) && IsValid(Source.SourceAbility->GetHandler()))
+			{
+				Source.SourceAbility->GetHandler()->ReplicateVolleyProjectileHit(Source.SourceTick, Source.ID);
+			}
+			Callback.ExecuteIfBound(Hit, Source.ID);
+			continue;
+		}
+		Projectiles.RemainingLifetimes[i] -= StepTime;
+		if (Projectiles.RemainingLifetimes[i] <= 0.0f)
+		{
+			RemoveProjectile(i);
+			continue;
+		}
+		Projectiles.Locations[i] = End;
+		if (IsValid(Projectiles.Visuals[i]))
+		{
+			Projectiles.Visuals[i]->SetActorLocationAndRotation(End, Projectiles.Velocities[i].Rotation());
+		}
+	}
+}
+
+void UProjectileSimulationSubsystem::SpawnProjectile(const FProjectileSource& Source, const FVector& Location, const FVector& Direction,
+	const float CatchUpTime, const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit, const bool bReplicateHits)
+{
+	const FVector Velocity = Direction.GetSafeNormal() * Params.Speed;
+	AActor* Visual = nullptr;
+	if (IsValid(Params.VisualClass) && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Visual = GetWorld()->SpawnActor<AActor>(Params.VisualClass, Location, Velocity.Rotation(), SpawnParams);
+		if (IsValid(Visual))
+		{
+			Visual->SetActorEnableCollision(false);
+		}
+	}
+	Projectiles.Add(Source, Location, Velocity, GetWorld()->GetGravityZ() * Params.GravityScale, FMath::Clamp(CatchUpTime, 0.0f, MaxCatchUpTime),
+		Params, OnHit, Visual, bReplicateHits);
+
+	//Predicted projectiles need to be removed if the server rejects the prediction that spawned them.
+	if (IsValid(Source.SourceAbility) && IsValid(Source.SourceAbility->GetHandler()) && Source.SourceAbility->GetHandler()->GetOwnerRole() == ROLE_AutonomousProxy)
+	{
+		Source.SourceAbility->GetHandler()->OnAbilityMispredicted.AddUniqueDynamic(this, &UProjectileSimulationSubsystem::OnAbilityMispredicted);
+		MispredictionSources.AddUnique(Source.SourceAbility->GetHandler());
+	}
+}
+
+void UProjectileSimulationSubsystem::SpawnVolley(const FProjectileSource& Source, const FVector& Location, const FVector& AimDirection,
+	const int32 Count, const float SpreadAngle, const float CatchUpTime, const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit)
+{
+	TArray<FVector> Directions;
+	GetVolleyDirections(AimDirection, Count, SpreadAngle, GetVolleySeed(Source.SourceTick, Source.ID), Directions);
+	const bool bReplicateHits = GetWorld()->GetNetMode() != NM_Standalone && IsValid(Source.Shooter) && Source.Shooter->HasAuthority();
+	FProjectileSource PelletSource = Source;
+	for (int32 i = 0; i < Directions.Num(); i++)
+	{
+		PelletSource.ID = Source.ID + i;
+		SpawnProjectile(PelletSource, Location, Directions[i], CatchUpTime, Params, OnHit, bReplicateHits);
+	}
+}
+
+void UProjectileSimulationSubsystem::SimulateReplicatedVolley(AActor* Shooter, const FProjectileVolley& Volley)
+{
+	FProjectileSource Source;
+	Source.Owner = Cast<ASaiyoraPlayerCharacter>(Shooter);
+	Source.Shooter = Shooter;
+	Source.SourceClass = Volley.SourceClass;
+	Source.SourceTick = Volley.SourceTick;
+	Source.ID = Volley.FirstID;
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float CatchUpTime = IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() - Volley.FireTime : 0.0f;
+	//The visual class isn't replicated, it is looked up from the source ability's defaults.
+	FSimulatedProjectileParams Params = Volley.Params;
+	const UCombatAbility* SourceDefaults = IsValid(Volley.SourceClass) ? Volley.SourceClass->GetDefaultObject<UCombatAbility>() : nullptr;
+	Params.VisualClass = IsValid(SourceDefaults) ? SourceDefaults->GetProjectileVisual(Volley.VisualIndex) : nullptr;
+	//Local copies are only for display. The server's copies are the only ones that do anything when they hit, and tell us when to remove ours.
+	SpawnVolley(Source, Volley.Origin, Volley.AimDirection, Volley.Count, Volley.SpreadAngle, CatchUpTime, Params, FSimulatedProjectileCallback());
+}
+
+void UProjectileSimulationSubsystem::GetVolleyDirections(const FVector& AimDirection, const int32 Count, const float SpreadAngle,
+	const int32 Seed, TArray<FVector>& OutDirections)
+{
+	OutDirections.Reset(Count);
+	const FVector Aim = AimDirection.GetSafeNormal();
+	if (SpreadAngle <= 0.0f)
+	{
+		OutDirections.Init(Aim, Count);
+		return;
+	}
+	FRandomStream Stream(Seed);
+	const float HalfAngleRadians = FMath::DegreesToRadians(SpreadAngle * 0.5f);
+	for (int32 i = 0; i < Count; i++)
+	{
+		OutDirections.Add(Stream.VRandCone(Aim, HalfAngleRadians));
+	}
+}
+
+bool UProjectileSimulationSubsystem::DestroyProjectile(const AActor* Shooter, const FPredictedTick& SourceTick, const int32 ID)
+{
+	for (int32 i = 0; i < Projectiles.Num(); i++)
+	{
+		const FProjectileSource& Source = Projectiles.Sources[i];
+		if (Source.Shooter == Shooter && Source.SourceTick == SourceTick && Source.ID == ID)
+		{
+			RemoveProjectile(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 UProjectileSimulationSubsystem::GetNewAuthorityProjectileID(const int32 Count)
+{
+	//Wrap back to zero before the volley's IDs would overflow.
+	if (NextAuthorityProjectileID > MAX_int32 - Count)
+	{
+		NextAuthorityProjectileID = 0;
+	}
+	const int32 FirstID = NextAuthorityProjectileID;
+	NextAuthorityProjectileID += Count;
+	return FirstID;
+}
+
+void UProjectileSimulationSubsystem::RemoveProjectile(const int32 Index)
+{
+	if (IsValid(Projectiles.Visuals[Index]))
+	{
+		Projectiles.Visuals[Index]->Destroy();
+	}
+	Projectiles.RemoveAtSwap(Index);
+}
+
+void UProjectileSimulationSubsystem::OnAbilityMispredicted(const int32 PredictionID)
+{
+	//Only the locally controlled player predicts, so every predicted projectile on this machine belongs to them.
+	for (int32 i = Projectiles.Num() - 1; i >= 0; i--)
+	{
+		const FProjectileSource& Source = Projectiles.Sources[i];
+		if (IsValid(Source.Owner) && Source.Owner->IsLocallyControlled() && !Source.Owner->HasAuthority() && Source.SourceTick.PredictionID == PredictionID)
+		{
+			RemoveProjectile(i);
+		}
+	}
+}
+
+#pragma endregion
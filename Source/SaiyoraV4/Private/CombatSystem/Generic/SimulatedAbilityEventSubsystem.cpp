@@ -0,0 +1,84 @@
+﻿#include "SimulatedAbilityEventSubsystem.h"
+#include "AbilityComponent.h"
+#include "SaiyoraPlayerController.h"
+#include "Engine/NetConnection.h"
+
+static TAutoConsoleVariable<int32> RelaySimulatedAbilityEvents(
+		TEXT("game.RelaySimulatedAbilityEvents"),
+		1,
+		TEXT("Sends simulated ability events as one filtered RPC per connection per frame instead of multicasting each event. 0 falls back to multicasts."),
+		ECVF_Default);
+
+static TAutoConsoleVariable<float> SimulatedAbilityEventRange(
+		TEXT("game.SimulatedAbilityEventRange"),
+		10000.0f,
+		TEXT("Simulated ability events from actors further than this from a player's camera are not sent to that player. 0 disables the distance check."),
+		ECVF_Default);
+
+TStatId USimulatedAbilityEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimulatedAbilityEventSubsystem, STATGROUP_Tickables);
+}
+
+bool USimulatedAbilityEventSubsystem::IsRelayEnabled() const
+{
+	return GetWorld()->GetNetMode() != NM_Client && RelaySimulatedAbilityEvents.GetValueOnGameThread() != 0;
+}
+
+void USimulatedAbilityEventSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingEvents.Num() == 0)
+	{
+		return;
+	}
+	const float MaxDistance = SimulatedAbilityEventRange.GetValueOnGameThread();
+	const float MaxDistanceSquared = MaxDistance > 0.0f ? FMath::Square(MaxDistance) : 0.0f;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		//Events are sent through the controller, so players without a pawn (spectating or waiting to respawn) still receive them.
+		ASaiyoraPlayerController* Receiver = Cast<ASaiyoraPlayerController>(It->Get());
+		//Local controllers already ran every event when it was queued.
+		if (!IsValid(Receiver) || Receiver->IsLocalController())
+		{
+			continue;
+		}
+		UNetConnection* Connection = Receiver->GetNetConnection();
+		if (!IsValid(Connection))
+		{
+			continue;
+		}
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		Receiver->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		
+		ConnectionEvents.Reset();
+		for (const TTuple<UAbilityComponent*, FSimulatedAbilityEvents>& Pending : PendingEvents)
+		{
+			AActor* SourceActor = IsValid(Pending.Key) ? Pending.Key->GetOwner() : nullptr;
+			if (!IsValid(SourceActor))
+			{
+				continue;
+			}
+			if (SourceActor->GetNetConnection() != Connection)
+			{
+				//If the net driver hasn't opened the source on this connection, the client couldn't resolve the ability references anyway.
+				if (!Connection->FindActorChannelRef(SourceActor))
+				{
+					continue;
+				}
+				if (MaxDistanceSquared > 0.0f && FVector::DistSquared(ViewLocation, SourceActor->GetActorLocation()) > MaxDistanceSquared)
+				{
+					continue;
+				}
+			}
+			ConnectionEvents.Append(Pending.Value);
+		}
+		if (!ConnectionEvents.IsEmpty())
+		{
+			Receiver->SendSimulatedAbilityEvents(ConnectionEvents);
+		}
+	}
+	PendingEvents.Reset();
+}
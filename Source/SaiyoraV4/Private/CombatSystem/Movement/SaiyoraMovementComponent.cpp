@@ -139,10 +139,11 @@ bool USaiyoraMovementComponent::FSaiyoraNetworkMoveData::Serialize(UCharacterMov
 	FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
 {
 	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
-	Ar << CustomMoveAbilityRequest;
+	bool bRequestSuccess = true;
+	CustomMoveAbilityRequest.NetSerialize(Ar, PackageMap, bRequestSuccess);
 	Ar << ServerMoveID;
 	Ar << ServerStatChangeID;
-	return !Ar.IsError();
+	return !Ar.IsError() && bRequestSuccess;
 }
 
 USaiyoraMovementComponent::FSaiyoraNetworkMoveDataContainer::FSaiyoraNetworkMoveDataContainer() : Super()
@@ -1,7 +1,9 @@
 ﻿#include "ChoiceRequirements.h"
 
+#include "AbilityFunctionLibrary.h"
 #include "Buff.h"
 #include "BuffHandler.h"
+#include "CombatStatusComponent.h"
 #include "SaiyoraCombatInterface.h"
 #include "TargetContexts.h"
 #include "ThreatHandler.h"
@@ -13,6 +15,26 @@ void FNPCChoiceRequirement::Init(AActor* NPC)
 {
 	OwningNPC = NPC;
 	SetupRequirement();
+	bDirty = true;
+}
+
+bool FNPCChoiceRequirement::IsMetCached()
+{
+	if (bDirty || EnumHasAnyFlags(GetInvalidationSources(), ENPCRequirementInvalidation::Always) || NeedsReevaluation())
+	{
+		bCachedMet = IsMet();
+		bDirty = false;
+		OnEvaluated(bCachedMet);
+	}
+	return bCachedMet;
+}
+
+void FNPCChoiceRequirement::Invalidate(const ENPCRequirementInvalidation Source)
+{
+	if (EnumHasAnyFlags(GetInvalidationSources(), Source))
+	{
+		bDirty = true;
+	}
 }
 
 #pragma endregion 
@@ -38,6 +60,17 @@ void FNPCCR_TimeInCombat::SetupRequirement()
 	ThreatHandler = ISaiyoraCombatInterface::Execute_GetThreatHandler(Owner);
 }
 
+bool FNPCCR_TimeInCombat::NeedsReevaluation() const
+{
+	return ReevaluateAtCombatTime >= 0.0f && IsValid(ThreatHandler) && ThreatHandler->GetCombatTime() > ReevaluateAtCombatTime;
+}
+
+void FNPCCR_TimeInCombat::OnEvaluated(const bool bMet)
+{
+	//The result flips once when combat time passes the requirement, then stays the same until combat restarts.
+	ReevaluateAtCombatTime = IsValid(ThreatHandler) && ThreatHandler->GetCombatTime() <= TimeRequirement ? TimeRequirement : -1.0f;
+}
+
 #pragma endregion
 #pragma region Range Of Target
 
@@ -56,7 +89,66 @@ bool FNPCCR_RangeOfTarget::IsMet() const
 	const float DistSqToTarget = bIncludeZDistance ? FVector::DistSquared(Target->GetActorLocation(), GetOwningNPC()->GetActorLocation())
 		: FVector::DistSquared2D(Target->GetActorLocation(), GetOwningNPC()->GetActorLocation());
 	const float ClampedRangeSq = FMath::Square(FMath::Max(0.0f, Range));
-	return bWithinRange ? DistSqToTarget < ClampedRangeSq : DistSqToTarget >= ClampedRangeSq;
+	const bool bRangeMet = bWithinRange ? DistSqToTarget < ClampedRangeSq : DistSqToTarget >= ClampedRangeSq;
+	if (!bRangeMet || !bRequireLineOfSight)
+	{
+		return bRangeMet;
+	}
+	//Many NPCs checking the same target in a frame share traces through the line of sight subsystem.
+	const UCombatStatusComponent* CombatStatus = GetOwningNPC()->Implements<USaiyoraCombatInterface>()
+		? ISaiyoraCombatInterface::Execute_GetCombatStatusComponent(GetOwningNPC()) : nullptr;
+	const ESaiyoraPlane Plane = IsValid(CombatStatus) ? CombatStatus->GetCurrentPlane() : ESaiyoraPlane::Both;
+	return UAbilityFunctionLibrary::CheckLineOfSightInPlane(GetOwningNPC(), GetOwningNPC()->GetActorLocation(), Target->GetActorLocation(), Plane);
+}
+
+ENPCRequirementInvalidation FNPCCR_RangeOfTarget::GetInvalidationSources() const
+{
+	const FNPCTargetContext* Context = TargetContext.GetPtr<FNPCTargetContext>();
+	//Contexts like closest target can change without any event, so those have to be checked every time.
+	if (!Context || !Context->ChangesOnlyWithThreatTarget())
+	{
+		return ENPCRequirementInvalidation::Always;
+	}
+	return ENPCRequirementInvalidation::TargetChange | ENPCRequirementInvalidation::Movement;
+}
+
+bool FNPCCR_RangeOfTarget::NeedsReevaluation() const
+{
+	const AActor* Target = LastTarget.Get();
+	if (!IsValid(Target) || !IsValid(GetOwningNPC()))
+	{
+		return true;
+	}
+	const float OwnerMoved = bIncludeZDistance ? FVector::Dist(GetOwningNPC()->GetActorLocation(), LastOwnerLocation)
+		: FVector::Dist2D(GetOwningNPC()->GetActorLocation(), LastOwnerLocation);
+	const float TargetMoved = bIncludeZDistance ? FVector::Dist(Target->GetActorLocation(), LastTargetLocation)
+		: FVector::Dist2D(Target->GetActorLocation(), LastTargetLocation);
+	//Line of sight can change with any movement, so the distance threshold only applies to pure range checks.
+	if (bRequireLineOfSight && (OwnerMoved > 0.0f || TargetMoved > 0.0f))
+	{
+		return true;
+	}
+	return OwnerMoved + TargetMoved >= DistanceToThreshold;
+}
+
+void FNPCCR_RangeOfTarget::OnEvaluated(const bool bMet)
+{
+	LastTarget = nullptr;
+	const FNPCTargetContext* Context = TargetContext.GetPtr<FNPCTargetContext>();
+	if (!Context || !IsValid(GetOwningNPC()))
+	{
+		return;
+	}
+	AActor* Target = Context->GetBestTarget(GetOwningNPC());
+	if (!IsValid(Target))
+	{
+		return;
+	}
+	LastTarget = Target;
+	LastOwnerLocation = GetOwningNPC()->GetActorLocation();
+	LastTargetLocation = Target->GetActorLocation();
+	const float Distance = bIncludeZDistance ? FVector::Dist(LastTargetLocation, LastOwnerLocation) : FVector::Dist2D(LastTargetLocation, LastOwnerLocation);
+	DistanceToThreshold = FMath::Abs(Distance - FMath::Max(0.0f, Range));
 }
 
 #pragma endregion
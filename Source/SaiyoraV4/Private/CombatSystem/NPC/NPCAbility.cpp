@@ -14,18 +14,20 @@ void UNPCAbility::PostInitializeAbility_Implementation()
 		
 		TokenCallback.BindDynamic(this, &UNPCAbility::OnTokenAvailabilityChanged);
 		NPCSubsystemRef->InitTokensForAbilityClass(GetClass(), TokenCallback);
-		UpdateCastable();
+		SetCastFailReason(ECastFailReason::Token, !NPCSubsystemRef->IsAbilityTokenAvailable(this));
 	}
 }
 
-void UNPCAbility::AdditionalCastableUpdate(TArray<ECastFailReason>& AdditionalFailReasons)
+void UNPCAbility::AdditionalCastableUpdate()
 {
-	Super::AdditionalCastableUpdate(AdditionalFailReasons);
+	Super::AdditionalCastableUpdate();
 
-	if (bUseTokens && (!IsValid(NPCSubsystemRef) || !NPCSubsystemRef->IsAbilityTokenAvailable(this)))
-	{
-		AdditionalFailReasons.AddUnique(ECastFailReason::Token);
-	}
+	SetCastFailReason(ECastFailReason::Token, bUseTokens && (!IsValid(NPCSubsystemRef) || !NPCSubsystemRef->IsAbilityTokenAvailable(this)));
+}
+
+void UNPCAbility::OnTokenAvailabilityChanged(const bool bAvailable)
+{
+	SetCastFailReason(ECastFailReason::Token, !IsValid(NPCSubsystemRef) || !NPCSubsystemRef->IsAbilityTokenAvailable(this));
 }
 
 void UNPCAbility::OnServerCastStart_Implementation()
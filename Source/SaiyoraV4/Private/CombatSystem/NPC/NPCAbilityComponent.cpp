@@ -1,5 +1,6 @@
 ﻿#include "NPCAbilityComponent.h"
 
+#include "BuffHandler.h"
 #include "CombatDebugOptions.h"
 #include "CombatLink.h"
 #include "DamageHandler.h"
@@ -62,6 +63,13 @@ void UNPCAbilityComponent::BeginPlay()
 	if (IsValid(ThreatHandlerRef))
 	{
 		ThreatHandlerRef->OnCombatChanged.AddDynamic(this, &UNPCAbilityComponent::OnCombatChanged);
+		ThreatHandlerRef->OnTargetChanged.AddDynamic(this, &UNPCAbilityComponent::OnThreatTargetChanged);
+	}
+	UBuffHandler* BuffHandler = ISaiyoraCombatInterface::Execute_GetBuffHandler(GetOwner());
+	if (IsValid(BuffHandler))
+	{
+		BuffHandler->OnIncomingBuffApplied.AddDynamic(this, &UNPCAbilityComponent::OnBuffApplied);
+		BuffHandler->OnIncomingBuffRemoved.AddDynamic(this, &UNPCAbilityComponent::OnBuffRemoved);
 	}
 	OnControllerChanged(OwnerAsPawn, nullptr, OwnerAsPawn->GetController());
 
@@ -72,6 +80,18 @@ void UNPCAbilityComponent::BeginPlay()
 	}
 }
 
+void UNPCAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	//The subsystem keys pending decisions on this component, so clear them out before it can be destroyed and its address reused.
+	if (IsValid(NPCSubsystemRef))
+	{
+		NPCSubsystemRef->CancelDecision(this, ENPCDecisionType::RunQuery);
+		NPCSubsystemRef->CancelDecision(this, ENPCDecisionType::SelectChoice);
+		NPCSubsystemRef->FreeLocation(GetOwner());
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 void UNPCAbilityComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -402,11 +422,7 @@ void UNPCAbilityComponent::SetQuery(UEnvQuery* Query, const TArray<FInstancedStr
 			CurrentQueryParams.Add(Param);
 		}
 	}
-	if (GetWorld()->GetTimerManager().IsTimerActive(QueryRetryHandle))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(QueryRetryHandle);
-	}
-	RunQuery();
+	NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::RunQuery, 0.0f);
 }
 
 void UNPCAbilityComponent::RunQuery()
@@ -430,7 +446,7 @@ void UNPCAbilityComponent::RunQuery()
 	QueryID = Request.Execute(EEnvQueryRunMode::SingleResult, this, &UNPCAbilityComponent::OnQueryFinished);
 	if (QueryID == INDEX_NONE)
 	{
-		GetWorld()->GetTimerManager().SetTimer(QueryRetryHandle, this, &UNPCAbilityComponent::RunQuery, GetQueryRetryDelay());
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::RunQuery, GetQueryRetryDelay());
 	}
 }
 
@@ -464,7 +480,7 @@ void UNPCAbilityComponent::OnQueryFinished(TSharedPtr<FEnvQueryResult> QueryResu
 	//Reset variable and start the retry timer for the next query.
 	QueryID = INDEX_NONE;
 	LastQueryBehavior = ENPCCombatBehavior::None;
-	GetWorld()->GetTimerManager().SetTimer(QueryRetryHandle, this, &UNPCAbilityComponent::RunQuery, GetQueryRetryDelay());
+	NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::RunQuery, GetQueryRetryDelay());
 }
 
 void UNPCAbilityComponent::AbortActiveQuery()
@@ -483,14 +499,30 @@ void UNPCAbilityComponent::AbortActiveQuery()
 #pragma endregion 
 #pragma region Combat
 
+void UNPCAbilityComponent::RunScheduledDecision(const ENPCDecisionType DecisionType)
+{
+	switch (DecisionType)
+	{
+	case ENPCDecisionType::SelectChoice :
+		TrySelectNewChoice();
+		break;
+	case ENPCDecisionType::RunQuery :
+		RunQuery();
+		break;
+	default :
+		break;
+	}
+}
+
 void UNPCAbilityComponent::EnterCombatState()
 {
 	SetComponentTickEnabled(true);
 	NPCSubsystemRef->ClaimLocation(GetOwner(), GetOwner()->GetActorLocation());
 	InitCombatChoices();
+	//Choice selection and the first query go through the NPC subsystem's scheduler, so that large pulls don't all evaluate on the same frame.
 	if (CombatPriority.Num() > 0)
 	{
-		TrySelectNewChoice();
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, 0.0f);
 	}
 	QueryRetryRandomSeed = GenerateQueryRetryRandomSeed();
 	SetQuery(DefaultQuery, DefaultQueryParams);
@@ -502,16 +534,24 @@ void UNPCAbilityComponent::InitCombatChoices()
 	{
 		CombatChoice.Init(this);
 	}
+	//Anything could have changed while out of combat, so start each combat with every requirement dirty.
+	InvalidateChoiceRequirements(ENPCRequirementInvalidation::Always | ENPCRequirementInvalidation::CombatTime | ENPCRequirementInvalidation::Buffs
+		| ENPCRequirementInvalidation::TargetChange | ENPCRequirementInvalidation::Movement);
+}
+
+void UNPCAbilityComponent::InvalidateChoiceRequirements(const ENPCRequirementInvalidation Source)
+{
+	for (FNPCCombatChoice& CombatChoice : CombatPriority)
+	{
+		CombatChoice.InvalidateRequirements(Source);
+	}
 }
 
 void UNPCAbilityComponent::TrySelectNewChoice()
 {
 	bWaitingOnMovementStop = false;
 	QueuedChoiceIdx = -1;
-	if (GetWorld()->GetTimerManager().IsTimerActive(ChoiceRetryHandle))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(ChoiceRetryHandle);
-	}
+	NPCSubsystemRef->CancelDecision(this, ENPCDecisionType::SelectChoice);
 	//Find the highest priority choice.
 	int ChoiceIdx = -1;
 	for (int i = 0; i < CombatPriority.Num(); i++)
@@ -526,7 +566,7 @@ void UNPCAbilityComponent::TrySelectNewChoice()
 	if (ChoiceIdx == -1)
 	{
 		//If we failed to find a valid choice, we will try again in a bit.
-		GetWorld()->GetTimerManager().SetTimer(ChoiceRetryHandle, this, &UNPCAbilityComponent::TrySelectNewChoice, ChoiceRetryDelay);
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, ChoiceRetryDelay);
 		return;
 	}
 
@@ -534,7 +574,7 @@ void UNPCAbilityComponent::TrySelectNewChoice()
 	if (!IsValid(AbilityInstance))
 	{
 		//If we failed to find a valid choice, we will try again in a bit.
-		GetWorld()->GetTimerManager().SetTimer(ChoiceRetryHandle, this, &UNPCAbilityComponent::TrySelectNewChoice, ChoiceRetryDelay);
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, ChoiceRetryDelay);
 		return;
 	}
 	if (!AbilityInstance->IsCastableWhileMoving())
@@ -550,7 +590,7 @@ void UNPCAbilityComponent::TrySelectNewChoice()
 				if (!bGotToken)
 				{
 					//If we failed to get a token for the ability, we will try again in a bit.
-					GetWorld()->GetTimerManager().SetTimer(ChoiceRetryHandle, this, &UNPCAbilityComponent::TrySelectNewChoice, ChoiceRetryDelay);
+					NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, ChoiceRetryDelay);
 					return;
 				}
 				PossessedToken = AbilityInstance;
@@ -570,7 +610,7 @@ void UNPCAbilityComponent::TrySelectNewChoice()
 	else
 	{
 		//After casting this ability, we'll select another choice in a little bit.
-		GetWorld()->GetTimerManager().SetTimer(ChoiceRetryHandle, this, &UNPCAbilityComponent::TrySelectNewChoice, ChoiceRetryDelay);
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, ChoiceRetryDelay);
 		SetWantsToMove(true);
 	}
 }
@@ -616,7 +656,7 @@ void UNPCAbilityComponent::TryUseQueuedAbility(AActor* Actor, const bool bNewMov
 			PossessedToken = nullptr;
 		}
 		//After casting this ability, we'll select another choice in a little bit.
-		GetWorld()->GetTimerManager().SetTimer(ChoiceRetryHandle, this, &UNPCAbilityComponent::TrySelectNewChoice, ChoiceRetryDelay);
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, ChoiceRetryDelay);
 		SetWantsToMove(true);
 	}
 }
@@ -626,7 +666,7 @@ void UNPCAbilityComponent::EndChoiceOnCastStateChanged(const FCastingState& Prev
 	if (!New.bIsCasting)
 	{
 		OnCastStateChanged.RemoveDynamic(this, &UNPCAbilityComponent::EndChoiceOnCastStateChanged);
-		GetWorld()->GetTimerManager().SetTimer(ChoiceRetryHandle, this, &UNPCAbilityComponent::TrySelectNewChoice, ChoiceRetryDelay);
+		NPCSubsystemRef->ScheduleDecision(this, ENPCDecisionType::SelectChoice, ChoiceRetryDelay);
 		SetWantsToMove(true);
 	}
 }
@@ -647,16 +687,9 @@ void UNPCAbilityComponent::LeaveCombatState()
 		CancelCurrentCast();
 	}
 	AbortActiveQuery();
-	//Stop the query retry timer.
-	if (GetWorld()->GetTimerManager().IsTimerActive(QueryRetryHandle))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(QueryRetryHandle);
-	}
-	//Stop the choice selection retry timer.
-	if (GetWorld()->GetTimerManager().IsTimerActive(ChoiceRetryHandle))
-	{
-		GetWorld()->GetTimerManager().ClearTimer(ChoiceRetryHandle);
-	}
+	//Stop any pending query or choice selection.
+	NPCSubsystemRef->CancelDecision(this, ENPCDecisionType::RunQuery);
+	NPCSubsystemRef->CancelDecision(this, ENPCDecisionType::SelectChoice);
 	NPCSubsystemRef->FreeLocation(GetOwner());
 }
 
@@ -21,32 +21,66 @@ void FNPCCombatChoice::Init(UNPCAbilityComponent* AbilityComponent)
 		CastRequirement->Init(AbilityComponent->GetOwner());
 	}
 	bInitialized = true;
+	bRequirementsDirty = true;
+	bHasPolledRequirements = false;
+	const ENPCRequirementInvalidation PolledSources = ENPCRequirementInvalidation::Always | ENPCRequirementInvalidation::CombatTime | ENPCRequirementInvalidation::Movement;
+	for (const FInstancedStruct& InstancedRequirement : Requirements)
+	{
+		const FNPCChoiceRequirement* Requirement = InstancedRequirement.GetPtr<FNPCChoiceRequirement>();
+		if (Requirement && EnumHasAnyFlags(Requirement->GetInvalidationSources(), PolledSources))
+		{
+			bHasPolledRequirements = true;
+			break;
+		}
+	}
 }
 
-bool FNPCCombatChoice::IsChoiceValid() const
+bool FNPCCombatChoice::IsChoiceValid()
 {
 	const UCombatAbility* AbilityInstance = OwningComponentRef->FindActiveAbility(AbilityClass);
 	if (!IsValid(AbilityInstance))
 	{
 		return false;
 	}
-	TArray<ECastFailReason> FailReasons;
-	bool bIsCastable = AbilityInstance->IsCastable(FailReasons);
 	//We will say the choice is valid even if the ability isn't castable, if the reason it's not castable is because of movement.
 	//We will stop our movement before casting the ability, so this shouldn't matter.
 	//TODO: This should check whether we are moving of our own volition or because of an external move (or gravity?).
-	bIsCastable = bIsCastable || FailReasons.Num() == 1 && FailReasons[0] == ECastFailReason::Moving;
-	if (!bIsCastable)
+	if ((AbilityInstance->GetCastFailMask() & ~UCombatAbility::CastFailBit(ECastFailReason::Moving)) != 0)
 	{
 		return false;
 	}
-	for (const FInstancedStruct& InstancedRequirement : Requirements)
+	return AreRequirementsMet();
+}
+
+void FNPCCombatChoice::InvalidateRequirements(const ENPCRequirementInvalidation Source)
+{
+	for (FInstancedStruct& InstancedRequirement : Requirements)
 	{
-		const FNPCChoiceRequirement* Requirement = InstancedRequirement.GetPtr<FNPCChoiceRequirement>();
-		if (Requirement && !Requirement->IsMet())
+		if (FNPCChoiceRequirement* Requirement = InstancedRequirement.GetMutablePtr<FNPCChoiceRequirement>())
+		{
+			Requirement->Invalidate(Source);
+			bRequirementsDirty = bRequirementsDirty || EnumHasAnyFlags(Requirement->GetInvalidationSources(), Source);
+		}
+	}
+}
+
+bool FNPCCombatChoice::AreRequirementsMet()
+{
+	//If every requirement is event-driven and nothing has fired since the last check, the cached result is still correct.
+	if (!bRequirementsDirty && !bHasPolledRequirements)
+	{
+		return bRequirementsMet;
+	}
+	bRequirementsMet = true;
+	for (FInstancedStruct& InstancedRequirement : Requirements)
+	{
+		FNPCChoiceRequirement* Requirement = InstancedRequirement.GetMutablePtr<FNPCChoiceRequirement>();
+		if (Requirement && !Requirement->IsMetCached())
 		{
-			return false;		
+			bRequirementsMet = false;
+			break;
 		}
 	}
-	return true;
+	bRequirementsDirty = false;
+	return bRequirementsMet;
 }
\ No newline at end of file
@@ -1,8 +1,21 @@
 ﻿#include "NPCSubsystem.h"
 #include "CombatDebugOptions.h"
 #include "NPCAbility.h"
+#include "NPCAbilityComponent.h"
 #include "SaiyoraGameInstance.h"
 
+static TAutoConsoleVariable<float> NPCDecisionBudget(
+		TEXT("game.NPCDecisionBudgetMicroseconds"),
+		250.0f,
+		TEXT("Per-frame time budget for running scheduled NPC choice selections and queries. At least one decision always runs per frame. 0 limits decisions by game.NPCMaxDecisionsPerFrame instead."),
+		ECVF_Default);
+
+static TAutoConsoleVariable<int32> NPCMaxDecisionsPerFrame(
+		TEXT("game.NPCMaxDecisionsPerFrame"),
+		8,
+		TEXT("Number of scheduled NPC decisions run per frame when game.NPCDecisionBudgetMicroseconds is 0."),
+		ECVF_Default);
+
 TStatId UNPCSubsystem::GetStatId() const
 {
 	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCSubsystem, STATGROUP_Tickables);
@@ -23,6 +36,8 @@ void UNPCSubsystem::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	RunScheduledDecisions();
+
 	//Debug options for NPC systems.
 	if (IsValid(DebugOptions))
 	{
@@ -45,7 +60,12 @@ void UNPCSubsystem::ClaimLocation(AActor* Actor, const FVector& Location)
 	{
 		return;
 	}
+	if (const FVector* PreviousLocation = ClaimedLocations.Find(Actor))
+	{
+		RemoveFromClaimedLocationGrid(Actor, *PreviousLocation);
+	}
 	ClaimedLocations.Add(Actor, Location);
+	ClaimedLocationGrid.FindOrAdd(GetClaimedLocationCell(Location)).Add(Actor);
 }
 
 void UNPCSubsystem::FreeLocation(AActor* Actor)
@@ -54,25 +74,131 @@ void UNPCSubsystem::FreeLocation(AActor* Actor)
 	{
 		return;
 	}
-	ClaimedLocations.Remove(Actor);
+	FVector PreviousLocation;
+	if (ClaimedLocations.RemoveAndCopyValue(Actor, PreviousLocation))
+	{
+		RemoveFromClaimedLocationGrid(Actor, PreviousLocation);
+	}
+}
+
+FIntPoint UNPCSubsystem::GetClaimedLocationCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / ClaimedLocationRadius), FMath::FloorToInt32(Location.Y / ClaimedLocationRadius));
+}
+
+void UNPCSubsystem::RemoveFromClaimedLocationGrid(AActor* Actor, const FVector& Location)
+{
+	const FIntPoint Cell = GetClaimedLocationCell(Location);
+	TArray<TWeakObjectPtr<AActor>>* CellActors = ClaimedLocationGrid.Find(Cell);
+	if (!CellActors)
+	{
+		return;
+	}
+	CellActors->RemoveSingleSwap(Actor);
+	if (CellActors->Num() == 0)
+	{
+		ClaimedLocationGrid.Remove(Cell);
+	}
 }
 
 float UNPCSubsystem::GetScorePenaltyForLocation(const AActor* Actor, const FVector& Location) const
 {
 	float Penalty = 0.0f;
-	for (const TTuple<AActor*, FVector>& ClaimedTuple : ClaimedLocations)
+	//Cells are the size of the penalty radius, so any claim within range has to be in this cell or one of its neighbors.
+	const FIntPoint CenterCell = GetClaimedLocationCell(Location);
+	for (int32 X = -1; X <= 1; X++)
 	{
-		if (!IsValid(ClaimedTuple.Key) || (IsValid(Actor) && ClaimedTuple.Key == Actor))
+		for (int32 Y = -1; Y <= 1; Y++)
+		{
+			const TArray<TWeakObjectPtr<AActor>>* CellActors = ClaimedLocationGrid.Find(CenterCell + FIntPoint(X, Y));
+			if (!CellActors)
+			{
+				continue;
+			}
+			for (const TWeakObjectPtr<AActor>& ClaimingActor : *CellActors)
+			{
+				if (!ClaimingActor.IsValid() || (IsValid(Actor) && ClaimingActor.Get() == Actor))
+				{
+					continue;
+				}
+				const FVector* ClaimedLocation = ClaimedLocations.Find(ClaimingActor.Get());
+				if (!ClaimedLocation)
+				{
+					continue;
+				}
+				const float DistSq = FVector::DistSquared(Location, *ClaimedLocation);
+				if (DistSq < FMath::Square(ClaimedLocationRadius))
+				{
+					Penalty -= (1.0f - (FMath::Sqrt(DistSq) / ClaimedLocationRadius));
+				}
+			}
+		}
+	}
+	return Penalty;
+}
+
+#pragma endregion
+#pragma region Decision Scheduling
+
+void UNPCSubsystem::ScheduleDecision(UNPCAbilityComponent* Component, const ENPCDecisionType DecisionType, const float Delay)
+{
+	if (!IsValid(Component))
+	{
+		return;
+	}
+	FNPCScheduledDecision Decision;
+	Decision.Component = Component;
+	Decision.DecisionType = DecisionType;
+	Decision.ReadyTime = GetWorld()->GetTimeSeconds() + FMath::Max(0.0f, Delay);
+	Decision.Sequence = NextDecisionSequence++;
+	ActiveDecisions.Add(TPair<const UNPCAbilityComponent*, ENPCDecisionType>(Component, DecisionType), Decision.Sequence);
+	DecisionQueue.HeapPush(Decision);
+}
+
+void UNPCSubsystem::CancelDecision(const UNPCAbilityComponent* Component, const ENPCDecisionType DecisionType)
+{
+	//The queue entry is left in place and skipped when it comes up.
+	ActiveDecisions.Remove(TPair<const UNPCAbilityComponent*, ENPCDecisionType>(Component, DecisionType));
+}
+
+void UNPCSubsystem::RunScheduledDecisions()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const float BudgetMicroseconds = NPCDecisionBudget.GetValueOnGameThread();
+	const int32 MaxDecisions = FMath::Max(1, NPCMaxDecisionsPerFrame.GetValueOnGameThread());
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	//Decisions scheduled while running this frame's decisions wait until next frame, even with no delay.
+	const uint64 SequenceLimit = NextDecisionSequence;
+	int32 DecisionsRun = 0;
+	while (DecisionQueue.Num() > 0 && DecisionQueue.HeapTop().ReadyTime <= CurrentTime && DecisionQueue.HeapTop().Sequence < SequenceLimit)
+	{
+		if (DecisionsRun > 0)
+		{
+			//Decision cost varies a lot between choice requirements and queries, so time is the main limit. The count is only used if the budget is disabled.
+			const bool bOverBudget = BudgetMicroseconds > 0.0f
+				? FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 >= BudgetMicroseconds
+				: DecisionsRun >= MaxDecisions;
+			if (bOverBudget)
+			{
+				break;
+			}
+		}
+		FNPCScheduledDecision Decision;
+		DecisionQueue.HeapPop(Decision, false);
+		UNPCAbilityComponent* Component = Decision.Component.Get();
+		const TPair<const UNPCAbilityComponent*, ENPCDecisionType> Key (Component, Decision.DecisionType);
+		const uint64* ActiveSequence = ActiveDecisions.Find(Key);
+		if (!ActiveSequence || *ActiveSequence != Decision.Sequence)
 		{
 			continue;
 		}
-		const float DistSq = FVector::DistSquared(Location, ClaimedTuple.Value);
-		if (DistSq < FMath::Square(200.0f))
+		ActiveDecisions.Remove(Key);
+		if (IsValid(Component))
 		{
-			Penalty -= (1.0f - (FMath::Sqrt(DistSq) / 200.0f));
+			Component->RunScheduledDecision(Decision.DecisionType);
+			DecisionsRun++;
 		}
 	}
-	return Penalty;
 }
 
 #pragma endregion
@@ -4,6 +4,7 @@
 #include "UnrealNetwork.h"
 #include "CombatAbility.h"
 #include "SaiyoraCombatInterface.h"
+#include "GameFramework/GameStateBase.h"
 
 #pragma region Initialization and Deactivation
 
@@ -32,13 +33,12 @@ void UResource::PostNetReceive()
     }
     if (IsValid(Handler))
     {
-        if (Handler->GetOwnerRole() == ROLE_AutonomousProxy)
-        {
-            PredictedResourceValue = ResourceState.CurrentValue;
-        }
+        LocalState = ResourceState;
+        LocalState.CurrentValue = GetCurrentValue();
         PreInitializeResource();
         bInitialized = true;
         Handler->NotifyOfReplicatedResource(this);
+        UpdateRegenerationTicking();
     }
 }
 
@@ -56,6 +56,8 @@ void UResource::InitializeResource(UResourceHandler* NewHandler, const FResource
     ResourceState.Maximum = FMath::Max(1.0f, InitInfo.bHasCustomMaximum ? InitInfo.CustomMaxValue : DefaultMaximum);
     ResourceState.CurrentValue = FMath::Clamp(InitInfo.bHasCustomInitial ? InitInfo.CustomInitialValue : DefaultValue, 0.0f, ResourceState.Maximum);
     ResourceState.PredictionID = 0;
+    ResourceState.RegenRate = DefaultRegenRate;
+    ResourceState.RegenStartTime = GetServerWorldTime();
 
     //Bind the resource maximum to a stat if needed.
     if (MaximumBindStat.IsValid() && MaximumBindStat.MatchesTag(FSaiyoraCombatTags::Get().Stat))
@@ -67,9 +69,21 @@ void UResource::InitializeResource(UResourceHandler* NewHandler, const FResource
             UpdateMaximumFromStatBind(MaximumBindStat, StatHandlerRef->GetStatValue(MaximumBindStat));
         }
     }
+    //Bind the regen rate to a stat if needed.
+    if (RegenRateBindStat.IsValid() && RegenRateBindStat.MatchesTag(FSaiyoraCombatTags::Get().Stat))
+    {
+        if (IsValid(StatHandlerRef) && StatHandlerRef->IsStatValid(RegenRateBindStat))
+        {
+            RegenStatBind.BindDynamic(this, &UResource::UpdateRegenRateFromStatBind);
+            StatHandlerRef->SubscribeToStatChanged(RegenRateBindStat, RegenStatBind);
+            UpdateRegenRateFromStatBind(RegenRateBindStat, StatHandlerRef->GetStatValue(RegenRateBindStat));
+        }
+    }
+    LocalState = ResourceState;
     
     PreInitializeResource();
     bInitialized = true;
+    UpdateRegenerationTicking();
 }
 
 void UResource::DeactivateResource()
@@ -97,7 +111,12 @@ void UResource::OnRep_Deactivated()
 
 float UResource::GetCurrentValue() const
 {
-    return Handler->GetOwnerRole() == ROLE_AutonomousProxy ? PredictedResourceValue : ResourceState.CurrentValue;
+    const float ServerValue = ResourceState.RegenRate == 0.0f ? ResourceState.CurrentValue : ResourceState.GetValueAtTime(GetServerWorldTime());
+    if (IsValid(Handler) && Handler->GetOwnerRole() == ROLE_AutonomousProxy && ResourcePredictions.Num() > 0)
+    {
+        return FMath::Clamp(ServerValue - ResourcePredictions.GetTotalCost(), 0.0f, ResourceState.Maximum);
+    }
+    return ServerValue;
 }
 
 void UResource::ModifyResource(UObject* Source, const float Amount, const bool bIgnoreModifiers)
@@ -110,10 +129,9 @@ void UResource::ModifyResource(UObject* Source, const float Amount, const bool b
     if (!bIgnoreModifiers)
     {
         TArray<FCombatModifier> Mods;
-        ResourceDeltaMods.GetModifiers(Mods, this, Source, Amount);
-        Delta = FCombatModifier::ApplyModifiers(Mods, Delta);
+        Delta = ResourceDeltaMods.GetModifiedValue(Delta, Mods, this, Source, Amount);
     }
-    SetResourceValue(ResourceState.CurrentValue + Delta, Source);
+    SetResourceValue(GetCurrentValue() + Delta, Source);
 }
 
 void UResource::SetResourceValue(const float NewValue, UObject* Source, const int32 PredictionID)
@@ -122,27 +140,56 @@ void UResource::SetResourceValue(const float NewValue, UObject* Source, const in
     {
         return;
     }
-    const FResourceState PreviousState = ResourceState;
-    ResourceState.CurrentValue = FMath::Clamp(NewValue, 0.0f, ResourceState.Maximum);
+    const float ClampedValue = FMath::Clamp(NewValue, 0.0f, ResourceState.Maximum);
+    //Only touch the regen timestamp while regenerating, so static resources don't replicate a new time with every change.
+    if (ResourceState.RegenRate != 0.0f)
+    {
+        ResourceState.RegenStartTime = GetServerWorldTime();
+    }
+    ResourceState.CurrentValue = ClampedValue;
     //This function is only called on the server, so we update the prediction ID that last modified this resource.
     //When the client receives this updated ID it can discard its old predictions from before this ID, and recalculate its predicted value.
     if (PredictionID != 0)
     {
         ResourceState.PredictionID = PredictionID;
     }
-    if (PreviousState.CurrentValue != ResourceState.CurrentValue)
+    NotifyLocalValueChanged(Source);
+    UpdateRegenerationTicking();
+}
+
+void UResource::SetRegenRate(const float NewRate)
+{
+    if (!IsValid(Handler) || Handler->GetOwnerRole() != ROLE_Authority || bDeactivated || ResourceState.RegenRate == NewRate)
+    {
+        return;
+    }
+    RebaseRegeneration();
+    ResourceState.RegenRate = NewRate;
+    ResourceState.RegenStartTime = GetServerWorldTime();
+    if (bInitialized)
     {
-        OnResourceChanged.Broadcast(this, Source, PreviousState, ResourceState);
-        PostResourceUpdated(Source, PreviousState);
+        UpdateRegenerationTicking();
     }
 }
 
+bool UResource::TickRegeneration()
+{
+    if (!bInitialized || bDeactivated || ResourceState.RegenRate == 0.0f)
+    {
+        return false;
+    }
+    NotifyLocalValueChanged(nullptr);
+    const float ServerValue = ResourceState.GetValueAtTime(GetServerWorldTime());
+    return ResourceState.RegenRate > 0.0f ? ServerValue < ResourceState.Maximum : ServerValue > 0.0f;
+}
+
 void UResource::UpdateMaximumFromStatBind(const FGameplayTag StatTag, const float NewValue)
 {
     if (Handler->GetOwnerRole() != ROLE_Authority || !StatTag.MatchesTagExact(MaximumBindStat) || bDeactivated)
     {
         return;
     }
+    RebaseRegeneration();
     const FResourceState PreviousState = ResourceState;
     ResourceState.Maximum = FMath::Max(NewValue, 1.0f);
     //Adjust the current value to accommodate for the new maximum.
@@ -164,92 +211,109 @@ void UResource::UpdateMaximumFromStatBind(const FGameplayTag StatTag, const floa
     }
     ResourceState.CurrentValue = FMath::Clamp(ResourceState.CurrentValue, 0.0f, ResourceState.Maximum);
     
-    if (bInitialized && PreviousState.Maximum != ResourceState.Maximum || PreviousState.CurrentValue != ResourceState.CurrentValue)
+    if (bInitialized)
+    {
+        NotifyLocalValueChanged(nullptr);
+        UpdateRegenerationTicking();
+    }
+}
+
+void UResource::UpdateRegenRateFromStatBind(const FGameplayTag StatTag, const float NewValue)
+{
+    if (Handler->GetOwnerRole() != ROLE_Authority || !StatTag.MatchesTagExact(RegenRateBindStat) || bDeactivated)
     {
-        OnResourceChanged.Broadcast(this, nullptr, PreviousState, ResourceState);
-        PostResourceUpdated(nullptr, PreviousState);
+        return;
     }
+    SetRegenRate(NewValue);
 }
 
-void UResource::OnRep_ResourceState(const FResourceState& PreviousState)
+void UResource::OnRep_ResourceState()
 {
     if (!bInitialized || bDeactivated || !IsValid(Handler))
     {
         return;
     }
-    //Predicting clients can recalculate their predicted value using the server's latest prediction ID and updated state.
+    //Predicting clients can discard predictions the server's latest prediction ID has already accounted for.
     if (Handler->GetOwnerRole() == ROLE_AutonomousProxy)
     {
-        PurgeOldPredictions();
-        RecalculatePredictedResource(nullptr);
+        ResourcePredictions.Purge(ResourceState.PredictionID);
     }
-    //Sim proxies can just fire off the OnResourceChangedDelegate.
-    else
+    NotifyLocalValueChanged(nullptr);
+    UpdateRegenerationTicking();
+}
+
+float UResource::GetServerWorldTime() const
+{
+    const UWorld* World = GetWorld();
+    if (!IsValid(World))
     {
-        if (PreviousState.Maximum != ResourceState.Maximum || PreviousState.CurrentValue != ResourceState.CurrentValue)
-        {
-            OnResourceChanged.Broadcast(this, nullptr, PreviousState, ResourceState);
-            PostResourceUpdated(nullptr, PreviousState);
-        }
+        return 0.0f;
     }
+    const AGameStateBase* GameState = World->GetGameState();
+    return IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
 }
 
-#pragma endregion
-#pragma region Ability Costs
-
-void UResource::CommitAbilityCost(UCombatAbility* Ability, const float Cost, const int32 PredictionID)
+void UResource::RebaseRegeneration()
 {
-    if (Handler->GetOwnerRole() == ROLE_Authority)
+    if (ResourceState.RegenRate == 0.0f)
     {
-        SetResourceValue(ResourceState.CurrentValue - Cost, Ability, PredictionID);
+        return;
     }
-    else if (Handler->GetOwnerRole() == ROLE_AutonomousProxy)
+    const float Now = GetServerWorldTime();
+    ResourceState.CurrentValue = ResourceState.GetValueAtTime(Now);
+    ResourceState.RegenStartTime = Now;
+}
+
+void UResource::UpdateRegenerationTicking()
+{
+    if (ResourceState.RegenRate != 0.0f && IsValid(Handler))
     {
-        ResourcePredictions.Add(PredictionID, Cost);
-        RecalculatePredictedResource(Ability);
+        Handler->NotifyOfRegeneratingResource();
     }
 }
 
-void UResource::UpdateCostPredictionFromServer(const int32 PredictionID, const float ServerCost)
+void UResource::NotifyLocalValueChanged(UObject* ChangeSource)
 {
-    //If replication was faster than the server ability ack RPC, we have already recalculated for this prediction ID.
-    if (ResourceState.PredictionID >= PredictionID)
+    if (!bInitialized)
     {
         return;
     }
-    //Adding to the prediction map will overwrite our original prediction with the server's value.
-    ResourcePredictions.Add(PredictionID, ServerCost);
-    RecalculatePredictedResource(nullptr);
+    const FResourceState PreviousState = LocalState;
+    LocalState = ResourceState;
+    LocalState.CurrentValue = GetCurrentValue();
+    if (PreviousState.Maximum != LocalState.Maximum || PreviousState.CurrentValue != LocalState.CurrentValue)
+    {
+        OnResourceChanged.Broadcast(this, ChangeSource, PreviousState, LocalState);
+        PostResourceUpdated(ChangeSource, PreviousState);
+    }
 }
 
-void UResource::RecalculatePredictedResource(UObject* ChangeSource)
+#pragma endregion
+#pragma region Ability Costs
+
+void UResource::CommitAbilityCost(UCombatAbility* Ability, const float Cost, const int32 PredictionID)
 {
-    const FResourceState PreviousState = FResourceState(ResourceState.Maximum, PredictedResourceValue);
-    //Start with the last replicated value from the server.
-    PredictedResourceValue = ResourceState.CurrentValue;
-    //Apply all predictions in order.
-    for (const TTuple<int32, float>& Prediction : ResourcePredictions)
+    if (Handler->GetOwnerRole() == ROLE_Authority)
     {
-        PredictedResourceValue = FMath::Clamp(PredictedResourceValue - Prediction.Value, 0.0f, ResourceState.Maximum);
+        SetResourceValue(GetCurrentValue() - Cost, Ability, PredictionID);
     }
-    if (PreviousState.CurrentValue != PredictedResourceValue)
+    else if (Handler->GetOwnerRole() == ROLE_AutonomousProxy)
     {
-        OnResourceChanged.Broadcast(this, ChangeSource, PreviousState, FResourceState(ResourceState.Maximum, PredictedResourceValue));
-        PostResourceUpdated(ChangeSource, PreviousState);
+        ResourcePredictions.Add(PredictionID, Cost);
+        NotifyLocalValueChanged(Ability);
     }
 }
 
-void UResource::PurgeOldPredictions()
+void UResource::UpdateCostPredictionFromServer(const int32 PredictionID, const float ServerCost)
 {
-    TArray<int32> Keys;
-    ResourcePredictions.GetKeys(Keys);
-    for (const int32 ID : Keys)
+    //If replication was faster than the server ability ack RPC, we have already recalculated for this prediction ID.
+    if (ResourceState.PredictionID >= PredictionID)
     {
-        if (ID <= ResourceState.PredictionID)
-        {
-            ResourcePredictions.Remove(ID);
-        }
+        return;
     }
+    //Adding to the prediction ring will overwrite our original prediction with the server's value.
+    ResourcePredictions.Add(PredictionID, ServerCost);
+    NotifyLocalValueChanged(nullptr);
 }
 
-#pragma endregion 
\ No newline at end of file
+#pragma endregion
\ No newline at end of file
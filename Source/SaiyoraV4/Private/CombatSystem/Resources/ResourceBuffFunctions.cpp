@@ -14,21 +14,52 @@ void UResourceDeltaModifierFunction::SetupBuffFunction()
 	if (IsValid(TargetHandler))
 	{
 		TargetResource = TargetHandler->FindActiveResource(ResourceClass);
-		Modifier.BindUFunction(GetOwningBuff(), ModifierFunctionName);
+		if (bIgnoresDeltaContext)
+		{
+			StaticModifier = FCombatModifier(StaticModifier.Value, StaticModifier.Type, GetOwningBuff(), StaticModifier.bStackable);
+		}
+		else
+		{
+			Modifier.BindUFunction(GetOwningBuff(), ModifierFunctionName);
+		}
 	}
 }
 
 void UResourceDeltaModifierFunction::OnApply(const FBuffApplyEvent& ApplyEvent)
 {
-	if (IsValid(TargetResource) && Modifier.IsBound())
+	if (!IsValid(TargetResource))
+	{
+		return;
+	}
+	if (bIgnoresDeltaContext)
+	{
+		StaticModifierHandle = TargetResource->AddStaticResourceDeltaModifier(StaticModifier);
+	}
+	else if (Modifier.IsBound())
 	{
 		TargetResource->AddResourceDeltaModifier(Modifier);
 	}
 }
 
+void UResourceDeltaModifierFunction::OnChange(const FBuffApplyEvent& ApplyEvent)
+{
+	if (IsValid(TargetResource) && bIgnoresDeltaContext && StaticModifier.bStackable && ApplyEvent.PreviousStacks != ApplyEvent.NewStacks)
+	{
+		TargetResource->UpdateStaticResourceDeltaModifier(StaticModifierHandle, StaticModifier);
+	}
+}
+
 void UResourceDeltaModifierFunction::OnRemove(const FBuffRemoveEvent& RemoveEvent)
 {
-	if (IsValid(TargetResource) && Modifier.IsBound())
+	if (!IsValid(TargetResource))
+	{
+		return;
+	}
+	if (bIgnoresDeltaContext)
+	{
+		TargetResource->RemoveStaticResourceDeltaModifier(StaticModifierHandle);
+	}
+	else if (Modifier.IsBound())
 	{
 		TargetResource->RemoveResourceDeltaModifier(Modifier);
 	}
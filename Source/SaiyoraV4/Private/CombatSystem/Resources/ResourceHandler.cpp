@@ -8,7 +8,9 @@
 
 UResourceHandler::UResourceHandler()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	//Ticking is only turned on while a resource is regenerating.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	SetIsReplicatedByDefault(true);
 	bWantsInitializeComponent = true;
 	bReplicateUsingRegisteredSubObjectList = true;
@@ -39,6 +41,31 @@ void UResourceHandler::InitializeComponent()
 	checkf(GetOwner()->Implements<USaiyoraCombatInterface>(), TEXT("Owner does not implement combat interface, but has Resource Handler."));
 }
 
+void UResourceHandler::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	//Regeneration broadcasts resource changes, and listeners can add or remove resources, so iterate over a copy.
+	const TArray<UResource*> TickingResources = ActiveResources;
+	bool bStillRegenerating = false;
+	for (UResource* Resource : TickingResources)
+	{
+		if (IsValid(Resource) && ActiveResources.Contains(Resource) && Resource->TickRegeneration())
+		{
+			bStillRegenerating = true;
+		}
+	}
+	//Resources added during this tick haven't been checked yet, so keep ticking for another frame to find out if they regenerate.
+	if (!bStillRegenerating && ActiveResources != TickingResources)
+	{
+		bStillRegenerating = true;
+	}
+	if (!bStillRegenerating)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
 void UResourceHandler::GetLifetimeReplicatedProps(::TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -121,6 +148,14 @@ void UResourceHandler::FinishRemoveResource(UResource* Resource)
 	RecentlyRemovedResources.Remove(Resource);
 }
 
+void UResourceHandler::NotifyOfRegeneratingResource()
+{
+	if (!IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
 void UResourceHandler::NotifyOfReplicatedResource(UResource* Resource)
 {
 	if (!IsValid(Resource) || IsValid(FindActiveResource(Resource->GetClass())))
@@ -1 +1,62 @@
-#include "ResourceStructs.h"
\ No newline at end of file
+#include "ResourceStructs.h"
+
+void FResourcePredictionRing::Add(const int32 PredictionID, const float Cost)
+{
+	//Predictions are almost always added or updated at the newest end, so search backwards.
+	int32 InsertIndex = Count;
+	for (int32 i = Count - 1; i >= 0; --i)
+	{
+		const int32 Slot = GetSlot(i);
+		if (PredictionIDs[Slot] == PredictionID)
+		{
+			TotalCost += Cost - Costs[Slot];
+			Costs[Slot] = Cost;
+			return;
+		}
+		if (PredictionIDs[Slot] < PredictionID)
+		{
+			break;
+		}
+		InsertIndex = i;
+	}
+	if (Count == Capacity)
+	{
+		//Too many unacked predictions. Dropping the oldest just means the client will see that cost late, once the server state arrives.
+		if (InsertIndex == 0)
+		{
+			return;
+		}
+		RemoveOldest();
+		InsertIndex--;
+	}
+	for (int32 i = Count; i > InsertIndex; --i)
+	{
+		PredictionIDs[GetSlot(i)] = PredictionIDs[GetSlot(i - 1)];
+		Costs[GetSlot(i)] = Costs[GetSlot(i - 1)];
+	}
+	PredictionIDs[GetSlot(InsertIndex)] = PredictionID;
+	Costs[GetSlot(InsertIndex)] = Cost;
+	Count++;
+	TotalCost += Cost;
+}
+
+void FResourcePredictionRing::Purge(const int32 AckedPredictionID)
+{
+	while (Count > 0 && PredictionIDs[Head] <= AckedPredictionID)
+	{
+		RemoveOldest();
+	}
+}
+
+void FResourcePredictionRing::RemoveOldest()
+{
+	TotalCost -= Costs[Head];
+	Head = (Head + 1) % Capacity;
+	Count--;
+	if (Count == 0)
+	{
+		//Reset the total so float error from adding and removing costs can't build up over a session.
+		Head = 0;
+		TotalCost = 0.0f;
+	}
+}
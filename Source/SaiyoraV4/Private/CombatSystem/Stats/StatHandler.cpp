@@ -22,6 +22,7 @@ void UStatHandler::InitializeComponent()
 	}
 	
 	checkf(GetOwner()->Implements<USaiyoraCombatInterface>(), TEXT("Owner does not implement combat interface, but has Stat Handler."));
+	DefaultStatLookup.Build(CombatStats);
 	if (GetOwnerRole() == ROLE_Authority)
 	{
 		//Copy the editor-exposed stats to a replicated array so that clients don't get duplicates.
@@ -37,6 +38,7 @@ void UStatHandler::InitializeComponent()
 			Stat.Init();
 			Stats.MarkItemDirty(Stat);
 		}
+		Stats.RebuildLookup();
 	}
 }
 
@@ -76,59 +78,31 @@ void UStatHandler::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
 
 bool UStatHandler::IsStatValid(const FGameplayTag StatTag) const
 {
-	if (StatTag.IsValid() && StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) && !StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
-	{
-		//We check the editor-exposed version of the stat instead of the actual replicated version because clients may not have the replicated ones on startup.
-		for (const FCombatStat& Stat : CombatStats)
-		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	//We check the editor-exposed version of the stat instead of the actual replicated version because clients may not have the replicated ones on startup.
+	return DefaultStatLookup.Find(StatTag) != INDEX_NONE;
 }
 
 float UStatHandler::GetStatValue(const FGameplayTag StatTag) const
 {
-	if (StatTag.IsValid() && StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) && !StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
+	if (const FCombatStat* Stat = Stats.FindStat(StatTag))
 	{
-		for (const FCombatStat& Stat : Stats.Items)
-		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				return Stat.GetCurrentValue();
-			}
-		}
-		//If we didn't find the stat value, check defaults. It's likely that if we are a client, we didn't get the replicated stat yet.
-		for (const FCombatStat& Stat : CombatStats)
-		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				return Stat.GetDefaultValue();
-			}
-		}
+		return Stat->GetCurrentValue();
+	}
+	//If we didn't find the stat value, check defaults. It's likely that if we are a client, we didn't get the replicated stat yet.
+	const int32 DefaultSlot = DefaultStatLookup.Find(StatTag);
+	if (CombatStats.IsValidIndex(DefaultSlot))
+	{
+		return CombatStats[DefaultSlot].GetDefaultValue();
 	}
 	return -1.0f;
 }
 
 bool UStatHandler::IsStatModifiable(const FGameplayTag StatTag) const
 {
-	if (StatTag.IsValid() && StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) && !StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
-	{
-		//Check the editor-exposed values, since clients may not have received the replicated values on startup.
-		for (const FCombatStat& Stat : CombatStats)
-		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				return Stat.IsModifiable();
-			}
-		}
-	}
-	return false;
+	//Check the editor-exposed values, since clients may not have received the replicated values on startup.
+	const int32 DefaultSlot = DefaultStatLookup.Find(StatTag);
+	return CombatStats.IsValidIndex(DefaultSlot) && CombatStats[DefaultSlot].IsModifiable();
 }
-
 #pragma endregion
 #pragma region Subscriptions
 
@@ -138,22 +112,14 @@ void UStatHandler::SubscribeToStatChanged(const FGameplayTag StatTag, const FSta
 	{
 		return;
 	}
-	bool bFound = false;
-	for (FCombatStat& Stat : Stats.Items)
+	if (FCombatStat* Stat = Stats.FindStat(StatTag))
 	{
-		if (Stat.StatTag.MatchesTagExact(StatTag))
-		{
-			Stat.OnStatChanged.AddUnique(Callback);
-			bFound = true;
-			break;
-		}
+		Stat->OnStatChanged.AddUnique(Callback);
+		return;
 	}
 	//If we didn't find the stat, it's possible that we are a client and the stat just hasn't replicated.
 	//In this case, we save the delegate off to bind and execute later when the stat replicates down.
-	if (!bFound)
-	{
-		Stats.PendingSubscriptions.Add(StatTag, Callback);
-	}
+	Stats.PendingSubscriptions.Add(StatTag, Callback);
 }
 
 void UStatHandler::UnsubscribeFromStatChanged(const FGameplayTag StatTag, const FStatCallback& Callback)
@@ -162,39 +128,26 @@ void UStatHandler::UnsubscribeFromStatChanged(const FGameplayTag StatTag, const
 	{
 		return;
 	}
-	bool bFound = false;
-	for (FCombatStat& Stat : Stats.Items)
+	if (FCombatStat* Stat = Stats.FindStat(StatTag))
 	{
-		if (Stat.StatTag.MatchesTagExact(StatTag))
-		{
-			Stat.OnStatChanged.Remove(Callback);
-			bFound = true;
-			break;
-		}
+		Stat->OnStatChanged.Remove(Callback);
+		return;
 	}
 	//If we didn't find the stat, it's possible that we are a client and the stat just hasn't replicated.
 	//In this case, we save the delegate off to bind and execute later when the stat replicates down.
 	//This undoes that process if something unsubscribes before the stat becomes valid.
-	if (!bFound)
-	{
-		Stats.PendingSubscriptions.Remove(StatTag, Callback);
-	}
+	Stats.PendingSubscriptions.Remove(StatTag, Callback);
 }
-
 #pragma endregion
 #pragma region Modifiers
 
 FCombatModifierHandle UStatHandler::AddStatModifier(const FGameplayTag StatTag, const FCombatModifier& Modifier)
 {
-	if (GetOwnerRole() == ROLE_Authority && Modifier.Type != EModifierType::Invalid &&
-		StatTag.IsValid() && StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) && !StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
+	if (GetOwnerRole() == ROLE_Authority && Modifier.Type != EModifierType::Invalid)
 	{
-		for (FCombatStat& Stat : Stats.Items)
+		if (FCombatStat* Stat = Stats.FindStat(StatTag))
 		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				return Stat.AddModifier(Modifier);
-			}
+			return Stat->AddModifier(Modifier);
 		}
 	}
 	return FCombatModifierHandle::Invalid;
@@ -202,16 +155,11 @@ FCombatModifierHandle UStatHandler::AddStatModifier(const FGameplayTag StatTag,
 
 void UStatHandler::RemoveStatModifier(const FGameplayTag StatTag, const FCombatModifierHandle& ModifierHandle)
 {
-	if (GetOwnerRole() == ROLE_Authority && ModifierHandle.IsValid() && StatTag.IsValid() &&
-		StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) && !StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
+	if (GetOwnerRole() == ROLE_Authority && ModifierHandle.IsValid())
 	{
-		for (FCombatStat& Stat : Stats.Items)
+		if (FCombatStat* Stat = Stats.FindStat(StatTag))
 		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				Stat.RemoveModifier(ModifierHandle);
-				return;
-			}
+			Stat->RemoveModifier(ModifierHandle);
 		}
 	}
 }
@@ -219,18 +167,12 @@ void UStatHandler::RemoveStatModifier(const FGameplayTag StatTag, const FCombatM
 void UStatHandler::UpdateStatModifier(const FGameplayTag StatTag, const FCombatModifierHandle& ModifierHandle,
 	const FCombatModifier& Modifier)
 {
-	if (GetOwnerRole() == ROLE_Authority && ModifierHandle.IsValid() && StatTag.IsValid() &&
-		StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) && !StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
+	if (GetOwnerRole() == ROLE_Authority && ModifierHandle.IsValid())
 	{
-		for (FCombatStat& Stat : Stats.Items)
+		if (FCombatStat* Stat = Stats.FindStat(StatTag))
 		{
-			if (Stat.StatTag.MatchesTagExact(StatTag))
-			{
-				Stat.UpdateModifier(ModifierHandle, Modifier);
-				return;
-			}
+			Stat->UpdateModifier(ModifierHandle, Modifier);
 		}
 	}
 }
-
 #pragma endregion 
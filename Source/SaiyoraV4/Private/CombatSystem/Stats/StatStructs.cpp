@@ -16,7 +16,7 @@ void FCombatStat::PostReplicatedAdd(const FCombatStatArray& InArraySerializer)
 		//TODO: Make non-const and clear out the pending subscriptions?
 		bInitialized = true;
 	}
-	OnStatChanged.Broadcast(StatTag, GetCurrentValue());
+	//The initial value is broadcast by the array after it rebuilds its lookup.
 }
 
 void FCombatStat::PostReplicatedChange(const FCombatStatArray& InArraySerializer)
@@ -35,4 +35,59 @@ void FCombatStat::PostReplicatedChange(const FCombatStatArray& InArraySerializer
 		bInitialized = true;
 	}
 	OnStatChanged.Broadcast(StatTag, GetCurrentValue());
+}
+
+void FCombatStatArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	RebuildLookup();
+	for (const int32 Index : AddedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			Items[Index].OnStatChanged.Broadcast(Items[Index].StatTag, Items[Index].GetCurrentValue());
+		}
+	}
+}
+
+void FStatLookupTable::Build(const TArray<FCombatStat>& InStats)
+{
+	Slots.Reset();
+	const UGameplayTagsManager& TagManager = UGameplayTagsManager::Get();
+	for (int32 i = 0; i < InStats.Num(); i++)
+	{
+		const FGameplayTag& StatTag = InStats[i].StatTag;
+		if (!StatTag.IsValid() || !StatTag.MatchesTag(FSaiyoraCombatTags::Get().Stat) || StatTag.MatchesTagExact(FSaiyoraCombatTags::Get().Stat))
+		{
+			continue;
+		}
+		const FGameplayTagNetIndex NetIndex = TagManager.GetNetIndexFromTag(StatTag);
+		if (NetIndex == INVALID_TAGNETINDEX)
+		{
+			continue;
+		}
+		if (!Slots.IsValidIndex(NetIndex))
+		{
+			const int32 OldNum = Slots.Num();
+			Slots.SetNumUninitialized(NetIndex + 1);
+			for (int32 j = OldNum; j < Slots.Num(); j++)
+			{
+				Slots[j] = INDEX_NONE;
+			}
+		}
+		//Keep the first entry for duplicated tags, matching the old linear search.
+		if (Slots[NetIndex] == INDEX_NONE)
+		{
+			Slots[NetIndex] = i;
+		}
+	}
+}
+
+int32 FStatLookupTable::Find(const FGameplayTag StatTag) const
+{
+	if (!StatTag.IsValid() || Slots.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+	const FGameplayTagNetIndex NetIndex = UGameplayTagsManager::Get().GetNetIndexFromTag(StatTag);
+	return Slots.IsValidIndex(NetIndex) ? Slots[NetIndex] : INDEX_NONE;
 }
\ No newline at end of file
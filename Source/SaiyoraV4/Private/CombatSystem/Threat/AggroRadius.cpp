@@ -3,13 +3,13 @@
 #include <CombatGroup.h>
 
 #include "AbilityComponent.h"
+#include "AbilityFunctionLibrary.h"
 #include "CombatStatusComponent.h"
 #include "NPCAbilityComponent.h"
 #include "SaiyoraCombatInterface.h"
 #include "SaiyoraCombatLibrary.h"
 #include "StatHandler.h"
 #include "ThreatHandler.h"
-#include "Kismet/KismetSystemLibrary.h"
 
 static TAutoConsoleVariable<int32> DrawAggroSpheres(
 		TEXT("game.DrawAggroSpheres"),
@@ -119,11 +119,8 @@ void UAggroRadius::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* O
 	{
 		if (OverlappedAggro->GetOwnerFaction() == EFaction::Friendly && !ThreatHandlerRef->IsActorInThreatTable(OtherActor))
 		{
-			FHitResult SightResult;
-			UKismetSystemLibrary::LineTraceSingle(this, GetComponentLocation(), OverlappedAggro->GetComponentLocation(),
-				UEngineTypes::ConvertToTraceType(ECC_Visibility), false,TArray<AActor*>(),
-				EDrawDebugTrace::None, SightResult, true);
-			if (!SightResult.bBlockingHit)
+			//Goes through the line of sight subsystem so a pull overlapping many aggro radii in one frame shares traces.
+			if (UAbilityFunctionLibrary::CheckLineOfSightInPlane(this, GetComponentLocation(), OverlappedAggro->GetComponentLocation(), ESaiyoraPlane::Both))
 			{
 				ThreatHandlerRef->AddThreat(EThreatType::Absolute, 1.0f, OtherActor, nullptr, false, false, FThreatModCondition());
 			}
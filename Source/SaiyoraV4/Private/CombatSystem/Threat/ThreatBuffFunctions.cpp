@@ -20,6 +20,21 @@ void UThreatModifierFunction::ThreatModifier(UBuff* Buff, EThreatModifierType co
 	NewThreatModifierFunction->SetModifierVars(ModifierType, Modifier);
 }
 
+void UThreatModifierFunction::StaticThreatModifier(UBuff* Buff, EThreatModifierType const ModifierType,
+                                                   FCombatModifier const& Modifier)
+{
+	if (!IsValid(Buff) || ModifierType == EThreatModifierType::None || Modifier.Type == EModifierType::Invalid || Buff->GetAppliedTo()->GetLocalRole() != ROLE_Authority)
+	{
+		return;
+	}
+	UThreatModifierFunction* NewThreatModifierFunction = Cast<UThreatModifierFunction>(InstantiateBuffFunction(Buff, StaticClass()));
+	if (!IsValid(NewThreatModifierFunction))
+	{
+		return;
+	}
+	NewThreatModifierFunction->SetStaticModifierVars(ModifierType, Modifier);
+}
+
 void UThreatModifierFunction::SetModifierVars(EThreatModifierType const ModifierType,
                                               FThreatModCondition const& Modifier)
 {
@@ -31,9 +46,35 @@ void UThreatModifierFunction::SetModifierVars(EThreatModifierType const Modifier
 	}
 }
 
+void UThreatModifierFunction::SetStaticModifierVars(EThreatModifierType const ModifierType,
+                                                    FCombatModifier const& Modifier)
+{
+	if (GetOwningBuff()->GetAppliedTo()->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()))
+	{
+		TargetHandler = ISaiyoraCombatInterface::Execute_GetThreatHandler(GetOwningBuff()->GetAppliedTo());
+		ModType = ModifierType;
+		bStaticMod = true;
+		StaticMod = FCombatModifier(Modifier.Value, Modifier.Type, GetOwningBuff(), Modifier.bStackable);
+	}
+}
+
 void UThreatModifierFunction::OnApply(FBuffApplyEvent const& ApplyEvent)
 {
-	if (IsValid(TargetHandler))
+	if (IsValid(TargetHandler) && bStaticMod)
+	{
+		switch (ModType)
+		{
+		case EThreatModifierType::Incoming :
+			StaticModHandle = TargetHandler->AddStaticIncomingThreatModifier(StaticMod);
+			break;
+		case EThreatModifierType::Outgoing :
+			StaticModHandle = TargetHandler->AddStaticOutgoingThreatModifier(StaticMod);
+			break;
+		default :
+			break;
+		}
+	}
+	else if (IsValid(TargetHandler))
 	{
 		switch (ModType)
 		{
@@ -49,9 +90,41 @@ void UThreatModifierFunction::OnApply(FBuffApplyEvent const& ApplyEvent)
 	}
 }
 
+void UThreatModifierFunction::OnChange(FBuffApplyEvent const& ApplyEvent)
+{
+	if (IsValid(TargetHandler) && bStaticMod && StaticMod.bStackable && ApplyEvent.PreviousStacks != ApplyEvent.NewStacks)
+	{
+		switch (ModType)
+		{
+		case EThreatModifierType::Incoming :
+			TargetHandler->UpdateStaticIncomingThreatModifier(StaticModHandle, StaticMod);
+			break;
+		case EThreatModifierType::Outgoing :
+			TargetHandler->UpdateStaticOutgoingThreatModifier(StaticModHandle, StaticMod);
+			break;
+		default :
+			break;
+		}
+	}
+}
+
 void UThreatModifierFunction::OnRemove(FBuffRemoveEvent const& RemoveEvent)
 {
-	if (IsValid(TargetHandler))
+	if (IsValid(TargetHandler) && bStaticMod)
+	{
+		switch (ModType)
+		{
+		case EThreatModifierType::Incoming :
+			TargetHandler->RemoveStaticIncomingThreatModifier(StaticModHandle);
+			break;
+		case EThreatModifierType::Outgoing :
+			TargetHandler->RemoveStaticOutgoingThreatModifier(StaticModHandle);
+			break;
+		default :
+			break;
+		}
+	}
+	else if (IsValid(TargetHandler))
 	{
 		switch (ModType)
 		{
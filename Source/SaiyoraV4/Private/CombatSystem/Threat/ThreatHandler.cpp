@@ -5,6 +5,7 @@
 #include "UnrealNetwork.h"
 #include "Buff.h"
 #include "CombatGroup.h"
+#include "CombatEventSubsystem.h"
 #include "DamageHandler.h"
 #include "SaiyoraCombatInterface.h"
 #include "CombatStatusComponent.h"
@@ -42,6 +43,7 @@ void UThreatHandler::InitializeComponent()
 		NPCComponentRef = Cast<UNPCAbilityComponent>(AbilityComponent);
 	}
 	DisableThreatEvents.BindDynamic(this, &UThreatHandler::DisableAllThreatEvents);
+	CombatEventBus = GetWorld()->GetSubsystem<UCombatEventSubsystem>();
 }
 
 void UThreatHandler::BeginPlay()
@@ -130,35 +132,19 @@ float UThreatHandler::GetCombatTime() const
 
 void UThreatHandler::NotifyOfNewCombatant(UThreatHandler* Combatant)
 {
-	const FThreatTarget NewTarget = FThreatTarget(Combatant);
-	int32 InsertIndex = 0;
-	for (; InsertIndex < ThreatTable.Num(); InsertIndex++)
+	if (!IsValid(Combatant) || ThreatTableIndices.Contains(Combatant))
 	{
-		if (!(ThreatTable[InsertIndex] < NewTarget))
-		{
-			break;
-		}
-	}
-	ThreatTable.Insert(NewTarget, InsertIndex);
-	if (InsertIndex == ThreatTable.Num() - 1)
-	{
-		UpdateTarget();
+		return;
 	}
+	AddToThreatTable(FThreatTarget(Combatant));
 }
 
 void UThreatHandler::NotifyOfCombatantLeft(const UThreatHandler* Combatant)
 {
-	for (int i = 0; i < ThreatTable.Num(); i++)
+	const int32* Index = ThreatTableIndices.Find(Combatant);
+	if (Index)
 	{
-		if (ThreatTable[i].TargetThreat == Combatant)
-		{
-			ThreatTable.RemoveAt(i);
-			if (i == ThreatTable.Num())
-			{
-				UpdateTarget();
-			}
-			break;
-		}
+		RemoveFromThreatTable(*Index);
 	}
 }
 
@@ -170,12 +156,9 @@ int32 UThreatHandler::FindOrAddToThreatTable(UThreatHandler* Target, bool& bAdde
 		return -1;
 	}
 	//Check threat table for already existing entry.
-	for (int i = 0; i < ThreatTable.Num(); i++)
+	if (const int32* ExistingIndex = ThreatTableIndices.Find(Target))
 	{
-		if (ThreatTable[i].TargetThreat == Target)
-		{
-			return i;
-		}
+		return *ExistingIndex;
 	}
 	//Not in threat table, need to enter combat with the target.
 	if (bInCombat && IsValid(CombatGroup))
@@ -211,13 +194,10 @@ int32 UThreatHandler::FindOrAddToThreatTable(UThreatHandler* Target, bool& bAdde
 		}
 	}
 	//After entering combat, check the threat table again, as the combat group should've added the new combatant.
-	for (int i = 0; i < ThreatTable.Num(); i++)
+	if (const int32* NewIndex = ThreatTableIndices.Find(Target))
 	{
-		if (ThreatTable[i].TargetThreat == Target)
-		{
-			bAdded = true;
-			return i;
-		}
+		bAdded = true;
+		return *NewIndex;
 	}
 	return -1;
 }
@@ -228,36 +208,24 @@ int32 UThreatHandler::FindInThreatTable(const UThreatHandler* Target) const
 	{
 		return -1;
 	}
-	for (int i = 0; i < ThreatTable.Num(); i++)
-	{
-		if (ThreatTable[i].TargetThreat == Target)
-		{
-			return i;
-		}
-	}
-	return -1;
+	const int32* Index = ThreatTableIndices.Find(Target);
+	return Index ? *Index : -1;
 }
 
 int32 UThreatHandler::FindInThreatTable(const AActor* Target) const
 {
-	if (!IsValid(Target))
+	if (!IsValid(Target) || !Target->GetClass()->ImplementsInterface(USaiyoraCombatInterface::StaticClass()))
 	{
 		return -1;
 	}
-	for (int i = 0; i < ThreatTable.Num(); i++)
-	{
-		if (ThreatTable[i].TargetThreat->GetOwner() == Target)
-		{
-			return i;
-		}
-	}
-	return -1;
+	return FindInThreatTable(ISaiyoraCombatInterface::Execute_GetThreatHandler(Target));
 }
 
 void UThreatHandler::ClearThreatTable()
 {
 	ThreatTable.Empty();
-	UpdateTarget();
+	ThreatTableIndices.Empty();
+	MarkTargetDirty();
 }
 
 FThreatEvent UThreatHandler::AddThreat(const EThreatType ThreatType, const float BaseThreat, AActor* AppliedBy,
@@ -351,6 +319,10 @@ FThreatEvent UThreatHandler::AddThreat(const EThreatType ThreatType, const float
 	ThreatTable[TargetIndex].Threat += Result.Threat;
 	SortModifiedThreatTarget(TargetIndex);
 	Result.bSuccess = true;
+	if (IsValid(CombatEventBus))
+	{
+		CombatEventBus->QueueThreatEvent(Result);
+	}
 	return Result;
 }
 
@@ -380,32 +352,97 @@ void UThreatHandler::RemoveThreat(const float Amount, const AActor* AppliedBy)
 
 void UThreatHandler::SortModifiedThreatTarget(const int32 ModifiedIndex)
 {
-	if (ThreatTable.Num() <= 1 || !ThreatTable.IsValidIndex(ModifiedIndex))
+	if (!ThreatTable.IsValidIndex(ModifiedIndex))
+	{
+		return;
+	}
+	const int32 NewIndex = SiftThreatTargetDown(SiftThreatTargetUp(ModifiedIndex));
+	if (ModifiedIndex == 0 || NewIndex == 0)
+	{
+		MarkTargetDirty();
+	}
+}
+
+void UThreatHandler::AddToThreatTable(const FThreatTarget& NewTarget)
+{
+	const int32 Index = ThreatTable.Add(NewTarget);
+	ThreatTable[Index].InsertionOrder = ThreatTableInsertions++;
+	ThreatTableIndices.Add(NewTarget.TargetThreat, Index);
+	if (SiftThreatTargetUp(Index) == 0)
+	{
+		MarkTargetDirty();
+	}
+}
+
+void UThreatHandler::RemoveFromThreatTable(const int32 Index)
+{
+	if (!ThreatTable.IsValidIndex(Index))
 	{
 		return;
 	}
-	int32 CurrentIndex = ModifiedIndex;
-	while (CurrentIndex >= 0 && CurrentIndex <= ThreatTable.Num() - 1)
+	const int32 LastIndex = ThreatTable.Num() - 1;
+	if (Index != LastIndex)
+	{
+		SwapThreatTargets(Index, LastIndex);
+	}
+	ThreatTableIndices.Remove(ThreatTable[LastIndex].TargetThreat);
+	ThreatTable.RemoveAt(LastIndex);
+	if (Index != LastIndex)
+	{
+		SiftThreatTargetDown(SiftThreatTargetUp(Index));
+	}
+	if (Index == 0)
 	{
-		if (CurrentIndex > 0 && ThreatTable[CurrentIndex] < ThreatTable[CurrentIndex - 1])
+		MarkTargetDirty();
+	}
+}
+
+int32 UThreatHandler::SiftThreatTargetUp(int32 Index)
+{
+	while (Index > 0)
+	{
+		const int32 Parent = (Index - 1) / 2;
+		if (!(ThreatTable[Parent] < ThreatTable[Index]))
 		{
-			ThreatTable.Swap(CurrentIndex, CurrentIndex - 1);
-			CurrentIndex--;
+			break;
 		}
-		else if (CurrentIndex < ThreatTable.Num() - 1 && ThreatTable[CurrentIndex + 1] < ThreatTable[CurrentIndex])
+		SwapThreatTargets(Parent, Index);
+		Index = Parent;
+	}
+	return Index;
+}
+
+int32 UThreatHandler::SiftThreatTargetDown(int32 Index)
+{
+	const int32 Num = ThreatTable.Num();
+	while (true)
+	{
+		const int32 Left = Index * 2 + 1;
+		const int32 Right = Left + 1;
+		int32 Highest = Index;
+		if (Left < Num && ThreatTable[Highest] < ThreatTable[Left])
 		{
-			ThreatTable.Swap(CurrentIndex, CurrentIndex + 1);
-			CurrentIndex++;
+			Highest = Left;
 		}
-		else
+		if (Right < Num && ThreatTable[Highest] < ThreatTable[Right])
+		{
+			Highest = Right;
+		}
+		if (Highest == Index)
 		{
 			break;
 		}
+		SwapThreatTargets(Index, Highest);
+		Index = Highest;
 	}
-	if (ModifiedIndex == ThreatTable.Num() - 1 || CurrentIndex == ThreatTable.Num() - 1)
-	{
-		UpdateTarget();
-	}
+	return Index;
+}
+
+void UThreatHandler::SwapThreatTargets(const int32 First, const int32 Second)
+{
+	ThreatTable.Swap(First, Second);
+	ThreatTableIndices.Add(ThreatTable[First].TargetThreat, First);
+	ThreatTableIndices.Add(ThreatTable[Second].TargetThreat, Second);
 }
 
 bool UThreatHandler::IsActorInThreatTable(const AActor* Target) const
@@ -438,7 +475,11 @@ void UThreatHandler::GetActorsInThreatTable(TArray<AActor*>& OutActors) const
 	{
 		return;
 	}
-	for (const FThreatTarget& Target : ThreatTable)
+	//The threat table is only heap-ordered, so sort a copy.
+	TArray<FThreatTarget> SortedTable;
+	GetThreatTable(SortedTable);
+	OutActors.Reserve(SortedTable.Num());
+	for (const FThreatTarget& Target : SortedTable)
 	{
 		if (IsValid(Target.TargetThreat))
 		{
@@ -447,16 +488,33 @@ void UThreatHandler::GetActorsInThreatTable(TArray<AActor*>& OutActors) const
 	}
 }
 
+void UThreatHandler::GetThreatTable(TArray<FThreatTarget>& Table) const
+{
+	Table = ThreatTable;
+	Table.Sort();
+}
+
+void UThreatHandler::MarkTargetDirty()
+{
+	if (bTargetUpdatePending)
+	{
+		return;
+	}
+	bTargetUpdatePending = true;
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UThreatHandler::UpdateTarget);
+}
+
 void UThreatHandler::UpdateTarget()
 {
+	bTargetUpdatePending = false;
 	AActor* Previous = CurrentTarget;
-	if (ThreatTable.Num() == 0)
+	if (ThreatTable.Num() == 0 || !IsValid(ThreatTable[0].TargetThreat))
 	{
 		CurrentTarget = nullptr;
 	}
 	else
 	{
-		CurrentTarget = ThreatTable[ThreatTable.Num() - 1].TargetThreat->GetOwner();
+		CurrentTarget = ThreatTable[0].TargetThreat->GetOwner();
 	}
 	if (CurrentTarget != Previous)
 	{
@@ -496,19 +554,17 @@ void UThreatHandler::OnRep_CurrentTarget(AActor* PreviousTarget)
 float UThreatHandler::GetModifiedIncomingThreat(const FThreatEvent& ThreatEvent) const
 {
 	TArray<FCombatModifier> Mods;
-	IncomingThreatMods.GetModifiers(Mods, ThreatEvent);
-	return FCombatModifier::ApplyModifiers(Mods, ThreatEvent.Threat);
+	return IncomingThreatMods.GetModifiedValue(ThreatEvent.Threat, Mods, ThreatEvent);
 }
 
 float UThreatHandler::GetModifiedOutgoingThreat(const FThreatEvent& ThreatEvent, const FThreatModCondition& SourceModifier) const
 {
 	TArray<FCombatModifier> Mods;
-	OutgoingThreatMods.GetModifiers(Mods, ThreatEvent);
 	if (SourceModifier.IsBound())
 	{
 		Mods.Add(SourceModifier.Execute(ThreatEvent));
 	}
-	return FCombatModifier::ApplyModifiers(Mods, ThreatEvent.Threat);
+	return OutgoingThreatMods.GetModifiedValue(ThreatEvent.Threat, Mods, ThreatEvent);
 }
 
 #pragma endregion
@@ -17,7 +17,7 @@ bool FThreatTarget::LessThan(const FThreatTarget& Other) const
 		//If the other is also blinded or faded, order on threat.
 		if (Other.Blinds.Num() > 0 || Other.Faded)
 		{
-			return Threat < Other.Threat;
+			return ThreatLessThan(Other);
 		}
 		//The other is not blinded or faded, and thus has higher target priority.
 		return true;
@@ -34,7 +34,7 @@ bool FThreatTarget::LessThan(const FThreatTarget& Other) const
 				return false;
 			}
 			//Both have fixates and no blind/fade, determine based on threat.
-			return Threat < Other.Threat;
+			return ThreatLessThan(Other);
 		}
 		//Other does not have a fixate, we have higher target priority.
 		return false;
@@ -52,5 +52,5 @@ bool FThreatTarget::LessThan(const FThreatTarget& Other) const
 		return true;
 	}
 	//Neither has any blinds, fades, or fixates. Order on threat.
-	return Threat < Other.Threat;
+	return ThreatLessThan(Other);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "SaiyoraPlayerController.h"
+#include "AbilityComponent.h"
 #include "SaiyoraPlayerCharacter.h"
 #include "CoreClasses/SaiyoraGameState.h"
 
@@ -62,4 +63,9 @@ void ASaiyoraPlayerController::ServerFinalPingBounce_Implementation(const float
 bool ASaiyoraPlayerController::ServerFinalPingBounce_Validate(const float ServerTime)
 {
     return true;
+}
+
+void ASaiyoraPlayerController::ClientSimulatedAbilityEvents_Implementation(const FSimulatedAbilityEvents& Events)
+{
+    UAbilityComponent::HandleSimulatedAbilityEvents(Events);
 }
\ No newline at end of file
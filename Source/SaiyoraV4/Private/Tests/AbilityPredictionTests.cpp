@@ -0,0 +1,135 @@
+﻿#include "AbilityComponent.h"
+#include "AbilityStructs.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPredictedTickWindowTest, "SaiyoraV4.Abilities.Prediction.TickWindow",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPredictedTickWindowTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 WindowSize = FPredictedTickWindow::WindowSize;
+	constexpr int32 MaskedTicks = FPredictedTickWindow::MaskedTicks;
+	//The window is 256 slots of bitmasks, too big to put on the stack comfortably.
+	const TUniquePtr<FPredictedTickWindow> Window = MakeUnique<FPredictedTickWindow>();
+	bool bSuccess = false;
+
+	TestFalse(TEXT("Empty window has nothing outside it"), Window->IsOutsideWindow(-WindowSize));
+	TestFalse(TEXT("Empty window has no ticks"), Window->Find(FPredictedTick(1, 0), bSuccess));
+
+	//Ticks inside the bitmask.
+	Window->Record(FPredictedTick(1, 0), true);
+	Window->Record(FPredictedTick(1, MaskedTicks - 1), false);
+	TestTrue(TEXT("First masked tick found"), Window->Find(FPredictedTick(1, 0), bSuccess));
+	TestTrue(TEXT("First masked tick succeeded"), bSuccess);
+	TestTrue(TEXT("Last masked tick found"), Window->Find(FPredictedTick(1, MaskedTicks - 1), bSuccess));
+	TestFalse(TEXT("Last masked tick failed"), bSuccess);
+	TestFalse(TEXT("Unrecorded masked tick"), Window->Contains(FPredictedTick(1, 1)));
+
+	//Ticks past the bitmask, and negative ticks, go to the overflow list. Recording a tick again overwrites its result instead of adding another entry.
+	Window->Record(FPredictedTick(1, MaskedTicks), true);
+	Window->Record(FPredictedTick(1, MaskedTicks + 10), false);
+	Window->Record(FPredictedTick(1, -1), true);
+	Window->Record(FPredictedTick(1, MaskedTicks), false);
+	const FPredictedTickWindow::FSlot& OverflowSlot = Window->Slots[FPredictedTickWindow::GetSlotIndex(1)];
+	TestEqual(TEXT("Overflow entries"), OverflowSlot.OverflowTicks.Num(), 3);
+	TestTrue(TEXT("First overflow tick found"), Window->Find(FPredictedTick(1, MaskedTicks), bSuccess));
+	TestFalse(TEXT("First overflow tick was overwritten"), bSuccess);
+	TestTrue(TEXT("Later overflow tick found"), Window->Find(FPredictedTick(1, MaskedTicks + 10), bSuccess));
+	TestFalse(TEXT("Later overflow tick failed"), bSuccess);
+	TestTrue(TEXT("Negative tick found"), Window->Find(FPredictedTick(1, -1), bSuccess));
+	TestTrue(TEXT("Negative tick succeeded"), bSuccess);
+	TestFalse(TEXT("Unrecorded overflow tick"), Window->Contains(FPredictedTick(1, MaskedTicks + 1)));
+	TestTrue(TEXT("Masked ticks unaffected by overflow"), Window->Contains(FPredictedTick(1, 0)));
+
+	//Run the window around the ring several times. Each new prediction takes over the slot of the one WindowSize IDs before it.
+	for (int32 PredictionID = 2; PredictionID <= WindowSize * 3; PredictionID++)
+	{
+		Window->Record(FPredictedTick(PredictionID, 0), PredictionID % 2 == 0);
+		if (!Window->Find(FPredictedTick(PredictionID, 0), bSuccess) || bSuccess != (PredictionID % 2 == 0))
+		{
+			AddError(FString::Printf(TEXT("Prediction %d was not recorded correctly."), PredictionID));
+		}
+		const int32 OldestInWindow = PredictionID - WindowSize + 1;
+		if (OldestInWindow > 1)
+		{
+			if (!Window->Find(FPredictedTick(OldestInWindow, 0), bSuccess) || bSuccess != (OldestInWindow % 2 == 0))
+			{
+				AddError(FString::Printf(TEXT("Prediction %d fell out of the window early."), OldestInWindow));
+			}
+			if (Window->IsOutsideWindow(OldestInWindow))
+			{
+				AddError(FString::Printf(TEXT("Prediction %d counted as outside the window early."), OldestInWindow));
+			}
+		}
+		//Anything older counts as processed and failed, even ticks that were never recorded, so replays are rejected.
+		const int32 JustOutside = PredictionID - WindowSize;
+		if (JustOutside > 0 && (!Window->IsOutsideWindow(JustOutside) || !Window->Find(FPredictedTick(JustOutside, 5), bSuccess) || bSuccess))
+		{
+			AddError(FString::Printf(TEXT("Prediction %d should be outside the window after %d."), JustOutside, PredictionID));
+		}
+	}
+	TestEqual(TEXT("Reused slot drops overflow ticks"), OverflowSlot.OverflowTicks.Num(), 0);
+
+	//A late record for an old prediction still in the window doesn't move the window.
+	const int32 Newest = WindowSize * 3;
+	Window->Record(FPredictedTick(Newest - 10, 1), true);
+	TestTrue(TEXT("Late record inside the window"), Window->Contains(FPredictedTick(Newest - 10, 1)));
+	TestEqual(TEXT("Newest prediction after a late record"), Window->NewestPredictionID, Newest);
+	//A record for a prediction outside the window is dropped rather than clobbering the newer prediction in its slot.
+	Window->Record(FPredictedTick(Newest - WindowSize, 1), true);
+	TestTrue(TEXT("Newer prediction keeps its slot"), Window->Contains(FPredictedTick(Newest, 0)));
+	TestFalse(TEXT("Tick of the newer prediction not overwritten"), Window->Contains(FPredictedTick(Newest, 1)));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnackedAbilityPredictionCapTest, "SaiyoraV4.Abilities.Prediction.UnackedPredictionCap",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUnackedAbilityPredictionCapTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxUnacked = UAbilityComponent::MaxUnackedPredictions;
+	UAbilityComponent* AbilityComponent = NewObject<UAbilityComponent>();
+	const TArray<FClientAbilityPrediction>& Unacked = AbilityComponent->UnackedAbilityPredictions;
+
+	//A server that never answers can only make the client hold on to the newest predictions, up to the cap.
+	constexpr int32 NumPredictions = MaxUnacked * 3 + 7;
+	for (int32 PredictionID = 1; PredictionID <= NumPredictions; PredictionID++)
+	{
+		FClientAbilityPrediction Prediction;
+		Prediction.PredictionID = PredictionID;
+		AbilityComponent->AddUnackedPrediction(Prediction);
+		if (Unacked.Num() > MaxUnacked)
+		{
+			AddError(FString::Printf(TEXT("%d unacked predictions after prediction %d."), Unacked.Num(), PredictionID));
+		}
+	}
+	if (!TestEqual(TEXT("Unacked predictions at the cap"), Unacked.Num(), MaxUnacked))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Oldest kept prediction"), Unacked[0].PredictionID, NumPredictions - MaxUnacked + 1);
+	TestEqual(TEXT("Newest kept prediction"), Unacked.Last().PredictionID, NumPredictions);
+	for (int32 i = 1; i < Unacked.Num(); i++)
+	{
+		if (Unacked[i].PredictionID != Unacked[i - 1].PredictionID + 1)
+		{
+			AddError(FString::Printf(TEXT("Unacked predictions out of order at index %d."), i));
+		}
+	}
+
+	//An ack for a prediction that was already dropped has nothing left to clear.
+	AbilityComponent->ClearOldPredictions(NumPredictions - MaxUnacked);
+	TestEqual(TEXT("Ack of a dropped prediction"), Unacked.Num(), MaxUnacked);
+	//An ack clears everything up to and including its prediction.
+	const int32 AckedID = NumPredictions - MaxUnacked / 2;
+	AbilityComponent->ClearOldPredictions(AckedID);
+	TestEqual(TEXT("Unacked after an ack"), Unacked.Num(), NumPredictions - AckedID);
+	TestEqual(TEXT("Oldest unacked after an ack"), Unacked[0].PredictionID, AckedID + 1);
+	AbilityComponent->ClearOldPredictions(NumPredictions);
+	TestEqual(TEXT("Unacked after acking the newest"), Unacked.Num(), 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,208 @@
+﻿#include "AbilityStructs.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/CoreNet.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SaiyoraAbilitySerializationTests
+{
+	void WriteWithoutCustomSerializers(FNetBitWriter& Writer, const UStruct* Struct, void* Data);
+
+	//Serializes a property the way replication would if our structs didn't have NetSerialize: properties in order, arrays as a 16 bit count followed by their elements.
+	void WritePropertyWithoutCustomSerializers(FNetBitWriter& Writer, const FProperty* Property, void* Value)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+			uint16 Num = static_cast<uint16>(ArrayHelper.Num());
+			Writer << Num;
+			for (int32 i = 0; i < ArrayHelper.Num(); i++)
+			{
+				WritePropertyWithoutCustomSerializers(Writer, ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
+			}
+			return;
+		}
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == FAbilityOrigin::StaticStruct() || StructProperty->Struct == FAbilityTargetSet::StaticStruct())
+			{
+				WriteWithoutCustomSerializers(Writer, StructProperty->Struct, Value);
+				return;
+			}
+		}
+		Property->NetSerializeItem(Writer, Writer.PackageMap, Value);
+	}
+
+	void WriteWithoutCustomSerializers(FNetBitWriter& Writer, const UStruct* Struct, void* Data)
+	{
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			for (int32 i = 0; i < It->ArrayDim; i++)
+			{
+				WritePropertyWithoutCustomSerializers(Writer, *It, It->ContainerPtrToValuePtr<void>(Data, i));
+			}
+		}
+	}
+
+	//Object references need a connection's package map to be sent as net GUIDs. The base package map writes nothing for them,
+	//so targets round trip as null entries, which still exercises every count and ID around them.
+	UPackageMap* MakePackageMap()
+	{
+		return NewObject<UPackageMap>(GetTransientPackage());
+	}
+
+	FAbilityTargetSet MakeTargetSet(const int32 SetID, const int32 NumTargets)
+	{
+		FAbilityTargetSet Set(SetID);
+		Set.Targets.SetNum(NumTargets);
+		return Set;
+	}
+
+	FAbilityEvent MakeAbilityEvent()
+	{
+		FAbilityEvent Event;
+		Event.ActionTaken = ECastAction::Tick;
+		Event.Tick = 3;
+		Event.PredictionID = 1234;
+		Event.FailReasons = { ECastFailReason::Moving, ECastFailReason::CostsNotMet };
+		Event.Origin.AimLocation = FVector(1520.25f, -340.5f, 180.75f);
+		Event.Origin.AimDirection = FVector(1.0f, 2.0f, -0.5f).GetSafeNormal();
+		Event.Origin.Origin = FVector(1500.0f, -350.0f, 160.0f);
+		Event.Targets = { MakeTargetSet(0, 3), MakeTargetSet(7, 0), MakeTargetSet(1, 1) };
+		return Event;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAbilityTargetSetSerializationTest, "SaiyoraV4.Abilities.Serialization.TargetSet",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAbilityTargetSetSerializationTest::RunTest(const FString& Parameters)
+{
+	using namespace SaiyoraAbilitySerializationTests;
+	UPackageMap* PackageMap = MakePackageMap();
+	bool bSuccess = false;
+
+	FAbilityTargetSet Original = MakeTargetSet(5, 4);
+	FNetBitWriter Writer(PackageMap, 1024);
+	Original.NetSerialize(Writer, PackageMap, bSuccess);
+	TestTrue(TEXT("Save succeeded"), bSuccess && !Writer.IsError());
+	FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+	FAbilityTargetSet Loaded;
+	TestTrue(TEXT("Load returned true"), Loaded.NetSerialize(Reader, PackageMap, bSuccess));
+	TestTrue(TEXT("Load succeeded"), bSuccess && !Reader.IsError());
+	TestEqual(TEXT("Set ID"), Loaded.SetID, Original.SetID);
+	TestEqual(TEXT("Target count"), Loaded.Targets.Num(), Original.Targets.Num());
+	TestEqual(TEXT("Every bit read back"), Reader.GetPosBits(), Writer.GetNumBits());
+
+	FNetBitWriter DefaultWriter(PackageMap, 1024);
+	WriteWithoutCustomSerializers(DefaultWriter, FAbilityTargetSet::StaticStruct(), &Original);
+	AddInfo(FString::Printf(TEXT("Target set: %lld bits, %lld bits without NetSerialize."), Writer.GetNumBits(), DefaultWriter.GetNumBits()));
+	TestTrue(TEXT("Smaller than the default serializer"), Writer.GetNumBits() < DefaultWriter.GetNumBits());
+
+	//Over-limit sets are clamped when saving, so the receiving side gets a set it can load instead of one it has to reject.
+	AddExpectedError(TEXT("targets, only the first"), EAutomationExpectedErrorFlags::Contains, 1);
+	FAbilityTargetSet Oversized = MakeTargetSet(2, static_cast<int32>(FAbilityTargetSet::MaxSerializedTargets) + 10);
+	FNetBitWriter ClampWriter(PackageMap, 1024);
+	Oversized.NetSerialize(ClampWriter, PackageMap, bSuccess);
+	FNetBitReader ClampReader(PackageMap, ClampWriter.GetData(), ClampWriter.GetNumBits());
+	FAbilityTargetSet ClampLoaded;
+	ClampLoaded.NetSerialize(ClampReader, PackageMap, bSuccess);
+	TestTrue(TEXT("Clamped set loads"), bSuccess && !ClampReader.IsError());
+	TestEqual(TEXT("Clamped target count"), ClampLoaded.Targets.Num(), static_cast<int32>(FAbilityTargetSet::MaxSerializedTargets));
+
+	AddExpectedError(TEXT("target sets, only the first"), EAutomationExpectedErrorFlags::Contains, 1);
+	TArray<FAbilityTargetSet> ManySets;
+	for (int32 i = 0; i < static_cast<int32>(FAbilityTargetSet::MaxSerializedSets) + 5; i++)
+	{
+		ManySets.Add(MakeTargetSet(i, 1));
+	}
+	FNetBitWriter SetsWriter(PackageMap, 1024);
+	FAbilityTargetSet::NetSerializeSets(SetsWriter, PackageMap, ManySets, bSuccess);
+	FNetBitReader SetsReader(PackageMap, SetsWriter.GetData(), SetsWriter.GetNumBits());
+	TArray<FAbilityTargetSet> LoadedSets;
+	FAbilityTargetSet::NetSerializeSets(SetsReader, PackageMap, LoadedSets, bSuccess);
+	TestTrue(TEXT("Clamped sets load"), bSuccess && !SetsReader.IsError());
+	TestEqual(TEXT("Clamped set count"), LoadedSets.Num(), static_cast<int32>(FAbilityTargetSet::MaxSerializedSets));
+	TestEqual(TEXT("Last kept set ID"), LoadedSets.Last().SetID, static_cast<int32>(FAbilityTargetSet::MaxSerializedSets) - 1);
+
+	//A count over the limit that didn't come from our own save side is rejected on load.
+	FNetBitWriter MalformedWriter(PackageMap, 1024);
+	uint32 MalformedSetID = 0;
+	uint32 MalformedCount = FAbilityTargetSet::MaxSerializedTargets + 1;
+	MalformedWriter.SerializeIntPacked(MalformedSetID);
+	MalformedWriter.SerializeIntPacked(MalformedCount);
+	FNetBitReader MalformedReader(PackageMap, MalformedWriter.GetData(), MalformedWriter.GetNumBits());
+	FAbilityTargetSet MalformedLoaded;
+	TestFalse(TEXT("Malformed count rejected"), MalformedLoaded.NetSerialize(MalformedReader, PackageMap, bSuccess));
+	TestTrue(TEXT("Malformed count sets the archive error"), MalformedReader.IsError());
+	TestEqual(TEXT("Nothing allocated for a malformed count"), MalformedLoaded.Targets.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAbilityEventSerializationTest, "SaiyoraV4.Abilities.Serialization.AbilityEvent",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAbilityEventSerializationTest::RunTest(const FString& Parameters)
+{
+	using namespace SaiyoraAbilitySerializationTests;
+	UPackageMap* PackageMap = MakePackageMap();
+	bool bSuccess = false;
+
+	FAbilityEvent Original = MakeAbilityEvent();
+	FNetBitWriter Writer(PackageMap, 1024);
+	Original.NetSerialize(Writer, PackageMap, bSuccess);
+	TestTrue(TEXT("Save succeeded"), bSuccess && !Writer.IsError());
+	FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+	FAbilityEvent Loaded;
+	TestTrue(TEXT("Load returned true"), Loaded.NetSerialize(Reader, PackageMap, bSuccess));
+	TestTrue(TEXT("Load succeeded"), bSuccess && !Reader.IsError());
+	TestEqual(TEXT("Every bit read back"), Reader.GetPosBits(), Writer.GetNumBits());
+
+	TestEqual(TEXT("Action"), Loaded.ActionTaken, Original.ActionTaken);
+	TestEqual(TEXT("Tick"), Loaded.Tick, Original.Tick);
+	TestEqual(TEXT("Prediction ID"), Loaded.PredictionID, Original.PredictionID);
+	TestTrue(TEXT("Fail reasons"), Loaded.FailReasons == Original.FailReasons);
+	//Locations are quantized to two decimal places, and unit directions to 16 bits per component.
+	TestTrue(TEXT("Aim location"), Loaded.Origin.AimLocation.Equals(Original.Origin.AimLocation, 0.01f));
+	TestTrue(TEXT("Origin"), Loaded.Origin.Origin.Equals(Original.Origin.Origin, 0.01f));
+	TestTrue(TEXT("Aim direction"), Loaded.Origin.AimDirection.Equals(Original.Origin.AimDirection, 0.001f));
+	if (TestEqual(TEXT("Target set count"), Loaded.Targets.Num(), Original.Targets.Num()))
+	{
+		for (int32 i = 0; i < Original.Targets.Num(); i++)
+		{
+			TestEqual(FString::Printf(TEXT("Target set %d ID"), i), Loaded.Targets[i].SetID, Original.Targets[i].SetID);
+			TestEqual(FString::Printf(TEXT("Target set %d count"), i), Loaded.Targets[i].Targets.Num(), Original.Targets[i].Targets.Num());
+		}
+	}
+
+	FNetBitWriter DefaultWriter(PackageMap, 1024);
+	WriteWithoutCustomSerializers(DefaultWriter, FAbilityEvent::StaticStruct(), &Original);
+	AddInfo(FString::Printf(TEXT("Ability event: %lld bits, %lld bits without NetSerialize."), Writer.GetNumBits(), DefaultWriter.GetNumBits()));
+	TestTrue(TEXT("Smaller than the default serializer"), Writer.GetNumBits() < DefaultWriter.GetNumBits());
+
+	//An event with no origin or targets, like most failed casts, should be close to the minimum.
+	FAbilityEvent Empty;
+	FNetBitWriter EmptyWriter(PackageMap, 1024);
+	Empty.NetSerialize(EmptyWriter, PackageMap, bSuccess);
+	FNetBitWriter EmptyDefaultWriter(PackageMap, 1024);
+	WriteWithoutCustomSerializers(EmptyDefaultWriter, FAbilityEvent::StaticStruct(), &Empty);
+	AddInfo(FString::Printf(TEXT("Empty ability event: %lld bits, %lld bits without NetSerialize."), EmptyWriter.GetNumBits(), EmptyDefaultWriter.GetNumBits()));
+	TestTrue(TEXT("Empty event smaller than the default serializer"), EmptyWriter.GetNumBits() < EmptyDefaultWriter.GetNumBits());
+
+	//Over-limit fail reasons are clamped when saving.
+	AddExpectedError(TEXT("fail reasons, only the first"), EAutomationExpectedErrorFlags::Contains, 1);
+	FAbilityEvent Oversized = MakeAbilityEvent();
+	Oversized.FailReasons.Init(ECastFailReason::Dead, static_cast<int32>(FAbilityEvent::MaxSerializedFailReasons) + 3);
+	FNetBitWriter ClampWriter(PackageMap, 1024);
+	Oversized.NetSerialize(ClampWriter, PackageMap, bSuccess);
+	FNetBitReader ClampReader(PackageMap, ClampWriter.GetData(), ClampWriter.GetNumBits());
+	FAbilityEvent ClampLoaded;
+	ClampLoaded.NetSerialize(ClampReader, PackageMap, bSuccess);
+	TestTrue(TEXT("Clamped event loads"), bSuccess && !ClampReader.IsError());
+	TestEqual(TEXT("Clamped fail reason count"), ClampLoaded.FailReasons.Num(), static_cast<int32>(FAbilityEvent::MaxSerializedFailReasons));
+	TestEqual(TEXT("Targets after clamped fail reasons"), ClampLoaded.Targets.Num(), Oversized.Targets.Num());
+	return true;
+}
+
+#endif
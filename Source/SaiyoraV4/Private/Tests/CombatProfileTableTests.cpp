@@ -0,0 +1,271 @@
+﻿#include "AbilityFunctionLibrary.h"
+#include "CombatStructs.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SaiyoraProfileTableTests
+{
+	//Copies of the switch-based lookups that the constexpr tables in AbilityFunctionLibrary.cpp replaced, kept as the reference to check and time against.
+	FName LegacyTraceProfile(const EFaction ShooterFaction, const bool bOverlap, const ESaiyoraPlane TracePlane, const EFaction TraceHostility)
+	{
+		if (bOverlap)
+		{
+			switch (TraceHostility)
+			{
+			case EFaction::Friendly :
+				switch (TracePlane)
+				{
+				case ESaiyoraPlane::Ancient :
+					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientOverlapPlayers : FSaiyoraCollision::CT_AncientOverlapNPCs;
+				case ESaiyoraPlane::Modern :
+					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernOverlapPlayers : FSaiyoraCollision::CT_ModernOverlapNPCs;
+				default :
+					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_OverlapPlayers : FSaiyoraCollision::CT_OverlapNPCs;
+				}
+			case EFaction::Enemy :
+				switch (TracePlane)
+				{
+				case ESaiyoraPlane::Ancient :
+					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientOverlapNPCs : FSaiyoraCollision::CT_AncientOverlapPlayers;
+				case ESaiyoraPlane::Modern :
+					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernOverlapNPCs : FSaiyoraCollision::CT_ModernOverlapPlayers;
+				default :
+					return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_OverlapNPCs : FSaiyoraCollision::CT_OverlapPlayers;
+				}
+			default :
+				switch (TracePlane)
+				{
+				case ESaiyoraPlane::Ancient :
+					return FSaiyoraCollision::CT_AncientOverlapAll;
+				case ESaiyoraPlane::Modern :
+					return FSaiyoraCollision::CT_ModernOverlapAll;
+				default :
+					return FSaiyoraCollision::CT_OverlapAll;
+				}
+			}
+		}
+		switch (TraceHostility)
+		{
+		case EFaction::Friendly :
+			switch (TracePlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientPlayers : FSaiyoraCollision::CT_AncientNPCs;
+			case ESaiyoraPlane::Modern :
+				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernPlayers : FSaiyoraCollision::CT_ModernNPCs;
+			default :
+				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_Players : FSaiyoraCollision::CT_NPCs;
+			}
+		case EFaction::Enemy :
+			switch (TracePlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_AncientNPCs : FSaiyoraCollision::CT_AncientPlayers;
+			case ESaiyoraPlane::Modern :
+				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_ModernNPCs : FSaiyoraCollision::CT_ModernPlayers;
+			default :
+				return ShooterFaction == EFaction::Friendly ? FSaiyoraCollision::CT_NPCs : FSaiyoraCollision::CT_Players;
+			}
+		default :
+			switch (TracePlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return FSaiyoraCollision::CT_AncientAll;
+			case ESaiyoraPlane::Modern :
+				return FSaiyoraCollision::CT_ModernAll;
+			default :
+				return FSaiyoraCollision::CT_All;
+			}
+		}
+	}
+
+	FName LegacyProjectileHitboxProfile(const EFaction AttackerFaction, const ESaiyoraFactionFilter FactionFilter)
+	{
+		switch (FactionFilter)
+		{
+		case ESaiyoraFactionFilter::OppositeFaction :
+		case ESaiyoraFactionFilter::OppositeFactionExcludeNeutral :
+			switch (AttackerFaction)
+			{
+			case EFaction::Friendly :
+				return FSaiyoraCollision::P_ProjectileHitboxNPCs;
+			case EFaction::Enemy :
+				return FSaiyoraCollision::P_ProjectileHitboxPlayers;
+			default :
+				return FSaiyoraCollision::P_ProjectileHitboxAll;
+			}
+		case ESaiyoraFactionFilter::SameFaction :
+		case ESaiyoraFactionFilter::SameFactionExcludeNeutral :
+			switch (AttackerFaction)
+			{
+			case EFaction::Friendly :
+				return FSaiyoraCollision::P_ProjectileHitboxPlayers;
+			case EFaction::Enemy :
+				return FSaiyoraCollision::P_ProjectileHitboxNPCs;
+			default :
+				return FSaiyoraCollision::P_ProjectileHitboxAll;
+			}
+		default :
+			return FSaiyoraCollision::P_ProjectileHitboxAll;
+		}
+	}
+
+	FName LegacyProjectileCollisionProfile(const ESaiyoraPlane AttackerPlane, const ESaiyoraPlaneFilter PlaneFilter)
+	{
+		switch (PlaneFilter)
+		{
+		case ESaiyoraPlaneFilter::SamePlane :
+			switch (AttackerPlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return FSaiyoraCollision::P_ProjectileCollisionAncient;
+			case ESaiyoraPlane::Modern :
+				return FSaiyoraCollision::P_ProjectileCollisionModern;
+			case ESaiyoraPlane::Neither :
+				return FSaiyoraCollision::P_NoCollision;
+			default :
+				return FSaiyoraCollision::P_ProjectileCollisionAll;
+			}
+		case ESaiyoraPlaneFilter::XPlane :
+			switch (AttackerPlane)
+			{
+			case ESaiyoraPlane::Ancient :
+				return FSaiyoraCollision::P_ProjectileCollisionModern;
+			case ESaiyoraPlane::Modern :
+				return FSaiyoraCollision::P_ProjectileCollisionAncient;
+			case ESaiyoraPlane::Neither :
+				return FSaiyoraCollision::P_ProjectileCollisionAll;
+			default :
+				return FSaiyoraCollision::P_NoCollision;
+			}
+		default :
+			return FSaiyoraCollision::P_ProjectileCollisionAll;
+		}
+	}
+
+	//The old object type lookups filled an array that callers then turned into FCollisionObjectQueryParams.
+	int32 LegacyHitboxObjectMask(const EFaction ShooterFaction, const EFaction TraceHostility)
+	{
+		TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
+		const bool bOnlyPlayers = (ShooterFaction == EFaction::Friendly && TraceHostility == EFaction::Friendly)
+			|| (ShooterFaction == EFaction::Enemy && TraceHostility == EFaction::Enemy);
+		const bool bOnlyNPCs = (ShooterFaction == EFaction::Friendly && TraceHostility == EFaction::Enemy)
+			|| (ShooterFaction == EFaction::Enemy && TraceHostility == EFaction::Friendly);
+		if (!bOnlyNPCs)
+		{
+			ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_PlayerHitbox));
+		}
+		if (!bOnlyPlayers)
+		{
+			ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_NPCHitbox));
+		}
+		return FCollisionObjectQueryParams(ObjectTypes).GetQueryBitfield();
+	}
+
+	int32 LegacyCollisionObjectMask(const ESaiyoraPlane ProjectilePlane)
+	{
+		TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
+		switch (ProjectilePlane)
+		{
+		case ESaiyoraPlane::Ancient :
+			ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldAncient));
+			break;
+		case ESaiyoraPlane::Modern :
+			ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldModern));
+			break;
+		case ESaiyoraPlane::Both :
+			ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldAncient));
+			ObjectTypes.Add(UEngineTypes::ConvertToObjectType(FSaiyoraCollision::O_WorldModern));
+			break;
+		case ESaiyoraPlane::Neither :
+			return FCollisionObjectQueryParams(ObjectTypes).GetQueryBitfield();
+		default :
+			break;
+		}
+		ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
+		ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldDynamic));
+		return FCollisionObjectQueryParams(ObjectTypes).GetQueryBitfield();
+	}
+
+	constexpr int32 NumFactions = 3;
+	constexpr int32 NumPlanes = 4;
+	constexpr int32 NumFactionFilters = 5;
+	constexpr int32 NumPlaneFilters = 3;
+	constexpr int32 BenchmarkIterations = 20000;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatProfileTableBenchmarkTest, "SaiyoraV4.Abilities.CollisionProfiles.TableLookupBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatProfileTableBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace SaiyoraProfileTableTests;
+
+	//Every combination the tables cover has to resolve to the same profile or mask that the old switches did.
+	for (int32 Shooter = 0; Shooter < NumFactions; ++Shooter)
+	{
+		for (int32 Hostility = 0; Hostility < NumFactions; ++Hostility)
+		{
+			for (int32 Plane = 0; Plane < NumPlanes; ++Plane)
+			{
+				for (const bool bOverlap : { false, true })
+				{
+					const FName Expected = LegacyTraceProfile(static_cast<EFaction>(Shooter), bOverlap, static_cast<ESaiyoraPlane>(Plane), static_cast<EFaction>(Hostility));
+					const FName Actual = UAbilityFunctionLibrary::GetTraceProfileForFaction(static_cast<EFaction>(Shooter), bOverlap, static_cast<ESaiyoraPlane>(Plane), static_cast<EFaction>(Hostility));
+					TestEqual(FString::Printf(TEXT("Trace profile (shooter %d, hostility %d, plane %d, overlap %d)"), Shooter, Hostility, Plane, bOverlap), Actual, Expected);
+				}
+			}
+			TestEqual(FString::Printf(TEXT("Hitbox object mask (shooter %d, hostility %d)"), Shooter, Hostility),
+				UAbilityFunctionLibrary::GetHitboxObjectMaskForFaction(static_cast<EFaction>(Shooter), static_cast<EFaction>(Hostility)),
+				LegacyHitboxObjectMask(static_cast<EFaction>(Shooter), static_cast<EFaction>(Hostility)));
+		}
+		for (int32 Filter = 0; Filter < NumFactionFilters; ++Filter)
+		{
+			TestEqual(FString::Printf(TEXT("Projectile hitbox profile (faction %d, filter %d)"), Shooter, Filter),
+				UAbilityFunctionLibrary::GetRelevantProjectileHitboxProfile(static_cast<EFaction>(Shooter), static_cast<ESaiyoraFactionFilter>(Filter)),
+				LegacyProjectileHitboxProfile(static_cast<EFaction>(Shooter), static_cast<ESaiyoraFactionFilter>(Filter)));
+		}
+	}
+	for (int32 Plane = 0; Plane < NumPlanes; ++Plane)
+	{
+		for (int32 Filter = 0; Filter < NumPlaneFilters; ++Filter)
+		{
+			TestEqual(FString::Printf(TEXT("Projectile collision profile (plane %d, filter %d)"), Plane, Filter),
+				UAbilityFunctionLibrary::GetRelevantProjectileCollisionProfile(static_cast<ESaiyoraPlane>(Plane), static_cast<ESaiyoraPlaneFilter>(Filter)),
+				LegacyProjectileCollisionProfile(static_cast<ESaiyoraPlane>(Plane), static_cast<ESaiyoraPlaneFilter>(Filter)));
+		}
+		TestEqual(FString::Printf(TEXT("Collision object mask (plane %d)"), Plane),
+			UAbilityFunctionLibrary::GetRelevantCollisionObjectMask(static_cast<ESaiyoraPlane>(Plane)),
+			LegacyCollisionObjectMask(static_cast<ESaiyoraPlane>(Plane)));
+	}
+
+	//Timing is only reported, not asserted, since it depends on the machine and build configuration.
+	//The sink keeps the optimizer from dropping lookups whose results are otherwise unused.
+	uint32 Sink = 0;
+	const auto TimeLookups = [&Sink](auto&& TraceLookup, auto&& HitboxLookup, auto&& CollisionLookup, auto&& HitboxMaskLookup, auto&& CollisionMaskLookup)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < BenchmarkIterations; ++i)
+		{
+			const EFaction Faction = static_cast<EFaction>(i % NumFactions);
+			const EFaction Hostility = static_cast<EFaction>((i / NumFactions) % NumFactions);
+			const ESaiyoraPlane Plane = static_cast<ESaiyoraPlane>(i % NumPlanes);
+			Sink += GetTypeHash(TraceLookup(Faction, (i & 1) != 0, Plane, Hostility));
+			Sink += GetTypeHash(HitboxLookup(Faction, static_cast<ESaiyoraFactionFilter>(i % NumFactionFilters)));
+			Sink += GetTypeHash(CollisionLookup(Plane, static_cast<ESaiyoraPlaneFilter>(i % NumPlaneFilters)));
+			Sink += HitboxMaskLookup(Faction, Hostility);
+			Sink += CollisionMaskLookup(Plane);
+		}
+		return FPlatformTime::Seconds() - Start;
+	};
+	const double LegacySeconds = TimeLookups(&LegacyTraceProfile, &LegacyProjectileHitboxProfile, &LegacyProjectileCollisionProfile,
+		&LegacyHitboxObjectMask, &LegacyCollisionObjectMask);
+	const double TableSeconds = TimeLookups(&UAbilityFunctionLibrary::GetTraceProfileForFaction, &UAbilityFunctionLibrary::GetRelevantProjectileHitboxProfile,
+		&UAbilityFunctionLibrary::GetRelevantProjectileCollisionProfile, &UAbilityFunctionLibrary::GetHitboxObjectMaskForFaction, &UAbilityFunctionLibrary::GetRelevantCollisionObjectMask);
+	AddInfo(FString::Printf(TEXT("%d iterations of every lookup: switches and object type arrays %.3f ms, constexpr tables %.3f ms (sink %u)"),
+		BenchmarkIterations, LegacySeconds * 1000.0, TableSeconds * 1000.0, Sink));
+	return true;
+}
+
+#endif
@@ -0,0 +1,50 @@
+﻿#include "NPCAbility.h"
+#include "NPCSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNPCAbilityTokenReservationTest, "SaiyoraV4.NPC.AbilityTokens.ReserveThenCast",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNPCAbilityTokenReservationTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	UNPCSubsystem* NPCSubsystem = World->GetSubsystem<UNPCSubsystem>();
+	if (!TestNotNull(TEXT("NPC subsystem"), NPCSubsystem))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+	//Two NPCs with the same single-token ability. This mirrors UNPCAbility::PostInitializeAbility without needing an owning actor.
+	UNPCAbility* Reserving = NewObject<UNPCAbility>(World);
+	UNPCAbility* Other = NewObject<UNPCAbility>(World);
+	for (UNPCAbility* Ability : { Reserving, Other })
+	{
+		Ability->bUseTokens = true;
+		Ability->NPCSubsystemRef = NPCSubsystem;
+		Ability->TokenCallback.BindDynamic(Ability, &UNPCAbility::OnTokenAvailabilityChanged);
+		NPCSubsystem->InitTokensForAbilityClass(Ability->GetClass(), Ability->TokenCallback);
+		Ability->SetCastFailReason(ECastFailReason::Token, !NPCSubsystem->IsAbilityTokenAvailable(Ability));
+	}
+	TestFalse(TEXT("Token available before reservation"), Reserving->HasCastFailReason(ECastFailReason::Token));
+
+	//The NPC is still moving, so it reserves the only token. This broadcasts that no tokens are available.
+	TestTrue(TEXT("Reservation succeeds"), NPCSubsystem->RequestAbilityToken(Reserving, true));
+	TestFalse(TEXT("Reserving instance stays castable"), Reserving->HasCastFailReason(ECastFailReason::Token));
+	TestTrue(TEXT("Other instance is blocked by the reservation"), Other->HasCastFailReason(ECastFailReason::Token));
+
+	//Movement stops and the queued ability is cast, which claims the reserved token on cast start.
+	TestTrue(TEXT("Cast claims the reserved token"), NPCSubsystem->RequestAbilityToken(Reserving));
+	TestFalse(TEXT("Other instance can't take the token in use"), NPCSubsystem->RequestAbilityToken(Other));
+
+	//Once the cast ends and the token comes off cooldown, the other instance becomes castable again.
+	NPCSubsystem->ReturnAbilityToken(Reserving);
+	World->GetTimerManager().Tick(0.0f);
+	TestFalse(TEXT("Other instance castable after the token returns"), Other->HasCastFailReason(ECastFailReason::Token));
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
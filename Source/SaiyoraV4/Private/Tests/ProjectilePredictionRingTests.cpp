@@ -0,0 +1,106 @@
+﻿#include "CombatNetSubsystem.h"
+#include "SaiyoraPlayerCharacter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProjectilePredictionRingSoakTest, "SaiyoraV4.Net.ProjectilePrediction.RingSoak",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FProjectilePredictionRingSoakTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Capacity = FPlayerProjectileInfo::Capacity;
+
+	//Prediction IDs overflow into the negatives, and consecutive IDs have to land in consecutive slots across the overflow.
+	TestEqual(TEXT("Slot of prediction 0"), FPlayerProjectileInfo::GetSlotIndex(0), 0);
+	TestEqual(TEXT("Slot of prediction -1"), FPlayerProjectileInfo::GetSlotIndex(-1), Capacity - 1);
+	TestEqual(TEXT("Slot of the lowest prediction ID follows the highest"),
+		FPlayerProjectileInfo::GetSlotIndex(MIN_int32), (FPlayerProjectileInfo::GetSlotIndex(MAX_int32) + 1) % Capacity);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	UCombatNetSubsystem* NetSubsystem = World->GetSubsystem<UCombatNetSubsystem>();
+	ASaiyoraPlayerCharacter* Player = World->SpawnActor<ASaiyoraPlayerCharacter>();
+	if (!TestNotNull(TEXT("Combat net subsystem"), NetSubsystem) || !TestNotNull(TEXT("Player"), Player))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	//Run through the ring several times, starting just below the overflow so the soak wraps the prediction ID as well as the ring.
+	constexpr int32 NumPredictions = Capacity * 8;
+	constexpr int32 ProjectilesPerTick = 3;
+	constexpr int32 TicksPerPrediction = 2;
+	const int32 FirstPredictionID = MAX_int32 - NumPredictions / 2;
+	int32 ExpectedExpired = 0;
+	for (int32 i = 0; i < NumPredictions; i++)
+	{
+		//Matches UAbilityComponent::GenerateNewPredictionID, which overflows into the negatives and skips 0.
+		int32 PredictionID = static_cast<int32>(static_cast<uint32>(FirstPredictionID) + static_cast<uint32>(i));
+		if (PredictionID == 0)
+		{
+			continue;
+		}
+		//The slot being taken over belonged to the prediction Capacity IDs ago. It only counts as expired if the server rejected it and its projectiles were never replaced.
+		const bool bReusingRejectedSlot = i >= Capacity && (i - Capacity) % 3 == 2;
+		for (int32 TickNumber = 0; TickNumber < TicksPerPrediction; TickNumber++)
+		{
+			const FPredictedTick Tick(PredictionID, TickNumber);
+			for (int32 Expected = 0; Expected < ProjectilesPerTick; Expected++)
+			{
+				const int32 ID = NetSubsystem->GetNewProjectileID(Player, Tick);
+				if (ID != Expected)
+				{
+					AddError(FString::Printf(TEXT("Prediction %d tick %d got projectile ID %d, expected %d."), PredictionID, TickNumber, ID, Expected));
+				}
+				NetSubsystem->AddPredictedProjectile(Player, Tick, ID, nullptr);
+			}
+		}
+		if (bReusingRejectedSlot)
+		{
+			ExpectedExpired++;
+		}
+		TestEqual(FString::Printf(TEXT("Expired slots after prediction %d"), PredictionID), NetSubsystem->GetNumExpiredProjectileSlots(), ExpectedExpired);
+		if (NetSubsystem->GetNumLiveProjectileSlots() > Capacity)
+		{
+			AddError(FString::Printf(TEXT("%d live slots after prediction %d, more than the ring holds."), NetSubsystem->GetNumLiveProjectileSlots(), PredictionID));
+		}
+
+		//Interleave the server's answers: two out of three predictions are acked, with their projectiles replaced in reverse order, and the rest are rejected.
+		if (i % 3 != 2)
+		{
+			for (int32 TickNumber = TicksPerPrediction - 1; TickNumber >= 0; TickNumber--)
+			{
+				for (int32 ID = ProjectilesPerTick - 1; ID >= 0; ID--)
+				{
+					APredictableProjectile* Replaced = nullptr;
+					if (!NetSubsystem->TakePredictedProjectile(Player, FPredictedTick(PredictionID, TickNumber), ID, Replaced))
+					{
+						AddError(FString::Printf(TEXT("Prediction %d tick %d projectile %d could not be replaced."), PredictionID, TickNumber, ID));
+					}
+				}
+			}
+			APredictableProjectile* Replaced = nullptr;
+			TestFalse(TEXT("Projectile can only be replaced once"), NetSubsystem->TakePredictedProjectile(Player, FPredictedTick(PredictionID, 0), 0, Replaced));
+		}
+		//An ack arriving after the slot was reused has nothing to replace, and must not touch the newer prediction's projectiles.
+		if (i >= Capacity)
+		{
+			const int32 StalePredictionID = static_cast<int32>(static_cast<uint32>(PredictionID) - static_cast<uint32>(Capacity));
+			APredictableProjectile* Replaced = nullptr;
+			TestFalse(TEXT("Stale ack after the slot was reused"), NetSubsystem->TakePredictedProjectile(Player, FPredictedTick(StalePredictionID, 0), 0, Replaced));
+			TestNotNull(TEXT("Newer prediction's slot survives a stale ack"), NetSubsystem->FindPredictionSlot(Player, PredictionID));
+		}
+	}
+
+	//Once every slot has gone unused past the expiry time, none of them are live, and a reused ID starts counting from zero again.
+	World->TimeSeconds += UCombatNetSubsystem::ProjectileSlotExpiry + 1.0f;
+	TestEqual(TEXT("Live slots after expiry"), NetSubsystem->GetNumLiveProjectileSlots(), 0);
+	const int32 LastPredictionID = static_cast<int32>(static_cast<uint32>(FirstPredictionID) + static_cast<uint32>(NumPredictions - 1));
+	TestNull(TEXT("Expired slot lookup"), NetSubsystem->FindPredictionSlot(Player, LastPredictionID));
+	TestEqual(TEXT("Projectile ID after expiry"), NetSubsystem->GetNewProjectileID(Player, FPredictedTick(LastPredictionID, 0)), 0);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "Buff.h"
 #include "BuffHandler.h"
 #include "CastBar.h"
+#include "CombatEventSubsystem.h"
 #include "DamageHandler.h"
 #include "FloatingBuffIcon.h"
 #include "SaiyoraCombatInterface.h"
@@ -35,11 +36,13 @@ void UFloatingHealthBar::Init(AActor* TargetActor)
 	TargetDamageHandler = ISaiyoraCombatInterface::Execute_GetDamageHandler(TargetActor);
 	if (IsValid(TargetDamageHandler))
 	{
-		TargetDamageHandler->OnMaxHealthChanged.AddDynamic(this, &UFloatingHealthBar::UpdateHealth);
-		TargetDamageHandler->OnHealthChanged.AddDynamic(this, &UFloatingHealthBar::UpdateHealth);
-		UpdateHealth(nullptr, 0.0f, 0.0f);
-		TargetDamageHandler->OnAbsorbChanged.AddDynamic(this, &UFloatingHealthBar::UpdateAbsorb);
-		UpdateAbsorb(nullptr, 0.0f, 0.0f);
+		UCombatEventSubsystem* CombatEventBus = GetWorld()->GetSubsystem<UCombatEventSubsystem>();
+		if (IsValid(CombatEventBus))
+		{
+			HealthChangeHandle = CombatEventBus->OnHealthChanges.AddUObject(this, &UFloatingHealthBar::OnHealthChanges);
+		}
+		UpdateHealth();
+		UpdateAbsorb();
 		TargetDamageHandler->OnLifeStatusChanged.AddDynamic(this, &UFloatingHealthBar::UpdateLifeStatus);
 		UpdateLifeStatus(nullptr, ELifeStatus::Invalid, TargetDamageHandler->GetLifeStatus());
 	}
@@ -71,9 +74,33 @@ void UFloatingHealthBar::Init(AActor* TargetActor)
 	}
 }
 
+void UFloatingHealthBar::NativeDestruct()
+{
+	Super::NativeDestruct();
+
+	if (HealthChangeHandle.IsValid())
+	{
+		UCombatEventSubsystem* CombatEventBus = IsValid(GetWorld()) ? GetWorld()->GetSubsystem<UCombatEventSubsystem>() : nullptr;
+		if (IsValid(CombatEventBus))
+		{
+			CombatEventBus->OnHealthChanges.Remove(HealthChangeHandle);
+		}
+		HealthChangeHandle.Reset();
+	}
+}
+
 #pragma region Health
 
-void UFloatingHealthBar::UpdateHealth(AActor* Actor, const float PreviousHealth, const float NewHealth)
+void UFloatingHealthBar::OnHealthChanges(TConstArrayView<UDamageHandler*> ChangedHandlers)
+{
+	if (ChangedHandlers.Contains(TargetDamageHandler))
+	{
+		UpdateHealth();
+		UpdateAbsorb();
+	}
+}
+
+void UFloatingHealthBar::UpdateHealth()
 {
 	const float NewPercent = TargetDamageHandler->GetMaxHealth() <= 0.0f ? 0.0f : FMath::Clamp(TargetDamageHandler->GetCurrentHealth() / TargetDamageHandler->GetMaxHealth(), 0.0f, 1.0f);
 	if (IsValid(HealthBar))
@@ -88,7 +115,7 @@ void UFloatingHealthBar::UpdateHealth(AActor* Actor, const float PreviousHealth,
 	}
 }
 
-void UFloatingHealthBar::UpdateAbsorb(AActor* Actor, const float PreviousHealth, const float NewHealth)
+void UFloatingHealthBar::UpdateAbsorb()
 {
 	const float NewPercent = TargetDamageHandler->GetMaxHealth() <= 0.0f ? 0.0f : FMath::Clamp(TargetDamageHandler->GetCurrentAbsorb() / TargetDamageHandler->GetMaxHealth(), 0.0f, 1.0f);
 	if (IsValid(AbsorbBar))
@@ -1,6 +1,7 @@
 ﻿#include "FloatingHealthBarManager.h"
 #include "AbilityFunctionLibrary.h"
 #include "CombatStatusComponent.h"
+#include "LineOfSightSubsystem.h"
 #include "SaiyoraCombatInterface.h"
 #include "ThreatHandler.h"
 #include "Kismet/GameplayStatics.h"
@@ -373,10 +374,26 @@ void UFloatingHealthBarManager::UpdateHealthBarRootPosition(FFloatingHealthBarIn
 	//Update whether the bar should be on screen this frame, by checking line of sight from the center of the bar's actor to the local player.
 	//TODO: In the future this should probably use camera location, but the c++ player character class doesn't have a camera.
 	//Maybe combat interface can have a CheckLineOfSightFrom function?
-	const bool bIsLineOfSight = IsValid(LocalPlayer) && IsValid(LocalPlayerCombatStatus) ?
-		UAbilityFunctionLibrary::CheckLineOfSightInPlane(LocalPlayer, LocalPlayer->GetActorLocation(), HealthBar.Target->GetActorLocation(), LocalPlayerCombatStatus->GetCurrentPlane())
-			: true;
-	HealthBar.bOnScreen = bIsLineOfSight &&
+	//Line of sight is read from the async line of sight subsystem, so a bar keeps its previous visibility for the frame it takes for a new check to finish.
+	if (IsValid(LocalPlayer) && IsValid(LocalPlayerCombatStatus))
+	{
+		ULineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<ULineOfSightSubsystem>();
+		if (IsValid(LineOfSight))
+		{
+			LineOfSight->GetOrRequestLineOfSight(LocalPlayer->GetActorLocation(), HealthBar.Target->GetActorLocation(),
+				LocalPlayerCombatStatus->GetCurrentPlane(), HealthBar.bLineOfSight);
+		}
+		else
+		{
+			HealthBar.bLineOfSight = UAbilityFunctionLibrary::CheckLineOfSightInPlane(LocalPlayer, LocalPlayer->GetActorLocation(),
+				HealthBar.Target->GetActorLocation(), LocalPlayerCombatStatus->GetCurrentPlane());
+		}
+	}
+	else
+	{
+		HealthBar.bLineOfSight = true;
+	}
+	HealthBar.bOnScreen = HealthBar.bLineOfSight &&
 		UGameplayStatics::ProjectWorldToScreen(GetOwningPlayer(), HealthBar.TargetComponent->GetSocketLocation(HealthBar.TargetSocket), HealthBar.RootPosition, true);
 }
 
@@ -215,26 +215,11 @@ void UActionSlot::OnChargesChanged(UCombatAbility* Ability, const int32 Previous
 void UActionSlot::OnCastableChanged(UCombatAbility* Ability, const bool bCastable, const TArray<ECastFailReason>& FailReasons)
 {
 	//Change keybind text color only if there is a restriction preventing ability use, like crowd control, resource costs, or the actual ability restrictions.
-	bool bDisplayCastable = bCastable;
-	if (!bCastable)
-	{
-		bool bFoundValidFailReason = false;
-		for (const ECastFailReason FailReason : FailReasons)
-		{
-			if (FailReason == ECastFailReason::CustomRestriction
-				|| FailReason == ECastFailReason::CrowdControl
-				|| FailReason == ECastFailReason::AbilityConditionsNotMet
-				|| FailReason == ECastFailReason::CostsNotMet)
-			{
-				bFoundValidFailReason = true;
-				break;
-			}
-		}
-		if (!bFoundValidFailReason)
-		{
-			bDisplayCastable = true;
-		}
-	}
+	static constexpr uint32 DisplayedFailMask = UCombatAbility::CastFailBit(ECastFailReason::CustomRestriction)
+		| UCombatAbility::CastFailBit(ECastFailReason::CrowdControl)
+		| UCombatAbility::CastFailBit(ECastFailReason::AbilityConditionsNotMet)
+		| UCombatAbility::CastFailBit(ECastFailReason::CostsNotMet);
+	const bool bDisplayCastable = bCastable || !IsValid(Ability) || (Ability->GetCastFailMask() & DisplayedFailMask) == 0;
 	if (IsValid(KeybindText))
 	{
 		KeybindText->SetColorAndOpacity(bDisplayCastable ? FLinearColor::White : FLinearColor::Red);
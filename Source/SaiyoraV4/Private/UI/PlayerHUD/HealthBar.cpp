@@ -1,6 +1,7 @@
 ﻿#include "PlayerHUD/HealthBar.h"
 
 #include "AncientSpecialization.h"
+#include "CombatEventSubsystem.h"
 #include "CombatStatusComponent.h"
 #include "DamageHandler.h"
 #include "ModernSpecialization.h"
@@ -22,11 +23,17 @@ void UHealthBar::NativeDestruct()
 	}
 	if (IsValid(OwnerDamageHandler))
 	{
-		OwnerDamageHandler->OnHealthChanged.RemoveDynamic(this, &UHealthBar::UpdateHealth);
-		OwnerDamageHandler->OnMaxHealthChanged.RemoveDynamic(this, &UHealthBar::UpdateHealth);
-		OwnerDamageHandler->OnAbsorbChanged.RemoveDynamic(this, &UHealthBar::UpdateHealth);
 		OwnerDamageHandler->OnLifeStatusChanged.RemoveDynamic(this, &UHealthBar::UpdateLifeStatus);
 	}
+	if (HealthChangeHandle.IsValid())
+	{
+		UCombatEventSubsystem* CombatEventBus = IsValid(GetWorld()) ? GetWorld()->GetSubsystem<UCombatEventSubsystem>() : nullptr;
+		if (IsValid(CombatEventBus))
+		{
+			CombatEventBus->OnHealthChanges.Remove(HealthChangeHandle);
+		}
+		HealthChangeHandle.Reset();
+	}
 	if (IsValid(OwnerCombatStatusComp))
 	{
 		OwnerCombatStatusComp->OnPlaneSwapped.RemoveDynamic(this, &UHealthBar::UpdateClassColorOnPlaneSwap);
@@ -64,9 +71,11 @@ void UHealthBar::InitHealthBar(UPlayerHUD* OwningHUD, ASaiyoraPlayerCharacter* O
 	OwnerDamageHandler = ISaiyoraCombatInterface::Execute_GetDamageHandler(OwningPlayer);
 	if (IsValid(OwnerDamageHandler))
 	{
-		OwnerDamageHandler->OnHealthChanged.AddDynamic(this, &UHealthBar::UpdateHealth);
-		OwnerDamageHandler->OnMaxHealthChanged.AddDynamic(this, &UHealthBar::UpdateHealth);
-		OwnerDamageHandler->OnAbsorbChanged.AddDynamic(this, &UHealthBar::UpdateHealth);
+		UCombatEventSubsystem* CombatEventBus = GetWorld()->GetSubsystem<UCombatEventSubsystem>();
+		if (IsValid(CombatEventBus))
+		{
+			HealthChangeHandle = CombatEventBus->OnHealthChanges.AddUObject(this, &UHealthBar::OnHealthChanges);
+		}
 		OwnerDamageHandler->OnLifeStatusChanged.AddDynamic(this, &UHealthBar::UpdateLifeStatus);
 		UpdateLifeStatus(OwnerDamageHandler->GetOwner(), ELifeStatus::Invalid, OwnerDamageHandler->GetLifeStatus());
 	}
@@ -74,9 +83,17 @@ void UHealthBar::InitHealthBar(UPlayerHUD* OwningHUD, ASaiyoraPlayerCharacter* O
 	ToggleExtraInfo(OwnerHUD->IsExtraInfoToggled());
 }
 
-void UHealthBar::UpdateHealth(AActor* Actor, const float PreviousHealth, const float NewHealth)
+void UHealthBar::OnHealthChanges(TConstArrayView<UDamageHandler*> ChangedHandlers)
+{
+	if (ChangedHandlers.Contains(OwnerDamageHandler))
+	{
+		UpdateHealth();
+	}
+}
+
+void UHealthBar::UpdateHealth()
 {
-	//This function is called when health, max health, or absorb changes, so we just ignore the parameters and query them from the damage handler.
+	//This function is called when health, max health, or absorb changes, so we just query them from the damage handler.
 	if (!IsValid(OwnerDamageHandler) || OwnerDamageHandler->GetLifeStatus() != ELifeStatus::Alive)
 	{
 		return;
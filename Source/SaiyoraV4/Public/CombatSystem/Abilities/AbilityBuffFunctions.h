@@ -24,16 +24,23 @@ public:
 
 	virtual void SetupBuffFunction() override;
 	virtual void OnApply(const FBuffApplyEvent& ApplyEvent) override;
+	virtual void OnChange(const FBuffApplyEvent& ApplyEvent) override;
 	virtual void OnRemove(const FBuffRemoveEvent& RemoveEvent) override;
 
 private:
 
 	UPROPERTY(EditAnywhere, Category = "Ability Modifier")
 	EComplexAbilityModType ModifierType = EComplexAbilityModType::CastLength;
-	UPROPERTY(EditAnywhere, meta = (GetOptions = "GetComplexAbilityModFunctionNames"))
+	//Modifiers that don't depend on the ability can skip the modifier function and be folded into the component's cached modifier terms.
+	UPROPERTY(EditAnywhere, Category = "Ability Modifier")
+	bool bIgnoresAbilityContext = false;
+	UPROPERTY(EditAnywhere, Category = "Ability Modifier", meta = (EditCondition = "bIgnoresAbilityContext"))
+	FCombatModifier StaticModifier;
+	UPROPERTY(EditAnywhere, meta = (GetOptions = "GetComplexAbilityModFunctionNames", EditCondition = "!bIgnoresAbilityContext"))
 	FName ModifierFunctionName;
 	
 	FAbilityModCondition Modifier;
+	FCombatModifierHandle StaticModifierHandle;
 	UPROPERTY()
 	UAbilityComponent* TargetHandler = nullptr;
 
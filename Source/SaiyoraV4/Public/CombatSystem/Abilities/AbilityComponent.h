@@ -5,6 +5,7 @@
 #include "DamageStructs.h"
 #include "CombatAbility.h"
 #include "GameplayTasksComponent.h"
+#include "ProjectileSimulationSubsystem.h"
 #include "SaiyoraGameState.h"
 #include "AbilityComponent.generated.h"
 
@@ -16,6 +17,7 @@ class UCrowdControlHandler;
 class UDamageHandler;
 class UStatHandler;
 class UResourceHandler;
+class USimulatedAbilityEventSubsystem;
 
 USTRUCT()
 struct FAbilityRequest
@@ -35,18 +37,20 @@ struct FAbilityRequest
 	UPROPERTY()
 	TArray<FAbilityTargetSet> Targets;
 
-	friend FArchive& operator<<(FArchive& Ar, FAbilityRequest& Request)
-	{
-		Ar << Request.AbilityClass;
-		Ar << Request.PredictionID;
-		Ar << Request.Tick;
-		Ar << Request.ClientStartTime;
-		Ar << Request.Origin;
-		Ar << Request.Targets;
-		return Ar;
-	}
-
 	void Clear() { AbilityClass = nullptr; PredictionID = 0; Tick = 0; ClientStartTime = 0.0f; Targets.Empty(); }
+
+	//Requests ride along with every predicted move, so an empty request is a single bit.
+	//IDs and ticks are packed, the start time is only sent when set, and the origin is quantized.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbilityRequest> : public TStructOpsTypeTraitsBase2<FAbilityRequest>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 USTRUCT()
@@ -180,7 +184,11 @@ private:
 	TMultiMap<TSubclassOf<UCombatAbility>, UBuff*> AbilityUsageClassRestrictions;
 	int32 LastPredictionID = 0;
 	int32 GenerateNewPredictionID();
-	TMap<int32, FClientAbilityPrediction> UnackedAbilityPredictions;
+	//Predictions the server hasn't responded to yet, in prediction ID order.
+	//Capped so that predictions the server never answers can't accumulate. The oldest are dropped first.
+	TArray<FClientAbilityPrediction> UnackedAbilityPredictions;
+	static constexpr int32 MaxUnackedPredictions = 64;
+	void AddUnackedPrediction(const FClientAbilityPrediction& Prediction);
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerPredictAbility(const FAbilityRequest& Request);
 	bool ServerPredictAbility_Validate(const FAbilityRequest& Request) { return true; }
@@ -196,11 +204,10 @@ private:
 	//Relying on the CastingState OnRep could cause a race condition (which may or may not matter).
 	UFUNCTION(NetMulticast, Unreliable)
 	void MulticastNoTickCastStart(UCombatAbility* Ability);
-	TMap<FPredictedTick, bool> PredictedTickRecord;
+	FPredictedTickWindow PredictedTickRecord;
 	TArray<FAbilityEvent> TicksAwaitingParams;
 	TMap<FPredictedTick, FAbilityParams> ParamsAwaitingTicks;
 	void RemoveExpiredTicks();
-	TMap<FPredictedTick, float> PredictedTickHistory;
 
 //Cancelling
 
@@ -272,6 +279,9 @@ public:
 	void AddCastLengthModifier(const FAbilityModCondition& Modifier) { CastLengthMods.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	void RemoveCastLengthModifier(const FAbilityModCondition& Modifier) { CastLengthMods.Remove(Modifier); }
+	FCombatModifierHandle AddStaticCastLengthModifier(const FCombatModifier& Modifier) { return CastLengthMods.AddStatic(Modifier); }
+	void RemoveStaticCastLengthModifier(const FCombatModifierHandle& Handle) { CastLengthMods.RemoveStatic(Handle); }
+	void UpdateStaticCastLengthModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { CastLengthMods.UpdateStatic(Handle, Modifier); }
 	UFUNCTION(BlueprintPure, Category = "Abilities")
 	float CalculateCastLength(UCombatAbility* Ability) const;
 
@@ -305,6 +315,9 @@ public:
 	void AddGlobalCooldownModifier(const FAbilityModCondition& Modifier) { GlobalCooldownMods.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	void RemoveGlobalCooldownModifier(const FAbilityModCondition& Modifier) { GlobalCooldownMods.Remove(Modifier); }
+	FCombatModifierHandle AddStaticGlobalCooldownModifier(const FCombatModifier& Modifier) { return GlobalCooldownMods.AddStatic(Modifier); }
+	void RemoveStaticGlobalCooldownModifier(const FCombatModifierHandle& Handle) { GlobalCooldownMods.RemoveStatic(Handle); }
+	void UpdateStaticGlobalCooldownModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { GlobalCooldownMods.UpdateStatic(Handle, Modifier); }
 	UFUNCTION(BlueprintPure, Category = "Abilities")
 	float CalculateGlobalCooldownLength(UCombatAbility* Ability) const;
 
@@ -327,6 +340,9 @@ public:
 	void AddCooldownModifier(const FAbilityModCondition& Modifier) { CooldownMods.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	void RemoveCooldownModifier(const FAbilityModCondition& Modifier) { CooldownMods.Remove(Modifier); }
+	FCombatModifierHandle AddStaticCooldownModifier(const FCombatModifier& Modifier) { return CooldownMods.AddStatic(Modifier); }
+	void RemoveStaticCooldownModifier(const FCombatModifierHandle& Handle) { CooldownMods.RemoveStatic(Handle); }
+	void UpdateStaticCooldownModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { CooldownMods.UpdateStatic(Handle, Modifier); }
 	UFUNCTION(BlueprintPure, Category = "Abilities")
 	float CalculateCooldownLength(UCombatAbility* Ability, const bool bIgnoreGlobalMin = false) const;
 
@@ -334,6 +350,43 @@ private:
 	
 	TConditionalModifierList<FAbilityModCondition> CooldownMods;
 
+//Projectile Volleys
+
+public:
+
+	//Sends a volley of simulated projectiles to every client in a single RPC, instead of replicating each projectile.
+	void ReplicateProjectileVolley(const FProjectileVolley& Volley) { MulticastProjectileVolley(Volley); }
+	//Tells clients that one of the server's volley projectiles hit something, so they can remove their local copy.
+	void ReplicateVolleyProjectileHit(const FPredictedTick& SourceTick, const int32 ID) { MulticastVolleyProjectileHit(SourceTick, ID); }
+
+private:
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileVolley(const FProjectileVolley& Volley);
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastVolleyProjectileHit(const FPredictedTick& SourceTick, const int32 ID);
+
+//Simulated Events
+
+public:
+
+	//Called on clients with one frame of relayed ability events, to hand each event to the component that owns its ability.
+	static void HandleSimulatedAbilityEvents(const FSimulatedAbilityEvents& Events);
+
+private:
+
+	UPROPERTY()
+	USimulatedAbilityEventSubsystem* SimulatedEventRelay = nullptr;
+	//These run the event locally and then either queue it with the relay or fall back to the matching multicast.
+	void ReplicateNoTickCastStart(UCombatAbility* Ability);
+	void ReplicateAbilityTick(const FAbilityEvent& Event);
+	void ReplicateAbilityCancel(const FCancelEvent& Event);
+	void ReplicateAbilityInterrupt(const FInterruptEvent& InterruptEvent);
+	void HandleSimulatedNoTickCastStart(UCombatAbility* Ability);
+	void HandleSimulatedAbilityTick(const FAbilityEvent& Event);
+	void HandleSimulatedAbilityCancel(const FCancelEvent& Event);
+	void HandleSimulatedAbilityInterrupt(const FInterruptEvent& InterruptEvent);
+
 //Cost
 
 public:
@@ -357,4 +410,6 @@ protected:
 	UCombatDebugOptions* CombatDebugOptions = nullptr;
 
 #pragma endregion 
+
+	friend class FUnackedAbilityPredictionCapTest;
 };
\ No newline at end of file
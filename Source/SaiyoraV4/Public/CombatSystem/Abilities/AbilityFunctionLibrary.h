@@ -1,12 +1,14 @@
 ﻿#pragma once
 #include "CoreMinimal.h"
 #include "GroundAttack.h"
+#include "ProjectileSimulationSubsystem.h"
 #include "SaiyoraPlayerCharacter.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "AbilityFunctionLibrary.generated.h"
 
 class UHitbox;
 class APredictableProjectile;
+struct FHitboxRewindQuery;
 struct FAbilityOrigin;
 struct FAbilityTargetSet;
 class UCombatAbility;
@@ -84,6 +86,38 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Abilities", meta = (DefaultToSelf = "Ability", HidePin = "Ability"))
 	static APredictableProjectile* ValidateProjectile(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter, const TSubclassOf<APredictableProjectile> ProjectileClass,
 		const ESaiyoraPlane ProjectilePlane, const EFaction ProjectileHostility, const FAbilityOrigin& Origin);
+	//Versions of PredictProjectile and ValidateProjectile for non-homing projectiles that are simulated by the projectile subsystem instead of spawned as actors.
+	//Returns the projectile's ID, which is also passed to OnHit, or -1 if no projectile was spawned.
+	UFUNCTION(BlueprintCallable, Category = "Abilities", meta = (DefaultToSelf = "Ability", HidePin = "Ability"))
+	static int32 PredictSimulatedProjectile(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter, const FSimulatedProjectileParams& Params,
+		const FSimulatedProjectileCallback& OnHit, FAbilityOrigin& OutOrigin);
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Abilities", meta = (DefaultToSelf = "Ability", HidePin = "Ability"))
+	static int32 ValidateSimulatedProjectile(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter, const FSimulatedProjectileParams& Params,
+		const FSimulatedProjectileCallback& OnHit, const FAbilityOrigin& Origin);
+	//Spawns a volley of simulated projectiles spread randomly within a cone. The spread is seeded from the ability's current tick, so the client and server generate the same pellets.
+	//The server sends the volley to other clients in one RPC, and they simulate it locally. Returns the ID of the first projectile, the rest of the volley has consecutive IDs.
+	UFUNCTION(BlueprintCallable, Category = "Abilities", meta = (DefaultToSelf = "Ability", HidePin = "Ability"))
+	static int32 PredictSimulatedVolley(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter, const FSimulatedProjectileParams& Params, const int32 Count,
+		const float SpreadAngle, const FSimulatedProjectileCallback& OnHit, FAbilityOrigin& OutOrigin);
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Abilities", meta = (DefaultToSelf = "Ability", HidePin = "Ability"))
+	static int32 ValidateSimulatedVolley(UCombatAbility* Ability, ASaiyoraPlayerCharacter* Shooter, const FSimulatedProjectileParams& Params, const int32 Count,
+		const float SpreadAngle, const FSimulatedProjectileCallback& OnHit, const FAbilityOrigin& Origin);
+	//Spawns simulated projectiles on the server without prediction or validation, for shooters that don't predict, such as NPCs.
+	//They are replicated to clients the same way as a validated volley. Returns the ID of the first projectile, or -1 if none were spawned.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Abilities", meta = (DefaultToSelf = "Ability", HidePin = "Ability"))
+	static int32 FireSimulatedProjectiles(UCombatAbility* Ability, const FSimulatedProjectileParams& Params, const FVector& Origin, const FVector& AimDirection,
+		const FSimulatedProjectileCallback& OnHit, const int32 Count = 1, const float SpreadAngle = 0.0f);
+
+private:
+
+	//Aims a projectile from the origin toward whatever is under the crosshair, as long as that is within the aim tolerance.
+	static FRotator GetProjectileAimRotation(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin, const ESaiyoraPlane ProjectilePlane);
+	//Checks a client's aim location and origin against where the server sees the shooter, allowing for how far they could have moved within their ping.
+	//If either is too far off, the server's own origin info is used instead.
+	static FAbilityOrigin GetValidatedProjectileOrigin(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin);
+	//Sends simulated projectiles the server just spawned to every client as a single volley RPC. Does nothing in standalone.
+	static void ReplicateSimulatedVolley(UCombatAbility* Ability, const FProjectileSource& Source, const FVector& Origin, const FVector& AimDirection,
+		const int32 Count, const float SpreadAngle, const float CatchUpTime, const FSimulatedProjectileParams& Params);
 
 #pragma endregion 
 
@@ -92,6 +126,8 @@ private:
 	static constexpr float CamTraceLength = 10000.0f;
 	static constexpr float RewindTraceRadius = 300.0f;
 	static constexpr float AimToleranceDegrees = 15.0f;
+	static constexpr float OriginToleranceDistance = 100.0f;
+	static constexpr int32 MaxVolleyCount = 32;
 
 	//Add Spawning
 
@@ -156,14 +192,31 @@ public:
 private:
 	
 	static void GenerateOriginInfo(const ASaiyoraPlayerCharacter* Shooter, FAbilityOrigin& OutOrigin);
-	static void RewindRelevantHitboxesForShooter(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin, const TArray<AActor*>& Targets,
-		const TArray<AActor*>& ActorsToIgnore, TMap<UHitbox*, FTransform>& ReturnTransforms);
-	static void RewindHitboxesToTimestamp(const TArray<UHitbox*>& Hitboxes, const float Timestamp, TMap<UHitbox*, FTransform>& ReturnTransforms);
-	static void UnrewindHitboxes(const TMap<UHitbox*, FTransform>& ReturnTransforms);
+	//Builds a query of the rewound hitboxes of all targets and anything else in front of the shooter's aim, at the time the shooter would have seen them.
+	static void GetRewindQueryForShooter(const ASaiyoraPlayerCharacter* Shooter, const FAbilityOrigin& Origin, const TArray<AActor*>& Targets,
+		const TArray<AActor*>& ActorsToIgnore, const EFaction TraceHostility, FHitboxRewindQuery& OutQuery);
+	//Feeds the combat net subsystem's per-frame validation counters.
+	static void RecordShotValidation(const ASaiyoraPlayerCharacter* Shooter, const int32 NumPredicted, const int32 NumValidated);
+	//Traces level geometry in the physics scene and hitboxes in the rewind query, returning the closest blocking hit of either.
+	static void RewindTraceSingle(const ASaiyoraPlayerCharacter* Shooter, const FHitboxRewindQuery& RewindQuery, const FVector& Start, const FVector& End,
+		const float Radius, const ESaiyoraPlane TracePlane, const TArray<AActor*>& ActorsToIgnore, FHitResult& OutHit);
+	//Traces level geometry in the physics scene and hitboxes in the rewind query, returning every hitbox hit in front of the first blocking geometry hit, followed by the geometry hit.
+	static void RewindTraceMulti(const ASaiyoraPlayerCharacter* Shooter, const FHitboxRewindQuery& RewindQuery, const FVector& Start, const FVector& End,
+		const float Radius, const ESaiyoraPlane TracePlane, const TArray<AActor*>& ActorsToIgnore, TArray<FHitResult>& OutHits);
+	static FName GetRelevantGeometryTraceProfile(const ESaiyoraPlane TracePlane);
 	static float GetCameraTraceMaxRange(const FVector& CameraLoc, const FVector& AimDir, const FVector& OriginLoc, const float TraceRange);
 	
-	static void GetRelevantHitboxObjectTypes(const ASaiyoraPlayerCharacter* Shooter, const EFaction TraceHostility, TArray<TEnumAsByte<EObjectTypeQuery>>& OutObjectTypes);
-	static void GetRelevantCollisionObjectTypes(const ESaiyoraPlane ProjectilePlane, TArray<TEnumAsByte<EObjectTypeQuery>>& OutObjectTypes);
+	//Object type bitmasks for FCollisionObjectQueryParams, so that object traces don't need to build an array of object types.
+	static int32 GetRelevantHitboxObjectMask(const AActor* Shooter, const EFaction TraceHostility);
+	static int32 GetRelevantCollisionObjectMask(const ESaiyoraPlane ProjectilePlane);
+	//Table lookups behind GetRelevantTraceProfile and GetRelevantHitboxObjectMask, once the shooter's faction is known.
+	static FName GetTraceProfileForFaction(const EFaction ShooterFaction, const bool bOverlap, const ESaiyoraPlane TracePlane, const EFaction TraceHostility);
+	static int32 GetHitboxObjectMaskForFaction(const EFaction ShooterFaction, const EFaction TraceHostility);
+	//Sphere traces for every hitbox matching the object mask, ignoring the shooter.
+	static void SweepHitboxesByObjectMask(const AActor* Shooter, const FVector& Start, const FVector& End, const float Radius, const int32 ObjectMask,
+		const TArray<AActor*>& ActorsToIgnore, const bool bDrawDebug, TArray<FHitResult>& OutHits);
 
 #pragma endregion 
+
+	friend class FCombatProfileTableBenchmarkTest;
 };
@@ -96,14 +96,18 @@ struct FAbilityOrigin
     FVector Origin = FVector::ZeroVector;
 
     void Clear() { AimLocation = FVector::ZeroVector; AimDirection = FVector::ZeroVector; Origin = FVector::ZeroVector; }
-    
-    friend FArchive& operator<<(FArchive& Ar, FAbilityOrigin& Origin)
+
+    //Locations are quantized to two decimal places. Unit aim directions are sent as 16 bits per component. An empty origin is a single bit.
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbilityOrigin> : public TStructOpsTypeTraitsBase2<FAbilityOrigin>
+{
+    enum
     {
-        Ar << Origin.AimLocation;
-        Ar << Origin.AimDirection;
-        Ar << Origin.Origin;
-        return Ar;
-    }
+        WithNetSerializer = true,
+    };
 };
 
 USTRUCT(BlueprintType)
@@ -120,12 +124,22 @@ struct FAbilityTargetSet
     FAbilityTargetSet(const int32 InSetID) : SetID(InSetID) {}
     FAbilityTargetSet(const int32 InSetID, const TArray<AActor*>& InTargets) : SetID(InSetID), Targets(InTargets) {}
 
-    friend FArchive& operator<<(FArchive& Ar, FAbilityTargetSet& TargetSet)
+    //Upper bounds on incoming target data, so a malformed request can't make the server allocate arbitrarily large arrays.
+    static constexpr uint32 MaxSerializedSets = 32;
+    static constexpr uint32 MaxSerializedTargets = 256;
+
+    //Set IDs and counts are packed, and targets are sent as net GUIDs.
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+    static bool NetSerializeSets(FArchive& Ar, UPackageMap* Map, TArray<FAbilityTargetSet>& TargetSets, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbilityTargetSet> : public TStructOpsTypeTraitsBase2<FAbilityTargetSet>
+{
+    enum
     {
-        Ar << TargetSet.SetID;
-        Ar << TargetSet.Targets;
-        return Ar;
-    }
+        WithNetSerializer = true,
+    };
 };
 
 USTRUCT()
@@ -159,6 +173,20 @@ struct FAbilityEvent
     FAbilityOrigin Origin;
     UPROPERTY(BlueprintReadOnly)
     TArray<FAbilityTargetSet> Targets;
+
+    static constexpr uint32 MaxSerializedFailReasons = 32;
+
+    //Ability ticks are multicast to every client, so IDs, ticks, and counts are packed and the origin is quantized.
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbilityEvent> : public TStructOpsTypeTraitsBase2<FAbilityEvent>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
 };
 
 USTRUCT(BlueprintType)
@@ -236,6 +264,33 @@ struct FInterruptEvent
     int32 ElapsedTicks = 0;
 };
 
+//Every simulated ability event one connection needs from a single frame, sent together instead of one multicast per event.
+//Events can come from any number of ability components. Each is routed back to its ability's component on the client.
+USTRUCT()
+struct FSimulatedAbilityEvents
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<UCombatAbility*> NoTickCastStarts;
+    UPROPERTY()
+    TArray<FAbilityEvent> Ticks;
+    UPROPERTY()
+    TArray<FCancelEvent> Cancels;
+    UPROPERTY()
+    TArray<FInterruptEvent> Interrupts;
+
+    bool IsEmpty() const { return NoTickCastStarts.Num() == 0 && Ticks.Num() == 0 && Cancels.Num() == 0 && Interrupts.Num() == 0; }
+    void Reset() { NoTickCastStarts.Reset(); Ticks.Reset(); Cancels.Reset(); Interrupts.Reset(); }
+    void Append(const FSimulatedAbilityEvents& Other)
+    {
+        NoTickCastStarts.Append(Other.NoTickCastStarts);
+        Ticks.Append(Other.Ticks);
+        Cancels.Append(Other.Cancels);
+        Interrupts.Append(Other.Interrupts);
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FGlobalCooldown
 {
@@ -282,6 +337,7 @@ struct FClientAbilityPrediction
     
     UPROPERTY()
     UCombatAbility* Ability = nullptr;
+    int32 PredictionID = 0;
     bool bPredictedGCD = false;
     float GcdLength = 0.0f;
     float Time = 0.0f;
@@ -307,6 +363,40 @@ FORCEINLINE uint32 GetTypeHash(const FPredictedTick& Tick)
     return HashCombine(GetTypeHash(Tick.PredictionID), GetTypeHash(Tick.TickNumber));
 }
 
+//Fixed-size record of which predicted ticks the server has processed and whether each one succeeded.
+//Slots are indexed by prediction ID, so each new prediction takes over the slot of the prediction WindowSize IDs before it.
+//Anything older than the window counts as already processed and failed, since a request that old can only be a duplicate or a stale replay.
+struct FPredictedTickWindow
+{
+    static constexpr int32 WindowSize = 256;
+    static constexpr int32 MaskedTicks = 64;
+
+    void Record(const FPredictedTick& Tick, const bool bSuccess);
+    //Returns whether the tick has been processed, and outputs the result if so.
+    bool Find(const FPredictedTick& Tick, bool& bOutSuccess) const;
+    bool Contains(const FPredictedTick& Tick) const { bool bSuccess; return Find(Tick, bSuccess); }
+
+private:
+
+    struct FSlot
+    {
+        bool bInUse = false;
+        int32 PredictionID = 0;
+        uint64 ProcessedTicks = 0;
+        uint64 SuccessfulTicks = 0;
+        //Results for ticks past the bitmask. Channels almost never run this long, and this is emptied when the slot is reused.
+        TArray<TPair<int32, bool>> OverflowTicks;
+    };
+    FSlot Slots[WindowSize];
+    bool bHasRecords = false;
+    int32 NewestPredictionID = 0;
+
+    static int32 GetSlotIndex(const int32 PredictionID) { return static_cast<uint32>(PredictionID) % WindowSize; }
+    bool IsOutsideWindow(const int32 PredictionID) const { return bHasRecords && PredictionID <= NewestPredictionID - WindowSize; }
+
+    friend class FPredictedTickWindowTest;
+};
+
 USTRUCT(BlueprintType)
 struct FResourceCostModMap
 {
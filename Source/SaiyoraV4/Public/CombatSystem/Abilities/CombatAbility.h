@@ -77,6 +77,9 @@ public:
     bool IsAutomatic() const { return bAutomatic; }
     UFUNCTION(BlueprintPure, Category = "Abilities")
     bool WillCancelOnRelease() const { return bCancelOnRelease; }
+    //Returns the index of a visual class in this ability's projectile visuals, or INDEX_NONE if it isn't listed.
+    int32 GetProjectileVisualIndex(const TSubclassOf<AActor> VisualClass) const { return ProjectileVisuals.Find(VisualClass); }
+    TSubclassOf<AActor> GetProjectileVisual(const int32 Index) const { return ProjectileVisuals.IsValidIndex(Index) ? ProjectileVisuals[Index] : nullptr; }
     
 protected:
     
@@ -96,6 +99,9 @@ protected:
     bool bAutomatic = false;
     UPROPERTY(EditDefaultsOnly, Category = "Info")
     bool bCancelOnRelease = false;
+    //Visual classes of simulated projectiles this ability fires. Replicated volleys send an index into this list instead of the class itself.
+    UPROPERTY(EditDefaultsOnly, Category = "Info")
+    TArray<TSubclassOf<AActor>> ProjectileVisuals;
 
 #pragma endregion 
 #pragma region Restrictions
@@ -103,7 +109,11 @@ protected:
 public:
 
     UFUNCTION(BlueprintPure, Category = "Abilities")
-    bool IsCastable(TArray<ECastFailReason>& FailReasons) const { FailReasons = CastFailReasons; return CastFailReasons.Num() == 0; }
+    bool IsCastable(TArray<ECastFailReason>& FailReasons) const;
+    //Each fail reason is stored as a single bit, so callers that only need to check for specific reasons can test the mask without building an array.
+    static constexpr uint32 CastFailBit(const ECastFailReason FailReason) { return 1u << static_cast<uint8>(FailReason); }
+    uint32 GetCastFailMask() const { return CastFailMask; }
+    bool HasCastFailReason(const ECastFailReason FailReason) const { return (CastFailMask & CastFailBit(FailReason)) != 0; }
     UFUNCTION(BlueprintPure, Category = "Abilities")
     bool IsCastableWhileDead() const { return bCastableWhileDead; }
     UFUNCTION(BlueprintPure, Category = "Abilities")
@@ -134,27 +144,35 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Restrictions", meta = (AllowPrivateAccess = "true"))
     bool bCastableWhileMoving = true;
 
+    //Re-derives every fail reason. Only needed on initialization, since each source of a fail reason updates its own bit when it changes.
     void UpdateCastable();
-    virtual void AdditionalCastableUpdate(TArray<ECastFailReason>& AdditionalFailReasons) {}
+    //Virtual for derived ability classes to set any additional fail reasons during a full castable update.
+    virtual void AdditionalCastableUpdate() {}
+    void SetCastFailReason(const ECastFailReason FailReason, const bool bActive);
     
 private:
     
-    TArray<ECastFailReason> CastFailReasons;
+    uint32 CastFailMask = 0;
+    //The mask as of the last OnCastableChanged broadcast. Changes are broadcast at most once per frame.
+    uint32 BroadcastCastFailMask = 0;
+    bool bCastableBroadcastPending = false;
+    void BroadcastCastableChanged();
+    void UpdateChargesCastable() { SetCastFailReason(ECastFailReason::ChargesNotMet, GetCurrentCharges() < GetChargeCost()); }
     TSet<FGameplayTag> CustomCastRestrictions;
     TSet<FGameplayTag> RestrictedTags;
     UPROPERTY(ReplicatedUsing = OnRep_TagsRestricted)
     bool bTagsRestricted = false;
     UFUNCTION()
-    void OnRep_TagsRestricted() { UpdateCastable(); }
+    void OnRep_TagsRestricted() { SetCastFailReason(ECastFailReason::CustomRestriction, bTagsRestricted); }
 
     UFUNCTION()
-    void OnLifeStatusChanged(AActor* Actor, const ELifeStatus Previous, const ELifeStatus New) { UpdateCastable(); }
+    void OnLifeStatusChanged(AActor* Actor, const ELifeStatus Previous, const ELifeStatus New) { SetCastFailReason(ECastFailReason::Dead, New != ELifeStatus::Alive); }
     UFUNCTION()
-    void OnMovementChanged(AActor* Actor, const bool bNewMovement) { UpdateCastable(); }
+    void OnMovementChanged(AActor* Actor, const bool bNewMovement) { SetCastFailReason(ECastFailReason::Moving, bNewMovement); }
     UFUNCTION()
-    void OnGlobalCooldownChanged(const FGlobalCooldown& Previous, const FGlobalCooldown& New) { UpdateCastable(); }
+    void OnGlobalCooldownChanged(const FGlobalCooldown& Previous, const FGlobalCooldown& New) { SetCastFailReason(ECastFailReason::OnGlobalCooldown, New.bActive); }
     UFUNCTION()
-    void OnCastStateChanged(const FCastingState& Previous, const FCastingState& New) { UpdateCastable(); }
+    void OnCastStateChanged(const FCastingState& Previous, const FCastingState& New) { SetCastFailReason(ECastFailReason::AlreadyCasting, New.bIsCasting); }
 
     UPROPERTY()
     UDamageHandler* DamageHandlerRef = nullptr;
@@ -323,9 +341,9 @@ private:
     void RecalculatePredictedCooldown();
     
     void OnMaxChargesUpdated(const int32 OldValue, const int32 NewValue);
-    void OnChargeCostUpdated(const int32 OldValue, const int32 NewValue) { UpdateCastable(); }
+    void OnChargeCostUpdated(const int32 OldValue, const int32 NewValue) { UpdateChargesCastable(); }
     UFUNCTION()
-    void OnRep_ChargeCost() { UpdateCastable(); }
+    void OnRep_ChargeCost() { UpdateChargesCastable(); }
 
 #pragma endregion 
 #pragma region Costs
@@ -137,6 +137,10 @@ public:
 	//Called by the handler after creating a new buff to set it up on the server
 	void InitializeBuff(FBuffApplyEvent& Event, UBuffHandler* NewHandler, const bool bIgnoreRestrictions, const EBuffApplicationOverrideType StackOverrideType,
 		const int32 OverrideStacks, const EBuffApplicationOverrideType RefreshOverrideType, const float OverrideDuration);
+	//Gets whether removed instances of this buff are recycled by the buff pool
+	bool IsPoolable() const { return bPoolable; }
+	//Called by the buff pool on the server before storing a removed instance, to clear out its state and replicated events from the last application
+	void ResetForReuse();
 	//Called by the handler on subsequent applications to try and stack or refresh this buff on the server
 	void ApplyEvent(FBuffApplyEvent& ApplicationEvent, EBuffApplicationOverrideType const StackOverrideType,
 		const int32 OverrideStacks, const EBuffApplicationOverrideType RefreshOverrideType, const float OverrideDuration);
@@ -185,6 +189,10 @@ private:
 	//Whether the buff is removed from NPCs when they leave combat
 	UPROPERTY(EditDefaultsOnly, Category = "Application Behavior")
 	bool bRemoveOnCombatEnd = true;
+	//Whether instances of this buff are recycled after removal instead of being garbage collected. Meant for buffs that are applied very frequently.
+	//Any state added in child classes has to be reset in OnRecycled.
+	UPROPERTY(EditDefaultsOnly, Category = "Application Behavior")
+	bool bPoolable = false;
 	//The application event for the initial application of this buff instance
 	UPROPERTY(ReplicatedUsing = OnRep_CreationEvent)
 	FBuffApplyEvent CreationEvent;
@@ -210,8 +218,12 @@ public:
 private:
 
 	//The reason this buff was removed
-	UPROPERTY(ReplicatedUsing = OnRep_RemovalReason)
+	UPROPERTY(Replicated)
 	EBuffExpireReason RemovalReason;
+	//Incremented by the server every time this buff is removed. Pooled buffs can be removed for the same reason on consecutive applications,
+	//and the reason alone wouldn't change (or replicate) if the client never saw it reset in between.
+	UPROPERTY(ReplicatedUsing = OnRep_RemovalReason)
+	uint8 RemovalSerial = 0;
 	//Used for clients to call TerminateBuff locally and clean themselves up
 	UFUNCTION()
 	void OnRep_RemovalReason();
@@ -271,6 +283,8 @@ private:
 	//Used by clients to update the buff locally after application events
 	UFUNCTION()
 	void OnRep_LastApplyEvent();
+	//Clears non-replicated state so that a recycled instance can be initialized again. Used on the server when pooling, and on clients when a pooled instance is reused.
+	void ResetLocalState();
 
 #pragma endregion
 #pragma region Buff Functions
@@ -289,6 +303,10 @@ protected:
 	UFUNCTION(BlueprintNativeEvent)
 	void OnRemove(const FBuffRemoveEvent& Event);
 	virtual void OnRemove_Implementation(const FBuffRemoveEvent& Event) {}
+	//Blueprint-exposed event for resetting any custom state before a poolable buff is reused
+	UFUNCTION(BlueprintNativeEvent)
+	void OnRecycled();
+	virtual void OnRecycled_Implementation() {}
 	
 private:
 	
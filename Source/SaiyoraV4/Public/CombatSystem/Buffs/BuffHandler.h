@@ -5,6 +5,8 @@
 #include "Components/ActorComponent.h"
 #include "BuffHandler.generated.h"
 
+class UBuffPoolSubsystem;
+class UCombatEventSubsystem;
 class UNPCAbilityComponent;
 class USaiyoraMovementComponent;
 class UThreatHandler;
@@ -13,6 +15,61 @@ class UStatHandler;
 class UDamageHandler;
 class UCombatStatusComponent;
 
+//Secondary lookups into one of a buff handler's buff arrays, updated whenever a buff is added or removed.
+//The other actor is the applier for incoming buffs and the target for outgoing buffs.
+//Each bucket keeps application order, so the first valid entry is the same buff a linear scan of the main array would find.
+//Outgoing buffs are outered to other actors, so entries are object keys that don't keep buffs alive, and lookups skip any buff that has been destroyed.
+struct FBuffLookupIndex
+{
+	typedef TArray<TObjectKey<UBuff>> FBucket;
+
+	void Add(UBuff* Buff, const AActor* OtherActor);
+	void Remove(const UBuff* Buff);
+	//Drops every entry indexed under an actor, for when that actor is going away.
+	void RemoveAllForActor(const AActor* OtherActor);
+
+	const FBucket* FindByClass(const UClass* BuffClass) const { return ByClass.Find(BuffClass); }
+	const FBucket* FindByActor(const AActor* OtherActor) const { return ByActor.Find(OtherActor); }
+	const FBucket* FindByClassAndActor(const UClass* BuffClass, const AActor* OtherActor) const { return ByClassAndActor.Find(FClassActorKey(BuffClass, OtherActor)); }
+	const FBucket* FindByTag(const FGameplayTag Tag) const { return ByTag.Find(Tag); }
+
+	static void GetValidBuffs(const FBucket* Bucket, TArray<UBuff*>& OutBuffs);
+	static UBuff* GetFirstValidBuff(const FBucket* Bucket);
+
+private:
+
+	typedef TPair<TObjectKey<UClass>, TObjectKey<AActor>> FClassActorKey;
+
+	//What a buff was indexed under, so it can be removed without dereferencing a buff that may already be gone.
+	struct FIndexedBuff
+	{
+		TObjectKey<UClass> Class;
+		TObjectKey<AActor> Actor;
+		FGameplayTagContainer Tags;
+	};
+
+	TMap<TObjectKey<UClass>, FBucket> ByClass;
+	TMap<TObjectKey<AActor>, FBucket> ByActor;
+	TMap<FClassActorKey, FBucket> ByClassAndActor;
+	TMap<FGameplayTag, FBucket> ByTag;
+	TMap<TObjectKey<UBuff>, FIndexedBuff> IndexedBuffs;
+
+	void RemoveByKey(const TObjectKey<UBuff>& BuffKey);
+
+	template <typename KeyType>
+	static void RemoveFromBucket(TMap<KeyType, FBucket>& Map, const KeyType& Key, const TObjectKey<UBuff>& BuffKey)
+	{
+		if (FBucket* Bucket = Map.Find(Key))
+		{
+			Bucket->RemoveSingle(BuffKey);
+			if (Bucket->Num() == 0)
+			{
+				Map.Remove(Key);
+			}
+		}
+	}
+};
+
 //Component that handles applying and removing buffs to and from the owning actor.
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SAIYORAV4_API UBuffHandler : public UActorComponent
@@ -26,6 +83,7 @@ public:
 	UBuffHandler();
 	virtual void BeginPlay() override;
 	virtual void InitializeComponent() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 private:
@@ -44,6 +102,10 @@ private:
 	USaiyoraMovementComponent* MovementComponentRef;
 	UPROPERTY()
 	UNPCAbilityComponent* NPCComponentRef;
+	UPROPERTY()
+	UBuffPoolSubsystem* BuffPool;
+	UPROPERTY()
+	UCombatEventSubsystem* CombatEventBus;
 
 #pragma endregion 
 #pragma region Incoming Buffs
@@ -76,6 +138,9 @@ public:
 	//Get an existing buff of a given class, optionally from a specific owner.
 	UFUNCTION(BlueprintPure, Category = "Buff")
 	UBuff* FindExistingBuff(const TSubclassOf<UBuff> BuffClass, const bool bSpecificOwner = false, const AActor* BuffOwner = nullptr) const;
+	//Get buffs applied to this actor that have a specific tag. Only exact tag matches are returned.
+	UFUNCTION(BlueprintPure, Category = "Buff")
+	void GetBuffsWithTag(const FGameplayTag Tag, TArray<UBuff*>& OutBuffs) const;
 
 	//Called when any buff is applied to this actor.
 	UPROPERTY(BlueprintAssignable)
@@ -105,7 +170,9 @@ private:
 	//Active buffs applied to this actor.
 	UPROPERTY()
 	TArray<UBuff*> ActiveBuffs;
-	//Called after removing a buff on the server to stop replicating it and drop the pointer.
+	//Lookups into ActiveBuffs by class, applier, and tag.
+	FBuffLookupIndex ActiveBuffIndex;
+	//Called after removing a buff on the server to stop replicating it and drop the pointer, or return it to the buff pool.
 	UFUNCTION()
 	void PostRemoveCleanup(UBuff* Buff);
 	//Array of recently removed buffs on the server that we still want to replicate for a short time.
@@ -139,6 +206,9 @@ public:
 	//Find a buff of a given class that this actor has applied, optionally to a specific target.
 	UFUNCTION(BlueprintPure, Category = "Buff")
 	UBuff* FindExistingOutgoingBuff(const TSubclassOf<UBuff> BuffClass, const bool bSpecificTarget = false, const AActor* BuffTarget = nullptr) const;
+	//Get all buffs applied by this actor that have a specific tag. Only exact tag matches are returned.
+	UFUNCTION(BlueprintPure, Category = "Buff")
+	void GetOutgoingBuffsWithTag(const FGameplayTag Tag, TArray<UBuff*>& OutBuffs) const;
 
 	//Delegate called any time this actor applies a buff to another actor.
 	UPROPERTY(BlueprintAssignable)
@@ -158,12 +228,16 @@ public:
 	void NotifyOfNewOutgoingBuff(const FBuffApplyEvent& ApplicationEvent);
 	//Called when an outgoing buff is removed so that we can remove it from our array and fire off delegates.
 	void NotifyOfOutgoingBuffRemoval(const FBuffRemoveEvent& RemoveEvent);
+	//Called when an actor we have applied buffs to ends play, since those buffs are destroyed with it without being removed.
+	void ReleaseOutgoingBuffsOnActor(const AActor* Target);
 	
 private:
 
 	//All buffs this actor has applied to other actors.
 	UPROPERTY()
 	TArray<UBuff*> OutgoingBuffs;
+	//Lookups into OutgoingBuffs by class, target, and tag.
+	FBuffLookupIndex OutgoingBuffIndex;
 	//Restrictions on outgoing buffs applied by this actor.
 	TConditionalRestrictionList<FBuffRestriction> OutgoingBuffRestrictions;
 
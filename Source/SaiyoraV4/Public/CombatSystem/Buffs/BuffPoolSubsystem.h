@@ -0,0 +1,39 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BuffPoolSubsystem.generated.h"
+
+class UBuff;
+
+USTRUCT()
+struct FBuffPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UBuff*> FreeBuffs;
+};
+
+//Subsystem that recycles removed buff instances (and the buff functions instanced inside them) instead of letting them be garbage collected.
+//Pools are kept per actor, since buffs are replicated subobjects of the actor they are applied to.
+//Reusing an instance on the same actor means clients reuse their copy of the same subobject, instead of a stale copy from a different actor.
+UCLASS()
+class SAIYORAV4_API UBuffPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//Returns a recycled buff of the given class outered to the given actor if one is available, otherwise creates a new one.
+	UBuff* AcquireBuff(AActor* AppliedTo, const TSubclassOf<UBuff> BuffClass);
+	//Resets a removed buff and stores it for reuse. Buffs that aren't poolable are left to be garbage collected.
+	void ReleaseBuff(UBuff* Buff);
+	//Drops every pooled buff for an actor, called when that actor's buff handler ends play.
+	void ReleaseActor(const AActor* Actor) { Pools.Remove(Actor); }
+
+private:
+
+	static constexpr int32 MaxPooledBuffsPerActor = 16;
+	UPROPERTY()
+	TMap<const AActor*, FBuffPool> Pools;
+};
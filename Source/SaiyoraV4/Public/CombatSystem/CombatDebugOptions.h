@@ -34,7 +34,7 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = "Net")
 	bool bDrawRewindHitboxes = false;
-	void DrawRewindHitbox(const UHitbox* Hitbox, const FTransform& PreviousTransform);
+	void DrawRewindHitbox(const UHitbox* Hitbox, const FTransform& RewoundTransform);
 
 	UPROPERTY(EditAnywhere, Category = "Net")
 	bool bDrawHiddenProjectiles = false;
@@ -87,16 +87,23 @@ public:
 
 	virtual void SetupBuffFunction() override;
 	virtual void OnApply(const FBuffApplyEvent& ApplyEvent) override;
+	virtual void OnChange(const FBuffApplyEvent& ApplyEvent) override;
 	virtual void OnRemove(const FBuffRemoveEvent& RemoveEvent) override;
 
 private:
 
 	UPROPERTY(EditAnywhere, Category = "Health Event")
 	ECombatEventDirection EventDirection = ECombatEventDirection::Incoming;
-	UPROPERTY(EditAnywhere, Category = "Health Event", meta = (GetOptions = "GetHealthEventModifierFunctionNames"))
+	//Modifiers that don't depend on the event can skip the modifier function and be folded into the handler's cached modifier terms.
+	UPROPERTY(EditAnywhere, Category = "Health Event")
+	bool bIgnoresEventContext = false;
+	UPROPERTY(EditAnywhere, Category = "Health Event", meta = (EditCondition = "bIgnoresEventContext"))
+	FCombatModifier StaticModifier;
+	UPROPERTY(EditAnywhere, Category = "Health Event", meta = (GetOptions = "GetHealthEventModifierFunctionNames", EditCondition = "!bIgnoresEventContext"))
 	FName ModifierFunctionName;
 	
 	FHealthEventModCondition Modifier;
+	FCombatModifierHandle StaticModifierHandle;
 	UPROPERTY()
 	UDamageHandler* TargetHandler = nullptr;
 
@@ -14,6 +14,7 @@ class UBuffHandler;
 class UCombatStatusComponent;
 class ADungeonGameState;
 class UNPCAbilityComponent;
+class UCombatEventSubsystem;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SAIYORAV4_API UDamageHandler : public UActorComponent
@@ -39,6 +40,10 @@ private:
 	APawn* OwnerAsPawn = nullptr;
 	UPROPERTY()
 	ADungeonGameState* GameStateRef = nullptr;
+	UPROPERTY()
+	UCombatEventSubsystem* CombatEventBus = nullptr;
+	//Lets the combat event bus know health, max health, or absorb changed this frame, for subscribers that only need to refresh once per frame.
+	void QueueHealthChange();
 
 	UFUNCTION()
 	void OnCombatBehaviorChanged(const ENPCCombatBehavior PreviousBehavior, const ENPCCombatBehavior NewBehavior);
@@ -195,11 +200,18 @@ public:
 	FHealthEvent ApplyHealthEvent(const EHealthEventType EventType, const float Amount, AActor* AppliedBy, UObject* Source, const EEventHitStyle HitStyle,
 		const EElementalSchool School, const bool bBypassAbsorbs, const bool bIgnoreModifiers, const bool bIgnoreRestrictions, const bool bIgnoreDeathRestrictions,
 		const bool bFromSnapshot, const FHealthEventModCondition& SourceModifier, const FThreatFromDamage& ThreatParams);
+	//Applies the same health event to every target, resolving the attacker's handler, plane, and stat modifiers once for the whole batch.
+	//Returns one event per target, in the same order as Targets. Duplicate targets are only hit once, and their later entries are returned as failed events. The attacker is notified once with every successful event after all targets are processed.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Health")
+	static TArray<FHealthEvent> ApplyHealthEventBatch(const FHealthEventSource& EventSource, const TArray<AActor*>& Targets);
 
 	UPROPERTY(BlueprintAssignable)
 	FHealthEventNotification OnIncomingHealthEvent;
 	UPROPERTY(BlueprintAssignable)
 	FHealthEventNotification OnOutgoingHealthEvent;
+	//Fires once per application with every successful outgoing event from it. Single-target events arrive as a batch of one.
+	UPROPERTY(BlueprintAssignable)
+	FHealthEventArrayNotification OnOutgoingHealthEventBatch;
 	UPROPERTY(BlueprintAssignable)
 	FHealthEventNotification OnKillingBlow;
 
@@ -218,15 +230,23 @@ public:
 	void AddIncomingHealthEventModifier(const FHealthEventModCondition& Modifier) { IncomingHealthEventModifiers.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Health")
 	void RemoveIncomingHealthEventModifier(const FHealthEventModCondition& Modifier) { IncomingHealthEventModifiers.Remove(Modifier); }
+	//Context-free modifiers are folded into cached terms rather than being evaluated for every health event.
+	FCombatModifierHandle AddStaticIncomingHealthEventModifier(const FCombatModifier& Modifier) { return IncomingHealthEventModifiers.AddStatic(Modifier); }
+	void RemoveStaticIncomingHealthEventModifier(const FCombatModifierHandle& Handle) { IncomingHealthEventModifiers.RemoveStatic(Handle); }
+	void UpdateStaticIncomingHealthEventModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { IncomingHealthEventModifiers.UpdateStatic(Handle, Modifier); }
 	float GetModifiedIncomingHealthEventValue(const FHealthEventInfo& EventInfo) const;
 
 	UFUNCTION(BlueprintCallable, Category = "Health")
     void AddOutgoingHealthEventModifier(const FHealthEventModCondition& Modifier) { OutgoingHealthEventModifiers.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Health")
    	void RemoveOutgoingHealthEventModifier(const FHealthEventModCondition& Modifier) { OutgoingHealthEventModifiers.Remove(Modifier); }
+	FCombatModifierHandle AddStaticOutgoingHealthEventModifier(const FCombatModifier& Modifier) { return OutgoingHealthEventModifiers.AddStatic(Modifier); }
+	void RemoveStaticOutgoingHealthEventModifier(const FCombatModifierHandle& Handle) { OutgoingHealthEventModifiers.RemoveStatic(Handle); }
+	void UpdateStaticOutgoingHealthEventModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { OutgoingHealthEventModifiers.UpdateStatic(Handle, Modifier); }
 	float GetModifiedOutgoingHealthEventValue(const FHealthEventInfo& EventInfo, const FHealthEventModCondition& SourceMod) const;
 	
 	void NotifyOfOutgoingHealthEvent(const FHealthEvent& HealthEvent);
+	void NotifyOfOutgoingHealthEventBatch(const TArray<FHealthEvent>& HealthEvents);
 	
 private:
 
@@ -244,8 +264,20 @@ private:
 	TConditionalModifierList<FHealthEventModCondition> IncomingHealthEventModifiers;
 	TConditionalModifierList<FHealthEventModCondition> OutgoingHealthEventModifiers;
 
+	//Finds the attacker's damage handler and current plane. Only needs to happen once per batch.
+	static UDamageHandler* GetHealthEventGenerator(AActor* AppliedBy, ESaiyoraPlane& OutAppliedByPlane);
+	//Stat-based outgoing modifiers don't depend on the target, so batches gather them once and reuse them for each target.
+	void GetOutgoingHealthEventStatModifiers(const EHealthEventType EventType, TArray<FCombatModifier>& OutModifiers) const;
+	float GetModifiedOutgoingHealthEventValue(const FHealthEventInfo& EventInfo, const FHealthEventModCondition& SourceMod, const TArray<FCombatModifier>& StatModifiers) const;
+	//Applies the event to this handler's owner without notifying the attacker or killing the owner, so the caller can order those itself.
+	FHealthEvent ApplyHealthEventInternal(const FHealthEventSource& EventSource, const ESaiyoraPlane AppliedByPlane, UDamageHandler* GeneratorComponent,
+		const TArray<FCombatModifier>& OutgoingStatModifiers);
+	void BroadcastOutgoingHealthEvents(const TArray<FHealthEvent>& HealthEvents);
+
 	UFUNCTION(Client, Unreliable)
 	void ClientNotifyOfIncomingHealthEvent(const FHealthEvent& HealthEvent);
 	UFUNCTION(Client, Unreliable)
     void ClientNotifyOfOutgoingHealthEvent(const FHealthEvent& HealthEvent);
+	UFUNCTION(Client, Unreliable)
+	void ClientNotifyOfOutgoingHealthEventBatch(const TArray<FHealthEvent>& HealthEvents);
 };
\ No newline at end of file
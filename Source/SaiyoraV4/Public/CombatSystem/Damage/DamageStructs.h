@@ -105,6 +105,41 @@ DECLARE_DYNAMIC_DELEGATE_RetVal_OneParam(FCombatModifier, FHealthEventModConditi
 DECLARE_DYNAMIC_DELEGATE_RetVal_OneParam(bool, FDeathRestriction, const FHealthEvent&, HealthEvent);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FHealthEventCallback, const FHealthEvent&, HealthEvent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHealthEventNotification, const FHealthEvent&, HealthEvent);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHealthEventArrayNotification, const TArray<FHealthEvent>&, HealthEvents);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FHealthChangeNotification, AActor*, Actor, const float, PreviousHealth, const float, NewHealth);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FLifeStatusNotification, AActor*, Actor, const ELifeStatus, PreviousStatus, const ELifeStatus, NewStatus);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPendingResNotification, const FPendingResurrection&, PendingResurrection);
\ No newline at end of file
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPendingResNotification, const FPendingResurrection&, PendingResurrection);
+
+//The attacker's half of a health event, shared by every target when applying the same event to multiple actors at once.
+USTRUCT(BlueprintType)
+struct FHealthEventSource
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite)
+    EHealthEventType EventType = EHealthEventType::None;
+    UPROPERTY(BlueprintReadWrite)
+    float Amount = 0.0f;
+    UPROPERTY(BlueprintReadWrite)
+    AActor* AppliedBy = nullptr;
+    UPROPERTY(BlueprintReadWrite)
+    UObject* Source = nullptr;
+    UPROPERTY(BlueprintReadWrite)
+    EEventHitStyle HitStyle = EEventHitStyle::None;
+    UPROPERTY(BlueprintReadWrite)
+    EElementalSchool School = EElementalSchool::None;
+    UPROPERTY(BlueprintReadWrite)
+    bool bBypassAbsorbs = false;
+    UPROPERTY(BlueprintReadWrite)
+    bool bIgnoreModifiers = false;
+    UPROPERTY(BlueprintReadWrite)
+    bool bIgnoreRestrictions = false;
+    UPROPERTY(BlueprintReadWrite)
+    bool bIgnoreDeathRestrictions = false;
+    UPROPERTY(BlueprintReadWrite)
+    bool bFromSnapshot = false;
+    UPROPERTY(BlueprintReadWrite)
+    FHealthEventModCondition SourceModifier;
+    UPROPERTY(BlueprintReadWrite)
+    FThreatFromDamage ThreatParams;
+};
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Hitbox.generated.h"
 
 class ASaiyoraGameState;
+class UDamageHandler;
 class UNPCAbilityComponent;
 class UCombatStatusComponent;
 
@@ -19,6 +20,13 @@ public:
 	UHitbox();
 	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	bool IsNPCHitbox() const { return IsValid(NPCComponentRef); }
+	//NPC hitboxes can only be hit while the NPC is alive and patrolling or in combat.
+	bool IsActiveNPCHitbox() const;
+	//Only set if the owner implements the combat interface.
+	UCombatStatusComponent* GetCombatStatusComponent() const { return CombatStatusComponentRef; }
 	
 private:
 
@@ -29,6 +37,8 @@ private:
 	UNPCAbilityComponent* NPCComponentRef = nullptr;
 	UPROPERTY()
 	UCombatStatusComponent* CombatStatusComponentRef = nullptr;
+	UPROPERTY()
+	UDamageHandler* DamageHandlerRef = nullptr;
 
 	UFUNCTION()
 	void OnCombatBehaviorChanged(const ENPCCombatBehavior PreviousBehavior, const ENPCCombatBehavior NewBehavior);
@@ -0,0 +1,61 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "BuffStructs.h"
+#include "DamageStructs.h"
+#include "ThreatStructs.h"
+#include "WorldSubsystem.h"
+#include "CombatEventSubsystem.generated.h"
+
+class UDamageHandler;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FHealthChangeBatchNotification, TConstArrayView<UDamageHandler*>);
+DECLARE_MULTICAST_DELEGATE_OneParam(FHealthEventBatchNotification, TConstArrayView<FHealthEvent>);
+DECLARE_MULTICAST_DELEGATE_OneParam(FThreatEventBatchNotification, TConstArrayView<FThreatEvent>);
+DECLARE_MULTICAST_DELEGATE_OneParam(FBuffApplyBatchNotification, TConstArrayView<FBuffApplyEvent>);
+DECLARE_MULTICAST_DELEGATE_OneParam(FBuffRemoveBatchNotification, TConstArrayView<FBuffRemoveEvent>);
+
+//Deferred event bus for combat events. Handlers still broadcast their own delegates immediately, but also append each event to a per-frame queue here.
+//At the end of the frame, every queue is dispatched in one pass (health changes, then health events, then threat, then buff applications, then buff removals),
+//so subscribers that don't need to react immediately get every event of a type in a single call instead of one delegate call per event.
+//Events are only queued while something is subscribed to that event type.
+UCLASS()
+class SAIYORAV4_API UCombatEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual TStatId GetStatId() const override;
+	virtual void Tick(float DeltaTime) override;
+
+	void QueueHealthChange(UDamageHandler* Handler) { if (OnHealthChanges.IsBound()) { HealthChanges.Add(Handler); } }
+	void QueueHealthEvent(const FHealthEvent& Event) { if (OnHealthEvents.IsBound()) { HealthEvents.Add(Event); } }
+	void QueueThreatEvent(const FThreatEvent& Event) { if (OnThreatEvents.IsBound()) { ThreatEvents.Add(Event); } }
+	void QueueBuffApplyEvent(const FBuffApplyEvent& Event) { if (OnBuffApplyEvents.IsBound()) { BuffApplyEvents.Add(Event); } }
+	void QueueBuffRemoveEvent(const FBuffRemoveEvent& Event) { if (OnBuffRemoveEvents.IsBound()) { BuffRemoveEvents.Add(Event); } }
+
+	//Damage handlers whose health, max health, or absorb changed this frame, locally or through replication. Each handler is sent once, however many times it changed.
+	FHealthChangeBatchNotification OnHealthChanges;
+	//Health events applied this frame, in the order they were applied. Each event is sent once, from the handler it was applied to.
+	FHealthEventBatchNotification OnHealthEvents;
+	//Successful threat events applied this frame.
+	FThreatEventBatchNotification OnThreatEvents;
+	//Buffs applied to any actor this frame.
+	FBuffApplyBatchNotification OnBuffApplyEvents;
+	//Buffs removed from any actor this frame.
+	FBuffRemoveBatchNotification OnBuffRemoveEvents;
+
+private:
+
+	TSet<TWeakObjectPtr<UDamageHandler>> HealthChanges;
+	TArray<FHealthEvent> HealthEvents;
+	TArray<FThreatEvent> ThreatEvents;
+	TArray<FBuffApplyEvent> BuffApplyEvents;
+	TArray<FBuffRemoveEvent> BuffRemoveEvents;
+	//Queues are swapped into these before dispatch, so events generated by subscribers during dispatch go out next frame instead of invalidating the span being sent.
+	TArray<UDamageHandler*> DispatchingHealthChanges;
+	TArray<FHealthEvent> DispatchingHealthEvents;
+	TArray<FThreatEvent> DispatchingThreatEvents;
+	TArray<FBuffApplyEvent> DispatchingBuffApplyEvents;
+	TArray<FBuffRemoveEvent> DispatchingBuffRemoveEvents;
+};
@@ -11,30 +11,126 @@ class UHitbox;
 
 #pragma region Structs
 
+//Fixed-size ring buffer of hitbox snapshots. Timestamps, locations, rotations, and scales are stored in separate arrays so that searching by timestamp stays contiguous.
 USTRUCT()
 struct FRewindRecord
 {
 	GENERATED_BODY()
 
-	TArray<TTuple<float, FTransform>> Transforms;
+	//Enough snapshots to cover max lag compensation at the snapshot interval, with one extra to bracket the oldest allowed rewind time.
+	static constexpr int32 Capacity = 8;
+
+	//Adds a new snapshot, overwriting the oldest one if the buffer is full. Timestamps are expected to be increasing.
+	void AddSnapshot(const float Timestamp, const FTransform& Transform);
+	int32 Num() const { return Count; }
+	//Snapshot indices are ordered from oldest (0) to newest (Num() - 1).
+	float GetTimestamp(const int32 Index) const { return Timestamps[GetSlot(Index)]; }
+	FTransform GetTransform(const int32 Index) const;
+	//Binary search for the index of the first snapshot at or after the given timestamp. Returns Num() if every snapshot is older than the timestamp.
+	int32 FindFirstSnapshotAfter(const float Timestamp) const;
+	//Records a final snapshot and stops recording. Rewinds to this time or later use the hitbox's current transform.
+	void MarkStatic(const float Timestamp, const FTransform& Transform);
+	//Drops old snapshots when a static hitbox starts being recorded again, since it may have moved while it wasn't being recorded.
+	void ClearStatic();
+	bool IsStatic() const { return bStatic; }
+	float GetStaticSince() const { return StaticSince; }
+
+private:
+
+	int32 GetSlot(const int32 Index) const { return (Head + Index) % Capacity; }
+	
+	float Timestamps[Capacity] = {};
+	FVector Locations[Capacity];
+	FQuat Rotations[Capacity];
+	FVector Scales[Capacity];
+	//Slot of the oldest snapshot.
+	int32 Head = 0;
+	int32 Count = 0;
+	bool bStatic = false;
+	float StaticSince = 0.0f;
+};
+
+//A set of hitbox shapes at a rewound point in time. Traces against the query are done mathematically, so live hitboxes never have to be moved to validate a shot.
+struct SAIYORAV4_API FHitboxRewindQuery
+{
+	void AddHitbox(UHitbox* Hitbox, const FTransform& RewoundTransform);
+	bool IsEmpty() const { return Boxes.Num() == 0; }
+	//Sweeps a sphere (or a line, if the radius is zero) against every rewound hitbox, returning hits sorted by distance along the sweep.
+	//Sphere sweeps are tested against each box inflated by the sphere radius, which is slightly generous around box edges and corners.
+	void Sweep(const FVector& Start, const FVector& End, const float Radius, const TArray<AActor*>& ActorsToIgnore, TArray<FHitResult>& OutHits) const;
+
+private:
+
+	struct FRewoundBox
+	{
+		UHitbox* Hitbox = nullptr;
+		AActor* Owner = nullptr;
+		FVector Center = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		FVector Extent = FVector::ZeroVector;
+	};
+	TArray<FRewoundBox> Boxes;
 };
 
+//A client predicted projectile waiting to be replaced by the server's projectile.
 USTRUCT()
-struct FPredictedTickProjectiles
+struct FPredictedProjectileEntry
 {
 	GENERATED_BODY()
 
-	int32 IDCounter = 0;
+	int32 TickNumber = 0;
+	int32 ID = 0;
 	UPROPERTY()
-	TMap<int32, APredictableProjectile*> Projectiles;
+	APredictableProjectile* Projectile = nullptr;
+};
+
+//Projectile ID counters and predicted projectiles for every tick of a single prediction ID.
+USTRUCT()
+struct FProjectilePredictionSlot
+{
+	GENERATED_BODY()
+
+	bool bInUse = false;
+	int32 PredictionID = 0;
+	//Last time this slot was used. Slots that haven't been used within the expiry time are reset the next time they are needed.
+	float LastUsedTime = 0.0f;
+	//Next projectile ID for each tick number of this prediction.
+	TArray<int32, TInlineAllocator<4>> TickIDCounters;
+	UPROPERTY()
+	TArray<FPredictedProjectileEntry> Projectiles;
+
+	void Reset(const int32 NewPredictionID);
 };
 
+//Fixed-size ring of prediction slots for one player, indexed by prediction ID. Prediction IDs are sequential, so a slot is only reused after Capacity newer predictions.
 USTRUCT()
 struct FPlayerProjectileInfo
 {
 	GENERATED_BODY()
 
-	TMap<FPredictedTick, FPredictedTickProjectiles> TickProjectiles;
+	static constexpr int32 Capacity = 32;
+	
+	UPROPERTY()
+	FProjectilePredictionSlot Slots[Capacity];
+
+	static int32 GetSlotIndex(const int32 PredictionID) { return ((PredictionID % Capacity) + Capacity) % Capacity; }
+};
+
+//Counters for server-side validation of predicted hits over a single frame.
+struct FShotValidationStats
+{
+	//Predicted hits that passed validation.
+	int32 ShotsValidated = 0;
+	//Predicted hits that failed validation.
+	int32 ShotsRejected = 0;
+	//Number of validations that requested rewound hitboxes.
+	int32 RewindRequests = 0;
+	//Number of distinct shooter/timestamp batches that hitboxes were actually rewound for.
+	int32 RewindBatches = 0;
+	int32 HitboxesRewound = 0;
+	float TotalRewindDepth = 0.0f;
+
+	float GetAverageRewindDepth() const { return RewindRequests > 0 ? TotalRewindDepth / RewindRequests : 0.0f; }
 };
 
 #pragma endregion 
@@ -62,16 +158,66 @@ private:
 public:
 
 	void RegisterNewHitbox(UHitbox* Hitbox);
-	FTransform RewindHitbox(UHitbox* Hitbox, const float Timestamp);
+	//Returns the interpolated transform of a hitbox at the given timestamp (clamped to max lag compensation), without moving the hitbox.
+	FTransform GetRewoundTransform(UHitbox* Hitbox, const float Timestamp) const;
+	//Adds the rewound shape of each hitbox at the given timestamp to a query that can be traced against instead of the live hitboxes.
+	void BuildRewindQuery(const TArray<UHitbox*>& Hitboxes, const float Timestamp, FHitboxRewindQuery& OutQuery) const;
+	//How much wider a search against live hitboxes has to be to find every hitbox whose rewound shape could be in the way.
+	float GetRewindSearchPadding() const { return MaxHitboxExtent + MaxRewindDisplacement; }
 
 private:
 
 	static constexpr float SnapshotInterval = 0.03f;
 	static constexpr float MaxLagCompensation = 0.2f;
+	static_assert((FRewindRecord::Capacity - 1) * SnapshotInterval >= MaxLagCompensation, "Rewind record capacity does not cover max lag compensation.");
 	TMap<UHitbox*, FRewindRecord> Snapshots;
 	UFUNCTION()
 	void CreateSnapshot();
 	FTimerHandle SnapshotHandle;
+	//Largest half-diagonal of any registered hitbox.
+	float MaxHitboxExtent = 0.0f;
+	//Largest distance any hitbox has moved from its oldest snapshot. Held for MaxLagCompensation so hitboxes that stop being recorded are still covered.
+	float MaxRewindDisplacement = 0.0f;
+	float MaxRewindDisplacementTime = 0.0f;
+
+	//Only hitboxes that can actually be shot are snapshotted. Every other hitbox is treated as static since the last time it was relevant.
+	static constexpr float RelevanceInterval = 0.25f;
+	TArray<UHitbox*> RelevantHitboxes;
+	UFUNCTION()
+	void UpdateSnapshotRelevance();
+	bool IsHitboxRelevant(const UHitbox* Hitbox, const TArray<FVector>& ViewLocations, const float MaxDistanceSquared) const;
+	FTimerHandle RelevanceHandle;
+
+#pragma endregion
+#pragma region Shot Validation
+
+public:
+
+	//Returns a rewind query containing at least the given hitboxes, rewound to the timestamp.
+	//Every validation a shooter makes in the same frame, at the same timestamp and against the same hitbox types, shares one query, so each hitbox is rewound once per batch instead of once per shot.
+	const FHitboxRewindQuery& GetBatchedRewindQuery(const ASaiyoraPlayerCharacter* Shooter, const float Timestamp, const int32 ObjectMask, const TArray<UHitbox*>& Hitboxes);
+	//Records the outcome of validating a shooter's predicted hits, for the per-frame counters.
+	void RecordShotValidation(const int32 NumPredicted, const int32 NumValidated);
+	//Validation counters for the last frame in which any shots were validated.
+	const FShotValidationStats& GetLastShotValidationStats() const { return LastFrameStats; }
+
+private:
+
+	struct FShotRewindBatch
+	{
+		const ASaiyoraPlayerCharacter* Shooter = nullptr;
+		float Timestamp = 0.0f;
+		int32 ObjectMask = 0;
+		FHitboxRewindQuery Query;
+		TSet<UHitbox*> Hitboxes;
+	};
+	//Batches are only valid for the frame they were built in, since hitboxes keep moving and new snapshots are taken.
+	TArray<FShotRewindBatch> ShotBatches;
+	uint64 ShotBatchFrame = MAX_uint64;
+	FShotValidationStats CurrentFrameStats;
+	FShotValidationStats LastFrameStats;
+	//Clears last frame's batches and rolls over the counters the first time validation happens in a new frame.
+	void UpdateShotBatchFrame();
 
 #pragma endregion
 #pragma region Projectiles
@@ -85,11 +231,28 @@ public:
 	void RegisterClientProjectile(ASaiyoraPlayerCharacter* Player, APredictableProjectile* Projectile);
 	//Called by the server's projectile after replicating to the client to destroy the predicted projectile and replace it with the server projectile.
 	void ReplaceProjectile(APredictableProjectile* AuthProjectile);
+	//Number of prediction slots currently holding projectile IDs or predicted projectiles, across all players.
+	int32 GetNumLiveProjectileSlots() const;
+	//Number of prediction slots that were reset while still holding predicted projectiles that were never replaced.
+	int32 GetNumExpiredProjectileSlots() const { return ExpiredProjectileSlots; }
 
 private:
 
+	//A prediction slot lives long enough for the server's projectile to catch up (at most MaxLagCompensation) and replicate back to the client.
+	static constexpr float ProjectileSlotExpiry = MaxLagCompensation * 5.0f;
 	UPROPERTY()
 	TMap<ASaiyoraPlayerCharacter*, FPlayerProjectileInfo> PlayerProjectiles;
+	//Finds the slot for a prediction ID, resetting it first if it belongs to an older prediction or has expired.
+	FProjectilePredictionSlot& GetPredictionSlot(ASaiyoraPlayerCharacter* Player, const int32 PredictionID);
+	//Finds the slot for a prediction ID without modifying it. Returns nullptr if the slot has been reused or expired.
+	FProjectilePredictionSlot* FindPredictionSlot(ASaiyoraPlayerCharacter* Player, const int32 PredictionID);
+	//Records a predicted projectile's tick and ID in the slot for its prediction.
+	void AddPredictedProjectile(ASaiyoraPlayerCharacter* Player, const FPredictedTick& Tick, const int32 ID, APredictableProjectile* Projectile);
+	//Removes the entry for a predicted projectile and outputs it. Returns false if the slot was reused or expired, or no projectile had this tick and ID.
+	bool TakePredictedProjectile(ASaiyoraPlayerCharacter* Player, const FPredictedTick& Tick, const int32 ID, APredictableProjectile*& OutProjectile);
+	int32 ExpiredProjectileSlots = 0;
+
+	friend class FProjectilePredictionRingSoakTest;
 
 #pragma endregion
 };
@@ -354,6 +354,42 @@ private:
 #pragma endregion
 #pragma region Modifiers
 
+//Container for a unique ID for a given combat modifier that can be used to remove or modify it later.
+USTRUCT(BlueprintType)
+struct FCombatModifierHandle
+{
+    GENERATED_BODY()
+
+    //Whether this modifier handle is valid.
+    bool IsValid() const { return ModifierID > 0; }
+
+    FCombatModifierHandle() {}
+    FCombatModifierHandle(const FCombatModifierHandle& Other) : ModifierID(Other.ModifierID) {}
+    FORCEINLINE bool operator==(const FCombatModifierHandle& Other) const { return Other.ModifierID == ModifierID; }
+
+    //Static definition of an invalid modifier handle with ID -1. Used when applying a modifier fails.
+    static FCombatModifierHandle Invalid;
+    static FCombatModifierHandle MakeHandle() { return FCombatModifierHandle(GetNextModifierID()); }
+
+private:
+
+    int32 ModifierID = -1;
+    
+    static int32 NextModifier;
+    static int32 GetNextModifierID() { NextModifier++; return NextModifier; }
+
+    FCombatModifierHandle(const int32 ID) : ModifierID(ID) {}
+
+    friend uint32 GetTypeHash(const FCombatModifierHandle& Handle);
+};
+
+FORCEINLINE uint32 GetTypeHash(const FCombatModifierHandle& Handle)
+{
+    return GetTypeHash(Handle.ModifierID);
+}
+
+struct FCombatModifierTerms;
+
 //Struct that defines a modifier to a value in the context of a combat event or persistent value (like stats or resource costs).
 USTRUCT(BlueprintType)
 struct FCombatModifier
@@ -380,6 +416,41 @@ struct FCombatModifier
     static float ApplyModifiers(const TArray<FCombatModifier>& ModArray, const float BaseValue);
     //Helper function for applying an array of modifiers to a base value, then truncating it to an int.
     static int32 ApplyModifiers(const TArray<FCombatModifier>& ModArray, const int32 BaseValue);
+    //Helper function for applying an array of modifiers on top of terms that were already folded from other modifiers.
+    static float ApplyModifiers(const TArray<FCombatModifier>& ModArray, const float BaseValue, const FCombatModifierTerms& PrecomputedTerms);
+    //Gets the number of times this modifier should be applied, based on its buff source's stacks.
+    int32 GetStackMultiplier() const;
+};
+
+//The additive and multiplicative terms that a set of modifiers folds down to.
+struct SAIYORAV4_API FCombatModifierTerms
+{
+    float Additive = 0.0f;
+    float Multiplicative = 1.0f;
+
+    void Fold(const FCombatModifier& Modifier);
+    float Apply(const float BaseValue) const { return FMath::Max(0.0f, FMath::Max(0.0f, BaseValue + Additive) * Multiplicative); }
+};
+
+//Modifiers that don't depend on event context, folded once into a single set of terms instead of being evaluated per event.
+//The terms are recompiled lazily after a modifier is added, removed, or updated. Like FModifiableFloat, stacking modifiers are updated by their source when its stacks change.
+class SAIYORAV4_API FCompiledModifierCache
+{
+public:
+
+    FCombatModifierHandle Add(const FCombatModifier& Modifier);
+    void Remove(const FCombatModifierHandle& Handle);
+    void Update(const FCombatModifierHandle& Handle, const FCombatModifier& NewModifier);
+    bool IsEmpty() const { return Modifiers.Num() == 0; }
+    const FCombatModifierTerms& GetTerms() const;
+
+private:
+
+    TMap<FCombatModifierHandle, FCombatModifier> Modifiers;
+    mutable FCombatModifierTerms Terms;
+    mutable bool bDirty = false;
+
+    void Recompile() const;
 };
 
 //Templated class used for holding a list of conditional modifier functions that each return an FCombatModifier when provided combat event context.
@@ -414,45 +485,42 @@ public:
         Modifiers.Remove(Modifier);
     }
 
-private:
-
-    TSet<T> Modifiers;
-};
+    //Adds a modifier that is the same regardless of event context. These skip per-event evaluation and are folded into GetStaticTerms instead.
+    FCombatModifierHandle AddStatic(const FCombatModifier& Modifier)
+    {
+        return StaticModifiers.Add(Modifier);
+    }
 
-//Container for a unique ID for a given combat modifier that can be used to remove or modify it later.
-USTRUCT(BlueprintType)
-struct FCombatModifierHandle
-{
-    GENERATED_BODY()
+    void RemoveStatic(const FCombatModifierHandle& Handle)
+    {
+        StaticModifiers.Remove(Handle);
+    }
 
-    //Whether this modifier handle is valid.
-    bool IsValid() const { return ModifierID > 0; }
+    //Replaces a static modifier, or refreshes it after its buff source's stacks changed.
+    void UpdateStatic(const FCombatModifierHandle& Handle, const FCombatModifier& NewModifier)
+    {
+        StaticModifiers.Update(Handle, NewModifier);
+    }
 
-    FCombatModifierHandle() {}
-    FCombatModifierHandle(const FCombatModifierHandle& Other) : ModifierID(Other.ModifierID) {}
-    FORCEINLINE bool operator==(const FCombatModifierHandle& Other) const { return Other.ModifierID == ModifierID; }
+    const FCombatModifierTerms& GetStaticTerms() const
+    {
+        return StaticModifiers.GetTerms();
+    }
 
-    //Static definition of an invalid modifier handle with ID -1. Used when applying a modifier fails.
-    static FCombatModifierHandle Invalid;
-    static FCombatModifierHandle MakeHandle() { return FCombatModifierHandle(GetNextModifierID()); }
+    //Evaluates the context-dependent modifiers, appends them to any extra modifiers the caller provided, then applies everything on top of the static terms.
+    template <typename... Args>
+    float GetModifiedValue(const float BaseValue, TArray<FCombatModifier>& ExtraModifiers, Args... Context) const
+    {
+        GetModifiers(ExtraModifiers, Context...);
+        return FCombatModifier::ApplyModifiers(ExtraModifiers, BaseValue, StaticModifiers.GetTerms());
+    }
 
 private:
 
-    int32 ModifierID = -1;
-    
-    static int32 NextModifier;
-    static int32 GetNextModifierID() { NextModifier++; return NextModifier; }
-
-    FCombatModifierHandle(const int32 ID) : ModifierID(ID) {}
-
-    friend uint32 GetTypeHash(const FCombatModifierHandle& Handle);
+    TSet<T> Modifiers;
+    FCompiledModifierCache StaticModifiers;
 };
 
-FORCEINLINE uint32 GetTypeHash(const FCombatModifierHandle& Handle)
-{
-    return GetTypeHash(Handle.ModifierID);
-}
-
 DECLARE_DELEGATE_TwoParams(FModifiableFloatCallback, const float, const float);
 DECLARE_DELEGATE_TwoParams(FModifiableIntCallback, const int32, const int32);
 
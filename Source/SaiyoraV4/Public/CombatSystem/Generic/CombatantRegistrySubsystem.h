@@ -0,0 +1,64 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "CombatEnums.h"
+#include "WorldSubsystem.h"
+#include "CombatantRegistrySubsystem.generated.h"
+
+class UHitbox;
+
+#pragma region Structs
+
+//Cached position and shape of a single hitbox, taken when the grid is rebuilt.
+struct FRegisteredHitbox
+{
+	UHitbox* Hitbox = nullptr;
+	AActor* Owner = nullptr;
+	FTransform Transform;
+	FVector Extent = FVector::ZeroVector;
+	float BoundsRadius = 0.0f;
+};
+
+//Loose grid of hitboxes that share a faction and plane. Hitboxes are placed in the cell containing their center, so queries expand by the largest hitbox in the bucket.
+struct FCombatantBucket
+{
+	TArray<FRegisteredHitbox> Hitboxes;
+	TMap<FIntPoint, TArray<int32>> Cells;
+	float MaxBoundsRadius = 0.0f;
+
+	void Reset();
+};
+
+#pragma endregion 
+
+//Registry of every combatant hitbox in the world, used to answer radius queries without a physics overlap.
+//Hitboxes are bucketed by their owner's faction and plane, and positions are refreshed at most once per frame, on the first query of that frame.
+UCLASS()
+class SAIYORAV4_API UCombatantRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	void RegisterHitbox(UHitbox* Hitbox);
+	void UnregisterHitbox(UHitbox* Hitbox);
+	//Finds every combatant with a hitbox overlapping the sphere whose faction and plane pass the given filters. Does not check line of sight.
+	void GetCombatantsInRadius(TArray<AActor*>& OutActors, const FVector& Origin, const float Radius, const EFaction QueryFaction,
+		const ESaiyoraFactionFilter FactionFilter, const ESaiyoraPlane QueryPlane, const ESaiyoraPlaneFilter PlaneFilter);
+
+private:
+
+	static constexpr float CellSize = 1000.0f;
+	static constexpr int32 NumFactions = 3;
+	static constexpr int32 NumPlanes = 4;
+	static int32 GetBucketIndex(const EFaction Faction, const ESaiyoraPlane Plane) { return static_cast<int32>(Faction) * NumPlanes + static_cast<int32>(Plane); }
+	static FIntPoint GetCell(const FVector& Location);
+	//Squared distance from a point to the hitbox's box, in world space.
+	static float GetSquaredDistanceToHitbox(const FRegisteredHitbox& Entry, const FVector& Location);
+
+	UPROPERTY()
+	TArray<UHitbox*> Hitboxes;
+	FCombatantBucket Buckets[NumFactions * NumPlanes];
+	uint64 LastRebuildFrame = MAX_uint64;
+	//Rebuilds every bucket from the current hitbox transforms and owner factions/planes, if this hasn't happened yet this frame.
+	void UpdateGrid();
+};
@@ -0,0 +1,86 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "CombatEnums.h"
+#include "WorldSubsystem.h"
+#include "LineOfSightSubsystem.generated.h"
+
+#pragma region Structs
+
+struct FLineOfSightRequest
+{
+	FVector From = FVector::ZeroVector;
+	FVector To = FVector::ZeroVector;
+	ESaiyoraPlane Plane = ESaiyoraPlane::Both;
+
+	FLineOfSightRequest() {}
+	FLineOfSightRequest(const FVector& InFrom, const FVector& InTo, const ESaiyoraPlane InPlane) : From(InFrom), To(InTo), Plane(InPlane) {}
+};
+
+//Endpoints are quantized so that checks between combatants that have barely moved share a result. Endpoints are sorted, since line of sight goes both ways.
+struct FLineOfSightKey
+{
+	FIntVector A = FIntVector::ZeroValue;
+	FIntVector B = FIntVector::ZeroValue;
+	ESaiyoraPlane Plane = ESaiyoraPlane::Both;
+
+	FLineOfSightKey() {}
+	FLineOfSightKey(const FVector& From, const FVector& To, const ESaiyoraPlane InPlane, const float Quantization);
+
+	bool operator==(const FLineOfSightKey& Other) const { return A == Other.A && B == Other.B && Plane == Other.Plane; }
+	friend uint32 GetTypeHash(const FLineOfSightKey& Key) { return HashCombine(HashCombine(GetTypeHash(Key.A), GetTypeHash(Key.B)), GetTypeHash(Key.Plane)); }
+};
+
+struct FLineOfSightCacheEntry
+{
+	bool bVisible = false;
+	float Timestamp = 0.0f;
+};
+
+#pragma endregion 
+
+//Plane-aware line of sight checks against level geometry, keyed by quantized endpoints and plane.
+//Cosmetic consumers use GetOrRequestLineOfSight: results are cached briefly, and misses are queued and dispatched together as async traces when this subsystem ticks.
+//Authoritative consumers use CheckLineOfSight or CheckLineOfSightBatch: misses are traced immediately, and results are only shared within the frame they were traced in.
+UCLASS()
+class SAIYORAV4_API ULineOfSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Tick(float DeltaTime) override;
+
+	//Returns true and fills out the result if this check is cached. Otherwise, queues an async check so that the result can be read next frame.
+	bool GetOrRequestLineOfSight(const FVector& From, const FVector& To, const ESaiyoraPlane Plane, bool& bOutVisible);
+	//Authoritative check. Identical checks (after quantization) in the same frame share one trace.
+	bool CheckLineOfSight(const FVector& From, const FVector& To, const ESaiyoraPlane Plane);
+	//Authoritative checks for a whole set of requests. Each unique check is traced at most once per frame. OutVisible is parallel to Requests.
+	void CheckLineOfSightBatch(const TArray<FLineOfSightRequest>& Requests, TArray<bool>& OutVisible);
+
+	static FName GetLineOfSightTraceProfile(const ESaiyoraPlane Plane);
+
+private:
+
+	static constexpr float CacheLifetime = 0.2f;
+	static constexpr float EndpointQuantization = 25.0f;
+
+	TMap<FLineOfSightKey, FLineOfSightCacheEntry> Cache;
+	bool FindCachedResult(const FLineOfSightKey& Key, bool& bOutVisible) const;
+	void CacheResult(const FLineOfSightKey& Key, const bool bVisible);
+
+	//Finer than the cosmetic quantization, since authoritative results decide hits.
+	static constexpr float AuthoritativeQuantization = 5.0f;
+	TMap<FLineOfSightKey, bool> FrameResults;
+	uint64 FrameResultsFrame = MAX_uint64;
+	bool TraceLineOfSight(const FLineOfSightRequest& Request) const;
+
+	TMap<FLineOfSightKey, FLineOfSightRequest> QueuedTraces;
+	TSet<FLineOfSightKey> InFlightTraces;
+	FTraceDelegate TraceDelegate;
+	//Async traces carry an ID in their user data that maps back to the key they were traced for.
+	TMap<uint32, FLineOfSightKey> TraceKeys;
+	uint32 NextTraceID = 0;
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Data);
+};
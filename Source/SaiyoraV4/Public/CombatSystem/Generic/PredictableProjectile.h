@@ -24,6 +24,9 @@ struct FProjectileSource
 	int32 ID = 0;
 	UPROPERTY(NotReplicated)
 	UCombatAbility* SourceAbility = nullptr;
+	//The actor that fired the projectile. Unlike Owner, this is also set when the shooter isn't a player, such as an NPC.
+	UPROPERTY(NotReplicated)
+	AActor* Shooter = nullptr;
 };
 
 UCLASS(Abstract, Blueprintable)
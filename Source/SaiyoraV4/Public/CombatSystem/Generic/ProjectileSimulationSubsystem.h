@@ -0,0 +1,153 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "CombatEnums.h"
+#include "PredictableProjectile.h"
+#include "WorldSubsystem.h"
+#include "ProjectileSimulationSubsystem.generated.h"
+
+class UAbilityComponent;
+class UCombatDebugOptions;
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FSimulatedProjectileCallback, const FHitResult&, Hit, const int32, ProjectileID);
+
+#pragma region Structs
+
+//Movement and collision settings for a projectile that is simulated as data instead of as its own actor.
+USTRUCT(BlueprintType)
+struct FSimulatedProjectileParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float Speed = 3000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float GravityScale = 0.0f;
+	//Radius of the sweep against hitboxes.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float HitboxRadius = 10.0f;
+	//Radius of the sweep against level geometry.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float CollisionRadius = 5.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float Lifetime = 5.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ESaiyoraPlane Plane = ESaiyoraPlane::Both;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EFaction Hostility = EFaction::Enemy;
+	//Optional actor spawned locally to display the projectile. It is never replicated and has its collision disabled.
+	//Replicated volleys send this as an index into the source ability's projectile visuals instead.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, NotReplicated)
+	TSubclassOf<AActor> VisualClass;
+};
+
+//Everything a client needs to simulate a volley of projectiles locally, sent in a single RPC instead of replicating an actor per projectile.
+//Pellet directions aren't sent, they are generated from a seed derived from the source tick and first ID.
+USTRUCT()
+struct FProjectileVolley
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FPredictedTick SourceTick;
+	UPROPERTY()
+	TSubclassOf<UCombatAbility> SourceClass;
+	//ID of the first projectile in the volley. The rest of the projectiles have consecutive IDs.
+	UPROPERTY()
+	int32 FirstID = 0;
+	UPROPERTY()
+	uint8 Count = 0;
+	UPROPERTY()
+	FVector_NetQuantize10 Origin;
+	UPROPERTY()
+	FVector_NetQuantizeNormal AimDirection;
+	UPROPERTY()
+	float SpreadAngle = 0.0f;
+	//Server time the volley was fired at, used by clients to catch up to the server's projectiles.
+	UPROPERTY()
+	float FireTime = 0.0f;
+	UPROPERTY()
+	FSimulatedProjectileParams Params;
+	//Index of the visual class in the source ability's projectile visuals, or INDEX_NONE for no visual.
+	UPROPERTY()
+	int8 VisualIndex = INDEX_NONE;
+};
+
+//Every projectile in flight, stored as parallel arrays so the simulation pass walks contiguous memory.
+//All arrays are always the same length, and are only modified through Add and RemoveAtSwap.
+USTRUCT()
+struct FSimulatedProjectileArray
+{
+	GENERATED_BODY()
+
+	int32 Num() const { return Locations.Num(); }
+	int32 Add(const FProjectileSource& Source, const FVector& Location, const FVector& Velocity, const float Gravity, const float CatchUpTime,
+		const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit, AActor* Visual, const bool bReplicateHits);
+	void RemoveAtSwap(const int32 Index);
+
+	TArray<FVector> Locations;
+	TArray<FVector> Velocities;
+	TArray<float> GravityZ;
+	TArray<float> RemainingLifetimes;
+	//Time the server still needs to simulate to catch up to where the predicting client's copy is. Simulated at double speed, like actor projectiles.
+	TArray<float> RemainingLag;
+	TArray<float> HitboxRadii;
+	TArray<float> CollisionRadii;
+	TArray<FName> HitboxProfiles;
+	TArray<FName> CollisionProfiles;
+	//Whether the server tells clients when this projectile hits something. Used by volleys, which clients simulate locally.
+	TArray<bool> ReplicatesHits;
+	UPROPERTY()
+	TArray<FProjectileSource> Sources;
+	TArray<FSimulatedProjectileCallback> Callbacks;
+	UPROPERTY()
+	TArray<AActor*> Visuals;
+};
+
+#pragma endregion
+
+//Subsystem that simulates non-homing projectiles as plain data, advancing all of them in a single pass each frame instead of ticking a replicated actor per projectile.
+//Projectile IDs come from the combat net subsystem, so the predicting client's copy and the server's copy of a projectile share the same source tick and ID.
+UCLASS()
+class SAIYORAV4_API UProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual TStatId GetStatId() const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual void Deinitialize() override;
+
+	//Starts simulating a projectile. The hit callback is executed once, when the projectile hits a hitbox or level geometry, after which it is removed.
+	//On the server, CatchUpTime is simulated at double speed to catch up with the predicting client's copy.
+	void SpawnProjectile(const FProjectileSource& Source, const FVector& Location, const FVector& Direction, const float CatchUpTime,
+		const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit, const bool bReplicateHits = false);
+	//Spawns every projectile in a volley, with IDs counting up from the source's ID. Server volleys replicate their hits, so clients can remove their local copies.
+	void SpawnVolley(const FProjectileSource& Source, const FVector& Location, const FVector& AimDirection, const int32 Count, const float SpreadAngle,
+		const float CatchUpTime, const FSimulatedProjectileParams& Params, const FSimulatedProjectileCallback& OnHit);
+	//Called on clients when a volley is replicated from the server, to simulate it locally for display.
+	void SimulateReplicatedVolley(AActor* Shooter, const FProjectileVolley& Volley);
+	//Generates the pellet directions of a volley. This only depends on its inputs, so every machine generates the same directions for the same volley.
+	static void GetVolleyDirections(const FVector& AimDirection, const int32 Count, const float SpreadAngle, const int32 Seed, TArray<FVector>& OutDirections);
+	static int32 GetVolleySeed(const FPredictedTick& SourceTick, const int32 FirstID) { return static_cast<int32>(HashCombine(GetTypeHash(SourceTick), GetTypeHash(FirstID))); }
+	//Removes a projectile without executing its hit callback. Returns false if no projectile with this source was found.
+	bool DestroyProjectile(const AActor* Shooter, const FPredictedTick& SourceTick, const int32 ID);
+	int32 GetNumProjectiles() const { return Projectiles.Num(); }
+	//Reserves Count consecutive IDs for projectiles fired by the server without prediction, such as by NPCs. Returns the first ID.
+	//These projectiles are matched by shooter, source tick, and ID, so a single counter keeps them unique without per-shooter bookkeeping.
+	int32 GetNewAuthorityProjectileID(const int32 Count);
+
+private:
+
+	static constexpr float MaxCatchUpTime = 0.2f;
+	int32 NextAuthorityProjectileID = 0;
+	
+	UPROPERTY()
+	FSimulatedProjectileArray Projectiles;
+	void RemoveProjectile(const int32 Index);
+	//Removes predicted projectiles spawned by a prediction the server rejected.
+	UFUNCTION()
+	void OnAbilityMispredicted(const int32 PredictionID);
+	//Ability components whose misprediction delegate this subsystem is bound to, so it can unbind when the world is torn down.
+	TArray<TWeakObjectPtr<UAbilityComponent>> MispredictionSources;
+};
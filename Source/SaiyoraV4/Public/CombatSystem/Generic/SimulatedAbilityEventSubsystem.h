@@ -0,0 +1,37 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "AbilityStructs.h"
+#include "WorldSubsystem.h"
+#include "SimulatedAbilityEventSubsystem.generated.h"
+
+class UAbilityComponent;
+
+//Server-side relay for cosmetic ability events (ticks, no-tick cast starts, cancels, and interrupts).
+//Ability components still run these events locally right away, but instead of multicasting each one, they queue them here.
+//Once per frame, each remote player gets a single RPC with the events from actors that are open on their connection and within cosmetic range.
+//The owning client of an ability component always receives that component's events.
+UCLASS()
+class SAIYORAV4_API USimulatedAbilityEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual TStatId GetStatId() const override;
+	virtual void Tick(float DeltaTime) override;
+
+	//Whether ability components should queue their simulated events here instead of multicasting them. Always false on clients.
+	bool IsRelayEnabled() const;
+
+	void QueueNoTickCastStart(UAbilityComponent* Source, UCombatAbility* Ability) { PendingEvents.FindOrAdd(Source).NoTickCastStarts.Add(Ability); }
+	void QueueAbilityTick(UAbilityComponent* Source, const FAbilityEvent& Event) { PendingEvents.FindOrAdd(Source).Ticks.Add(Event); }
+	void QueueAbilityCancel(UAbilityComponent* Source, const FCancelEvent& Event) { PendingEvents.FindOrAdd(Source).Cancels.Add(Event); }
+	void QueueAbilityInterrupt(UAbilityComponent* Source, const FInterruptEvent& Event) { PendingEvents.FindOrAdd(Source).Interrupts.Add(Event); }
+
+private:
+
+	UPROPERTY()
+	TMap<UAbilityComponent*, FSimulatedAbilityEvents> PendingEvents;
+	//Reused for each connection's batch during flushing.
+	FSimulatedAbilityEvents ConnectionEvents;
+};
@@ -26,6 +26,12 @@ public:
 	
 	void Init(AActor* NPC);
 	virtual bool IsMet() const { return bIsMet; }
+	//Returns the result of the last evaluation, only calling IsMet again if something this requirement depends on has changed.
+	bool IsMetCached();
+	//Marks this requirement for re-evaluation if it depends on the given source.
+	void Invalidate(const ENPCRequirementInvalidation Source);
+	//What can change the result of IsMet. Defaults to re-evaluating every check.
+	virtual ENPCRequirementInvalidation GetInvalidationSources() const { return ENPCRequirementInvalidation::Always; }
 	
 	virtual ~FNPCChoiceRequirement() {}
 
@@ -37,11 +43,18 @@ protected:
 
 	FString DEBUG_RequirementName = "";
 
+	//For requirements that depend on time or position, checks whether the cached result may be stale without running the full evaluation.
+	virtual bool NeedsReevaluation() const { return false; }
+	//Called after each evaluation, so requirements can snapshot whatever NeedsReevaluation compares against.
+	virtual void OnEvaluated(const bool bMet) {}
+
 private:
 
 	virtual void SetupRequirement() {}
 	
 	bool bIsMet = false;
+	bool bCachedMet = false;
+	bool bDirty = true;
 	UPROPERTY()
 	AActor* OwningNPC = nullptr;
 };
@@ -56,9 +69,17 @@ struct FNPCCR_TimeInCombat : public FNPCChoiceRequirement
 
 	virtual bool IsMet() const override;
 	virtual void SetupRequirement() override;
+	virtual ENPCRequirementInvalidation GetInvalidationSources() const override { return ENPCRequirementInvalidation::CombatTime; }
+
+protected:
+
+	virtual bool NeedsReevaluation() const override;
+	virtual void OnEvaluated(const bool bMet) override;
 
 private:
 
+	//Combat time at which the result will next flip, or -1 if it won't change again this combat.
+	float ReevaluateAtCombatTime = -1.0f;
 	//How much time must have passed for this requirement to be met (or cease to be met).
 	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
 	float TimeRequirement = 1.0f;
@@ -79,9 +100,22 @@ struct FNPCCR_RangeOfTarget : public FNPCChoiceRequirement
 	GENERATED_BODY()
 
 	virtual bool IsMet() const override;
+	virtual ENPCRequirementInvalidation GetInvalidationSources() const override;
+
+protected:
+
+	virtual bool NeedsReevaluation() const override;
+	virtual void OnEvaluated(const bool bMet) override;
 
 private:
 
+	//Snapshot from the last evaluation. The distance to the target can't change by more than the sum of how far both actors moved,
+	//so the result can't flip until that sum reaches the distance between the target and the range threshold.
+	TWeakObjectPtr<AActor> LastTarget;
+	FVector LastOwnerLocation = FVector::ZeroVector;
+	FVector LastTargetLocation = FVector::ZeroVector;
+	float DistanceToThreshold = 0.0f;
+
 	//Context for what target we want to be in range of.
 	UPROPERTY(EditAnywhere, meta = (BaseStruct = "/Script/SaiyoraV4.NPCTargetContext", ExcludeBaseStruct))
 	FInstancedStruct TargetContext;
@@ -94,6 +128,9 @@ private:
 	//Whether to check 3D distance or 2D distance.
 	UPROPERTY(EditAnywhere)
 	bool bIncludeZDistance = true;
+	//Whether the target also has to be in line of sight of the NPC, in the NPC's plane.
+	UPROPERTY(EditAnywhere)
+	bool bRequireLineOfSight = false;
 };
 
 #pragma endregion
@@ -131,6 +168,7 @@ struct FNPCCR_Buff : public FNPCChoiceRequirement
 	GENERATED_BODY();
 
 	virtual bool IsMet() const override;
+	virtual ENPCRequirementInvalidation GetInvalidationSources() const override { return ENPCRequirementInvalidation::Buffs; }
 
 private:
 
@@ -20,7 +20,7 @@ protected:
 	//Override post-init because we need to setup our NPCSubsystem ref to be able to request and return ability tokens.
 	virtual void PostInitializeAbility_Implementation() override;
 	//Override castable update because we may need to require an ability token to be available to be castable.
-	virtual void AdditionalCastableUpdate(TArray<ECastFailReason>& AdditionalFailReasons) override;
+	virtual void AdditionalCastableUpdate() override;
 
 private:
 
@@ -62,8 +62,11 @@ private:
 	//Delegate for updating castable status when token availability changes.
 	FAbilityTokenCallback TokenCallback;
 	//Called when token availability for this class changes, to update castable status.
+	//Availability is re-derived per instance, since an instance holding a reservation can still cast when no tokens are left for anyone else.
 	UFUNCTION()
-	void OnTokenAvailabilityChanged(const bool bAvailable) { UpdateCastable(); }
+	void OnTokenAvailabilityChanged(const bool bAvailable);
+
+	friend class FNPCAbilityTokenReservationTest;
 
 #pragma endregion
 #pragma region Range
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "AbilityComponent.h"
 #include "AIController.h"
+#include "BuffStructs.h"
 #include "DungeonGameState.h"
 #include "NPCStructs.h"
 #include "EnvironmentQuery/EnvQueryManager.h"
@@ -28,11 +29,14 @@ public:
 	FCombatBehaviorNotification OnCombatBehaviorChanged;
 	UFUNCTION(BlueprintPure)
 	ENPCCombatBehavior GetCombatBehavior() const { return CombatBehavior; }
+	//Called by the NPC subsystem when a scheduled choice selection or query comes up.
+	void RunScheduledDecision(const ENPCDecisionType DecisionType);
 
 protected:
 
 	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
@@ -133,7 +137,6 @@ private:
 	TArray<FInstancedStruct> CurrentQueryParams;
 	int32 QueryID = INDEX_NONE;
 	ENPCCombatBehavior LastQueryBehavior = ENPCCombatBehavior::None;
-	FTimerHandle QueryRetryHandle;
 	//Base time between queries. This is used with some random variation to desync queries for multiple AI.
 	static constexpr float BaseQueryRetryDelay = 0.2f;
 	//Random seed used to determine variance between queries.
@@ -172,7 +175,14 @@ private:
 	void EndChoiceOnCastStateChanged(const FCastingState& Previous, const FCastingState& New);
 	
 	bool bInitializedChoices = false;
-	FTimerHandle ChoiceRetryHandle;
+	//Forwards events that can change choice requirements, so choices only re-evaluate what changed.
+	void InvalidateChoiceRequirements(const ENPCRequirementInvalidation Source);
+	UFUNCTION()
+	void OnBuffApplied(const FBuffApplyEvent& BuffEvent) { InvalidateChoiceRequirements(ENPCRequirementInvalidation::Buffs); }
+	UFUNCTION()
+	void OnBuffRemoved(const FBuffRemoveEvent& RemoveEvent) { InvalidateChoiceRequirements(ENPCRequirementInvalidation::Buffs); }
+	UFUNCTION()
+	void OnThreatTargetChanged(AActor* PreviousTarget, AActor* NewTarget) { InvalidateChoiceRequirements(ENPCRequirementInvalidation::TargetChange); }
 	static constexpr float ChoiceRetryDelay = 0.5f;
 
 	bool bWaitingOnMovementStop = false;
@@ -27,4 +27,28 @@ enum class ENPCAbilityTokenState : uint8
 	Reserved,
 	InUse,
 	Cooldown
-};
\ No newline at end of file
+};
+
+UENUM()
+enum class ENPCDecisionType : uint8
+{
+	SelectChoice,
+	RunQuery
+};
+
+//What can change whether an NPC choice requirement is met. Requirements only re-evaluate after one of their sources changes.
+enum class ENPCRequirementInvalidation : uint8
+{
+	None = 0,
+	//Re-evaluated every time it is checked.
+	Always = 1 << 0,
+	//Crossing a combat time threshold, or entering/leaving combat.
+	CombatTime = 1 << 1,
+	//Buffs being applied to or removed from the NPC.
+	Buffs = 1 << 2,
+	//The NPC's threat target changing.
+	TargetChange = 1 << 3,
+	//The NPC or its target moving far enough to cross a range threshold.
+	Movement = 1 << 4
+};
+ENUM_CLASS_FLAGS(ENPCRequirementInvalidation)
\ No newline at end of file
@@ -23,7 +23,9 @@ public:
 	void Init(UNPCAbilityComponent* AbilityComponent);
 	
 	TSubclassOf<UNPCAbility> GetAbilityClass() const { return AbilityClass; }
-	bool IsChoiceValid() const;
+	bool IsChoiceValid();
+	//Marks any requirements that depend on the given source as needing re-evaluation.
+	void InvalidateRequirements(const ENPCRequirementInvalidation Source);
 
 	FString DEBUG_GetDisplayName() const { return DEBUG_ChoiceName; }
 
@@ -38,6 +40,13 @@ private:
 	UNPCAbilityComponent* OwningComponentRef = nullptr;
 	bool bInitialized = false;
 
+	bool AreRequirementsMet();
+	//Cached result of the last requirement evaluation, reused until an event marks a requirement dirty.
+	bool bRequirementsMet = false;
+	bool bRequirementsDirty = true;
+	//Whether any requirement depends on time or position, and has to be checked every time instead of waiting for an event.
+	bool bHasPolledRequirements = false;
+
 	UPROPERTY(EditAnywhere)
 	FString DEBUG_ChoiceName = "";
 };
@@ -5,8 +5,24 @@
 #include "NPCSubsystem.generated.h"
 
 class UNPCAbility;
+class UNPCAbilityComponent;
 class UCombatDebugOptions;
 
+//A pending choice selection or query for a single NPC, waiting in the subsystem's decision queue.
+struct FNPCScheduledDecision
+{
+	TWeakObjectPtr<UNPCAbilityComponent> Component;
+	ENPCDecisionType DecisionType = ENPCDecisionType::SelectChoice;
+	double ReadyTime = 0.0f;
+	//Order the decision was scheduled in, used to break ties between decisions ready at the same time.
+	uint64 Sequence = 0;
+
+	FORCEINLINE bool operator<(const FNPCScheduledDecision& Other) const
+	{
+		return ReadyTime < Other.ReadyTime || (ReadyTime == Other.ReadyTime && Sequence < Other.Sequence);
+	}
+};
+
 //World subsystem that acts as a centralized place to handle NPC behaviors like spreading out or distributing ability tokens.
 UCLASS()
 class SAIYORAV4_API UNPCSubsystem : public UTickableWorldSubsystem
@@ -41,6 +57,30 @@ private:
 
 	UPROPERTY()
 	TMap<AActor*, FVector> ClaimedLocations;
+	//Claimed locations bucketed into a 2D grid with cells the size of the penalty radius, so scoring a location only checks the neighboring cells.
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AActor>>> ClaimedLocationGrid;
+	static constexpr float ClaimedLocationRadius = 200.0f;
+	static FIntPoint GetClaimedLocationCell(const FVector& Location);
+	void RemoveFromClaimedLocationGrid(AActor* Actor, const FVector& Location);
+
+#pragma endregion
+#pragma region Decision Scheduling
+
+public:
+
+	//Queues a choice selection or query for an NPC to run after a delay, replacing any pending decision of the same type for that NPC.
+	//Due decisions are run oldest first within a per-frame time budget, so many NPCs entering combat on the same frame get spread out over multiple frames.
+	void ScheduleDecision(UNPCAbilityComponent* Component, const ENPCDecisionType DecisionType, const float Delay);
+	void CancelDecision(const UNPCAbilityComponent* Component, const ENPCDecisionType DecisionType);
+
+private:
+
+	//Min-heap of pending decisions ordered on ready time, then schedule order.
+	TArray<FNPCScheduledDecision> DecisionQueue;
+	//Sequence of the currently valid decision for each NPC and type. Queue entries that don't match were cancelled or replaced, and are skipped.
+	TMap<TPair<const UNPCAbilityComponent*, ENPCDecisionType>, uint64> ActiveDecisions;
+	uint64 NextDecisionSequence = 0;
+	void RunScheduledDecisions();
 
 #pragma endregion
 #pragma region Ability Tokens
@@ -10,6 +10,8 @@ struct FNPCTargetContext
 	GENERATED_BODY()
 
 	virtual AActor* GetBestTarget(const AActor* Querier) const { return nullptr; }
+	//Whether the best target can only change when the NPC's threat target changes, allowing requirements using this context to cache their results.
+	virtual bool ChangesOnlyWithThreatTarget() const { return false; }
 	virtual ~FNPCTargetContext() {}
 };
 
@@ -20,6 +22,7 @@ struct FNPCTC_HighestThreat : public FNPCTargetContext
 	GENERATED_BODY()
 	
 	virtual AActor* GetBestTarget(const AActor* Querier) const override;
+	virtual bool ChangesOnlyWithThreatTarget() const override { return true; }
 };
 
 //A context that returns the closest threat target the NPC is in combat with.
@@ -82,6 +82,15 @@ public:
 	//Delegate fired when the resource's value or max value changes.
 	UPROPERTY(BlueprintAssignable)
 	FResourceValueNotification OnResourceChanged;
+	//Get the amount per second this resource regenerates. Negative values decay the resource.
+	UFUNCTION(BlueprintPure, Category = "Resource")
+	float GetRegenRate() const { return ResourceState.RegenRate; }
+	//Set the amount per second this resource regenerates. Only the rate and the time it changed are replicated, and every machine evaluates the value from them locally.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Resource")
+	void SetRegenRate(const float NewRate);
+	//Called by the resource handler every frame while this resource is regenerating, to notify listeners of the evaluated value.
+	//Returns false once the value has reached the bound it is moving towards and won't change until the state does.
+	bool TickRegeneration();
 
 	//Add a modifier to non-ability cost resource gains and losses.
 	UFUNCTION(BlueprintCallable, Category = "Resource")
@@ -89,6 +98,10 @@ public:
 	//Remove a modifier from non-ability cost resource gains and losses.
 	UFUNCTION(BlueprintCallable, Category = "Resource")
 	void RemoveResourceDeltaModifier(const FResourceDeltaModifier& Modifier) { ResourceDeltaMods.Remove(Modifier); }
+	//Modifiers that don't depend on the source or delta are folded into cached terms rather than being evaluated for every change.
+	FCombatModifierHandle AddStaticResourceDeltaModifier(const FCombatModifier& Modifier) { return ResourceDeltaMods.AddStatic(Modifier); }
+	void RemoveStaticResourceDeltaModifier(const FCombatModifierHandle& Handle) { ResourceDeltaMods.RemoveStatic(Handle); }
+	void UpdateStaticResourceDeltaModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { ResourceDeltaMods.UpdateStatic(Handle, Modifier); }
 
 protected:
 
@@ -112,14 +125,33 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Resource")
 	EResourceAdjustmentBehavior ResourceAdjustmentBehavior = EResourceAdjustmentBehavior::PercentOfMax;
 
+	//If no regen stat is bound, this is the initial amount per second the resource regenerates.
+	UPROPERTY(EditDefaultsOnly, Category = "Resource")
+	float DefaultRegenRate = 0.0f;
+	//Setting this allows the resource's regen rate to be bound to a stat's value, if the owning actor has that stat.
+	UPROPERTY(EditDefaultsOnly, Category = "Resource", meta = (Categories = "Stat"))
+	FGameplayTag RegenRateBindStat;
+
 	UPROPERTY(ReplicatedUsing = OnRep_ResourceState)
 	FResourceState ResourceState;
 	UFUNCTION()
-	void OnRep_ResourceState(const FResourceState& PreviousState);
+	void OnRep_ResourceState();
 	FStatCallback MaxStatBind;
 	UFUNCTION()
 	void UpdateMaximumFromStatBind(const FGameplayTag StatTag, const float NewValue);
+	FStatCallback RegenStatBind;
+	UFUNCTION()
+	void UpdateRegenRateFromStatBind(const FGameplayTag StatTag, const float NewValue);
 	void SetResourceValue(const float NewValue, UObject* Source, const int32 PredictionID = 0);
+
+	float GetServerWorldTime() const;
+	//Folds regeneration since the last change into the current value, so the state can be changed from the current time.
+	void RebaseRegeneration();
+	void UpdateRegenerationTicking();
+	//The last state reported through OnResourceChanged, with regeneration and any client predictions applied.
+	FResourceState LocalState;
+	//Broadcasts OnResourceChanged if the locally evaluated value or max value differs from what was last reported.
+	void NotifyLocalValueChanged(UObject* ChangeSource);
 	
 	TConditionalModifierList<FResourceDeltaModifier> ResourceDeltaMods;
 
@@ -136,13 +168,9 @@ public:
 	
 private:
 
-	//The local value of the resource after any client cost predictions are applied.
-	float PredictedResourceValue = 0.0f;
-	TMap<int32, float> ResourcePredictions;
-	void RecalculatePredictedResource(UObject* ChangeSource);
-	//When resource is state is replicated, it contains the latest prediction ID that updated that resource.
-	//This allows us to remove old predictions that the server has already taken into account.
-	void PurgeOldPredictions();
+	//Cost predictions the server hasn't accounted for yet. The running total is subtracted from the replicated value.
+	//When resource state is replicated, it contains the latest prediction ID that updated that resource, and older predictions are purged.
+	FResourcePredictionRing ResourcePredictions;
 
 #pragma endregion 
 };
\ No newline at end of file
@@ -15,16 +15,23 @@ public:
 
 	virtual void SetupBuffFunction() override;
 	virtual void OnApply(const FBuffApplyEvent& ApplyEvent) override;
+	virtual void OnChange(const FBuffApplyEvent& ApplyEvent) override;
 	virtual void OnRemove(const FBuffRemoveEvent& RemoveEvent) override;
 
 private:
 
 	UPROPERTY(EditAnywhere, Category = "Resource Modifier")
 	TSubclassOf<UResource> ResourceClass;
-	UPROPERTY(EditAnywhere, Category = "Resource Modifier", meta = (GetOptions = "GetResourceDeltaModifierFunctionNames"))
+	//Modifiers that don't depend on the source or delta can skip the modifier function and be folded into the resource's cached modifier terms.
+	UPROPERTY(EditAnywhere, Category = "Resource Modifier")
+	bool bIgnoresDeltaContext = false;
+	UPROPERTY(EditAnywhere, Category = "Resource Modifier", meta = (EditCondition = "bIgnoresDeltaContext"))
+	FCombatModifier StaticModifier;
+	UPROPERTY(EditAnywhere, Category = "Resource Modifier", meta = (GetOptions = "GetResourceDeltaModifierFunctionNames", EditCondition = "!bIgnoresDeltaContext"))
 	FName ModifierFunctionName;
 	
 	FResourceDeltaModifier Modifier;
+	FCombatModifierHandle StaticModifierHandle;
 	UPROPERTY()
 	UResource* TargetResource = nullptr;
 
@@ -21,6 +21,7 @@ public:
 	UResourceHandler();
 	virtual void BeginPlay() override;
 	virtual void InitializeComponent() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void GetLifetimeReplicatedProps(::TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 #pragma endregion 
@@ -43,6 +44,8 @@ public:
 
 	void NotifyOfReplicatedResource(UResource* Resource);
 	void NotifyOfRemovedReplicatedResource(UResource* Resource);
+	//Resources call this when they start regenerating, so the handler ticks them until they stop changing.
+	void NotifyOfRegeneratingResource();
 	
 private:
 
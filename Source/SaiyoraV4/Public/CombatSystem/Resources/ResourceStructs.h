@@ -35,9 +35,42 @@ struct FResourceState
 	//Last prediction ID the server received that updated this resource.
 	UPROPERTY()
 	int32 PredictionID = 0;
+	//Amount per second the resource regenerates (or decays, if negative) from CurrentValue.
+	UPROPERTY(BlueprintReadOnly, Category = "Resource")
+	float RegenRate = 0.0f;
+	//Server world time that CurrentValue was set at. Regeneration is evaluated from this point.
+	UPROPERTY()
+	float RegenStartTime = 0.0f;
 
 	FResourceState() {}
 	FResourceState(const float Max, const float Value) : Maximum(Max), CurrentValue(Value) {}
+
+	float GetValueAtTime(const float ServerTime) const { return RegenRate == 0.0f ? CurrentValue : FMath::Clamp(CurrentValue + RegenRate * FMath::Max(0.0f, ServerTime - RegenStartTime), 0.0f, Maximum); }
+};
+
+//Ordered ring of a client's unacked cost predictions for one resource.
+//Keeps a running total so the predicted value doesn't need to re-sum every outstanding prediction when one changes.
+struct FResourcePredictionRing
+{
+	static constexpr int32 Capacity = 32;
+
+	//Adds a prediction in ID order, or overwrites the cost of an existing prediction with the server's verified cost.
+	void Add(const int32 PredictionID, const float Cost);
+	//Removes every prediction up to and including the last prediction ID the server has accounted for.
+	void Purge(const int32 AckedPredictionID);
+	float GetTotalCost() const { return TotalCost; }
+	int32 Num() const { return Count; }
+
+private:
+
+	int32 PredictionIDs[Capacity] = {};
+	float Costs[Capacity] = {};
+	int32 Head = 0;
+	int32 Count = 0;
+	float TotalCost = 0.0f;
+
+	int32 GetSlot(const int32 Index) const { return (Head + Index) % Capacity; }
+	void RemoveOldest();
 };
 
 USTRUCT(BlueprintType)
@@ -62,6 +62,8 @@ private:
 	//The runtime version of stats, using the CombatStats default values and replicating the modified values to clients.
 	UPROPERTY(Replicated)
 	FCombatStatArray Stats;
+	//Lookup into the editor-exposed CombatStats, used before replicated stats arrive on clients.
+	FStatLookupTable DefaultStatLookup;
 
 #pragma endregion 
 };
@@ -55,6 +55,18 @@ struct FCombatStat : public FModifiableFloat
     }
 };
 
+//Dense lookup from a stat tag's net index to its slot in an array of stats.
+//Tags that aren't in the array (including non-stat tags and the Stat root) map to INDEX_NONE, so no tag hierarchy checks are needed when looking up.
+struct SAIYORAV4_API FStatLookupTable
+{
+    void Build(const TArray<FCombatStat>& InStats);
+    int32 Find(const FGameplayTag StatTag) const;
+
+private:
+
+    TArray<int32> Slots;
+};
+
 USTRUCT()
 struct FCombatStatArray : public FFastArraySerializer
 {
@@ -65,6 +77,17 @@ struct FCombatStatArray : public FFastArraySerializer
     //If something wants to subscribe to a stat before it has been replicated, it is put into a pending subscription list.
     //Delegates in this list are bound and then executed when the relevant stat is replicated to the client.
     TMultiMap<FGameplayTag, FStatCallback> PendingSubscriptions;
+    //Index into Items by stat tag. Rebuilt whenever items are added or removed, either locally or through replication.
+    FStatLookupTable Lookup;
+
+    void RebuildLookup() { Lookup.Build(Items); }
+    FCombatStat* FindStat(const FGameplayTag StatTag) { const int32 Slot = Lookup.Find(StatTag); return Items.IsValidIndex(Slot) ? &Items[Slot] : nullptr; }
+    const FCombatStat* FindStat(const FGameplayTag StatTag) const { const int32 Slot = Lookup.Find(StatTag); return Items.IsValidIndex(Slot) ? &Items[Slot] : nullptr; }
+
+    //Items only broadcast their initial value once the lookup includes them, so listeners can query other stats from the callback.
+    void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+    //Removed items are only taken out of the array after every other callback has run, so the lookup is rebuilt once the whole update is applied.
+    void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters) { RebuildLookup(); }
 
     bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
     {
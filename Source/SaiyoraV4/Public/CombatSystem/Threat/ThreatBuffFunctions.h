@@ -13,16 +13,24 @@ class SAIYORAV4_API UThreatModifierFunction : public UBuffFunction
 
 	FThreatModCondition Mod;
     EThreatModifierType ModType;
+    //Modifiers that don't depend on the threat event are folded into the handler's cached modifier terms instead.
+    bool bStaticMod = false;
+    FCombatModifier StaticMod;
+    FCombatModifierHandle StaticModHandle;
     UPROPERTY()
     UThreatHandler* TargetHandler;
     
     void SetModifierVars(EThreatModifierType const ModifierType, FThreatModCondition const& Modifier);
+    void SetStaticModifierVars(EThreatModifierType const ModifierType, FCombatModifier const& Modifier);
     
     virtual void OnApply(FBuffApplyEvent const& ApplyEvent) override;
+    virtual void OnChange(FBuffApplyEvent const& ApplyEvent) override;
     virtual void OnRemove(FBuffRemoveEvent const& RemoveEvent) override;
     
     UFUNCTION(BlueprintCallable, Category = "Buff Function", meta = (DefaultToSelf = "Buff", HidePin = "Buff"))
     static void ThreatModifier(UBuff* Buff, EThreatModifierType const ModifierType, FThreatModCondition const& Modifier);
+    UFUNCTION(BlueprintCallable, Category = "Buff Function", meta = (DefaultToSelf = "Buff", HidePin = "Buff"))
+    static void StaticThreatModifier(UBuff* Buff, EThreatModifierType const ModifierType, FCombatModifier const& Modifier);
 };
 
 UCLASS()
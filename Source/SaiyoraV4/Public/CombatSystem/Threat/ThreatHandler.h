@@ -11,6 +11,7 @@ class UDamageHandler;
 class UBuffHandler;
 class UCombatStatusComponent;
 class UNPCAbilityComponent;
+class UCombatEventSubsystem;
 class UAggroRadius;
 class UCombatGroup;
 
@@ -37,6 +38,8 @@ private:
 	UCombatStatusComponent* CombatStatusComponentRef = nullptr;
 	UPROPERTY()
 	UNPCAbilityComponent* NPCComponentRef = nullptr;
+	UPROPERTY()
+	UCombatEventSubsystem* CombatEventBus = nullptr;
 
 	UFUNCTION()
 	void OnCombatBehaviorChanged(const ENPCCombatBehavior PreviousBehavior, const ENPCCombatBehavior NewBehavior);
@@ -67,6 +70,7 @@ public:
 	float GetActorThreatValue(const AActor* Target) const;
 	UFUNCTION(BlueprintPure, Category = "Threat")
 	AActor* GetCurrentTarget() const { return CurrentTarget; }
+	//Returns the actors in the threat table sorted from lowest to highest target priority, like GetThreatTable.
 	UFUNCTION(BlueprintPure, BlueprintAuthorityOnly, Category = "Threat")
 	void GetActorsInThreatTable(TArray<AActor*>& OutActors) const;
 	UFUNCTION(BlueprintPure, BlueprintAuthorityOnly, Category = "Threat")
@@ -92,16 +96,23 @@ public:
 	void AddIncomingThreatModifier(const FThreatModCondition& Modifier) { IncomingThreatMods.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Threat")
 	void RemoveIncomingThreatModifier(const FThreatModCondition& Modifier) { IncomingThreatMods.Remove(Modifier); }
+	FCombatModifierHandle AddStaticIncomingThreatModifier(const FCombatModifier& Modifier) { return IncomingThreatMods.AddStatic(Modifier); }
+	void RemoveStaticIncomingThreatModifier(const FCombatModifierHandle& Handle) { IncomingThreatMods.RemoveStatic(Handle); }
+	void UpdateStaticIncomingThreatModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { IncomingThreatMods.UpdateStatic(Handle, Modifier); }
 	float GetModifiedIncomingThreat(const FThreatEvent& ThreatEvent) const;
 
 	UFUNCTION(BlueprintCallable, Category = "Threat")
 	void AddOutgoingThreatModifier(const FThreatModCondition& Modifier) { OutgoingThreatMods.Add(Modifier); }
 	UFUNCTION(BlueprintCallable, Category = "Threat")
 	void RemoveOutgoingThreatModifier(const FThreatModCondition& Modifier) { OutgoingThreatMods.Remove(Modifier); }
+	FCombatModifierHandle AddStaticOutgoingThreatModifier(const FCombatModifier& Modifier) { return OutgoingThreatMods.AddStatic(Modifier); }
+	void RemoveStaticOutgoingThreatModifier(const FCombatModifierHandle& Handle) { OutgoingThreatMods.RemoveStatic(Handle); }
+	void UpdateStaticOutgoingThreatModifier(const FCombatModifierHandle& Handle, const FCombatModifier& Modifier) { OutgoingThreatMods.UpdateStatic(Handle, Modifier); }
 	float GetModifiedOutgoingThreat(const FThreatEvent& ThreatEvent, const FThreatModCondition& SourceModifier) const;
 
+	//Returns the threat table sorted from lowest to highest target priority.
 	UFUNCTION(BlueprintPure)
-	void GetThreatTable(TArray<FThreatTarget>& Table) const { Table = ThreatTable; }
+	void GetThreatTable(TArray<FThreatTarget>& Table) const;
 
 private:
 
@@ -115,8 +126,13 @@ private:
 	bool bHasThreatTable = false;
 	UPROPERTY(EditAnywhere, Category = "Threat")
 	bool bCanBeInThreatTable = false;
+	//Threat targets stored as a binary max-heap on target priority, so the current target is always at index 0.
 	UPROPERTY()
 	TArray<FThreatTarget> ThreatTable;
+	//Heap slot of each combatant in the threat table.
+	TMap<const UThreatHandler*, int32> ThreatTableIndices;
+	//Incremented for every entry added to the threat table, used to break priority ties in favor of the earlier entry.
+	uint32 ThreatTableInsertions = 0;
 	UPROPERTY()
 	TArray<AActor*> TargetedBy;
 	void ClearThreatTable();
@@ -131,6 +147,9 @@ private:
 	AActor* CurrentTarget = nullptr;
 	UFUNCTION()
 	void OnRep_CurrentTarget(AActor* PreviousTarget);
+	//Several threat events can change the top of the threat table in one frame, so the target is only updated once, on the next tick.
+	bool bTargetUpdatePending = false;
+	void MarkTargetDirty();
 	void UpdateTarget();
 	UFUNCTION()
 	void OnOwnerDamageTaken(const FHealthEvent& DamageEvent);
@@ -201,6 +220,11 @@ private:
 	int32 FindInThreatTable(const UThreatHandler* Target) const;
 	int32 FindInThreatTable(const AActor* Target) const;
 	void SortModifiedThreatTarget(const int32 ModifiedIndex);
+	void AddToThreatTable(const FThreatTarget& NewTarget);
+	void RemoveFromThreatTable(const int32 Index);
+	int32 SiftThreatTargetUp(int32 Index);
+	int32 SiftThreatTargetDown(int32 Index);
+	void SwapThreatTargets(const int32 First, const int32 Second);
 	UPROPERTY()
 	UCombatGroup* CombatGroup;
 	void NotifyLocalPlayerOfCombatChange();
@@ -50,11 +50,18 @@ struct FThreatTarget
 	UPROPERTY(BlueprintReadOnly)
 	bool Faded = false;
 
+	//Order this target was added to the threat table in. Targets with equal priority favor whoever was added first.
+	uint32 InsertionOrder = 0;
+
 	FThreatTarget() {}
 	FThreatTarget(UThreatHandler* NewTarget);
 
 	FORCEINLINE bool operator<(const FThreatTarget& Other) const { return LessThan(Other); }
 	bool LessThan(const FThreatTarget& Other) const;
+
+private:
+
+	bool ThreatLessThan(const FThreatTarget& Other) const { return Threat < Other.Threat || (Threat == Other.Threat && InsertionOrder > Other.InsertionOrder); }
 };
 
 USTRUCT()
@@ -1,4 +1,5 @@
 #pragma once
+#include "AbilityStructs.h"
 #include "GameFramework/PlayerController.h"
 #include "SaiyoraPlayerController.generated.h"
 
@@ -30,6 +31,9 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FPingNotification OnPingChanged;
 
+	//Called by the simulated ability event relay to send one frame of ability events from relevant actors to this player, whether or not they have a pawn.
+	void SendSimulatedAbilityEvents(const FSimulatedAbilityEvents& Events) { ClientSimulatedAbilityEvents(Events); }
+
 private:
 
 	void RequestWorldTime();
@@ -43,6 +47,9 @@ private:
 	UFUNCTION(Server, WithValidation, Unreliable)
 	void ServerFinalPingBounce(const float ServerTime);
 
+	UFUNCTION(Client, Unreliable)
+	void ClientSimulatedAbilityEvents(const FSimulatedAbilityEvents& Events);
+
 	UPROPERTY()
 	ASaiyoraGameState* GameStateRef;
 	UPROPERTY()
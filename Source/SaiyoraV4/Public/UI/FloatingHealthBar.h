@@ -25,6 +25,7 @@ class SAIYORAV4_API UFloatingHealthBar : public UUserWidget
 public:
 
 	void Init(AActor* TargetActor);
+	virtual void NativeDestruct() override;
 
 #pragma region Health
 
@@ -42,10 +43,11 @@ private:
 	UPROPERTY()
 	UDamageHandler* TargetDamageHandler = nullptr;
 
-	UFUNCTION()
-	void UpdateHealth(AActor* Actor, const float PreviousHealth, const float NewHealth);
-	UFUNCTION()
-	void UpdateAbsorb(AActor* Actor, const float PreviousHealth, const float NewHealth);
+	//Health, max health, and absorb changes are coalesced by the combat event bus, so the bar refreshes at most once per frame.
+	FDelegateHandle HealthChangeHandle;
+	void OnHealthChanges(TConstArrayView<UDamageHandler*> ChangedHandlers);
+	void UpdateHealth();
+	void UpdateAbsorb();
 	UFUNCTION()
 	void UpdateLifeStatus(AActor* Actor, const ELifeStatus PreviousStatus, const ELifeStatus NewStatus);
 
@@ -49,6 +49,8 @@ struct FFloatingHealthBarInfo
 	FName TargetSocket = NAME_None;
 
 	bool bOnScreen = false;
+	//Last known line of sight from the local player, kept while waiting on an async line of sight check.
+	bool bLineOfSight = true;
 	FVector2D RootPosition = FVector2d::Zero();
 	FVector2D FinalOffset = FVector2d::Zero();
 	bool bOnGrid = false;
@@ -49,8 +49,10 @@ private:
 	UPROPERTY()
 	USaiyoraUIDataAsset* UIDataAsset = nullptr;
 
-	UFUNCTION()
-	void UpdateHealth(AActor* Actor = nullptr, const float PreviousHealth = 0.0f, const float NewHealth = 0.0f);
+	//Health, max health, and absorb changes are coalesced by the combat event bus, so the bar refreshes at most once per frame.
+	FDelegateHandle HealthChangeHandle;
+	void OnHealthChanges(TConstArrayView<UDamageHandler*> ChangedHandlers);
+	void UpdateHealth();
 	UFUNCTION()
 	void UpdateLifeStatus(AActor* Actor, const ELifeStatus PreviousStatus, const ELifeStatus NewStatus);
 